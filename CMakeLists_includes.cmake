@@ -31,6 +31,8 @@ target_sources(hikogui INTERFACE FILE_SET hikogui_include_files TYPE HEADERS BAS
     src/hikocpu/array_intrinsic_f64x2_x86.hpp
     $<$<STREQUAL:${ARCHITECTURE_ID},x86>:${CMAKE_CURRENT_SOURCE_DIR}/src/hikocpu/array_intrinsic_f64x4_x86.hpp>
     src/hikocpu/array_intrinsic_f64x4_x86.hpp
+    $<$<STREQUAL:${ARCHITECTURE_ID},x86>:${CMAKE_CURRENT_SOURCE_DIR}/src/hikocpu/array_intrinsic_i16x8_x86.hpp>
+    src/hikocpu/array_intrinsic_i16x8_x86.hpp
     $<$<STREQUAL:${ARCHITECTURE_ID},none>:${CMAKE_CURRENT_SOURCE_DIR}/src/hikocpu/cpu_id_generic.hpp>
     src/hikocpu/cpu_id_generic.hpp
     $<$<STREQUAL:${ARCHITECTURE_ID},x86>:${CMAKE_CURRENT_SOURCE_DIR}/src/hikocpu/cpu_id_x86.hpp>
@@ -143,6 +145,7 @@ target_sources(hikogui INTERFACE FILE_SET hikogui_include_files TYPE HEADERS BAS
     src/hikogui/char_maps/utf_16.hpp
     src/hikogui/char_maps/utf_32.hpp
     src/hikogui/char_maps/utf_8.hpp
+    src/hikogui/char_maps/utf_8_x86.hpp
     src/hikogui/codec/BON8.hpp
     src/hikogui/codec/JSON.hpp
     src/hikogui/codec/SHA2.hpp
@@ -153,6 +156,7 @@ target_sources(hikogui INTERFACE FILE_SET hikogui_include_files TYPE HEADERS BAS
     src/hikogui/codec/huffman.hpp
     src/hikogui/codec/indent.hpp
     src/hikogui/codec/inflate.hpp
+    src/hikogui/codec/inflate_stream.hpp
     src/hikogui/codec/jsonpath.hpp
     src/hikogui/codec/pickle.hpp
     src/hikogui/codec/png.hpp
@@ -170,22 +174,28 @@ target_sources(hikogui INTERFACE FILE_SET hikogui_include_files TYPE HEADERS BAS
     src/hikogui/concurrency/concurrency.hpp
     src/hikogui/concurrency/global_state.hpp
     src/hikogui/concurrency/id_factory.hpp
+    src/hikogui/concurrency/rcu.hpp
     src/hikogui/concurrency/subsystem.hpp
     src/hikogui/concurrency/thread.hpp
     src/hikogui/concurrency/thread_intf.hpp
+    $<$<PLATFORM_ID:Linux>:${CMAKE_CURRENT_SOURCE_DIR}/src/hikogui/concurrency/thread_posix_impl.hpp>
+    src/hikogui/concurrency/thread_posix_impl.hpp
     $<$<PLATFORM_ID:Windows>:${CMAKE_CURRENT_SOURCE_DIR}/src/hikogui/concurrency/thread_win32_impl.hpp>
     src/hikogui/concurrency/thread_win32_impl.hpp
     src/hikogui/concurrency/unfair_mutex.hpp
     src/hikogui/concurrency/unfair_mutex_impl.hpp
     src/hikogui/concurrency/unfair_mutex_intf.hpp
     src/hikogui/concurrency/unfair_recursive_mutex.hpp
+    src/hikogui/concurrency/wfree_idle_count.hpp
     src/hikogui/container/byte_string.hpp
     src/hikogui/container/container.hpp
+    src/hikogui/container/delta_undo_stack.hpp
     src/hikogui/container/expected_optional.hpp
     src/hikogui/container/function_fifo.hpp
     src/hikogui/container/functional.hpp
     src/hikogui/container/lean_vector.hpp
     src/hikogui/container/polymorphic_optional.hpp
+    src/hikogui/container/rope.hpp
     src/hikogui/container/secure_vector.hpp
     src/hikogui/container/stable_set.hpp
     src/hikogui/container/stack.hpp
@@ -207,18 +217,26 @@ target_sources(hikogui INTERFACE FILE_SET hikogui_include_files TYPE HEADERS BAS
     src/hikogui/dispatch/awaitable_timer_intf.hpp
     src/hikogui/dispatch/dispatch.hpp
     src/hikogui/dispatch/function_timer.hpp
+    $<$<PLATFORM_ID:Linux>:${CMAKE_CURRENT_SOURCE_DIR}/src/hikogui/dispatch/loop_linux_intf.hpp>
+    src/hikogui/dispatch/loop_linux_intf.hpp
     $<$<PLATFORM_ID:Windows>:${CMAKE_CURRENT_SOURCE_DIR}/src/hikogui/dispatch/loop_win32_intf.hpp>
     src/hikogui/dispatch/loop_win32_intf.hpp
     src/hikogui/dispatch/notifier.hpp
     src/hikogui/dispatch/progress.hpp
     src/hikogui/dispatch/socket_event.hpp
     src/hikogui/dispatch/socket_event_intf.hpp
+    $<$<PLATFORM_ID:Linux>:${CMAKE_CURRENT_SOURCE_DIR}/src/hikogui/dispatch/socket_event_linux_impl.hpp>
+    src/hikogui/dispatch/socket_event_linux_impl.hpp
     $<$<PLATFORM_ID:Windows>:${CMAKE_CURRENT_SOURCE_DIR}/src/hikogui/dispatch/socket_event_win32_impl.hpp>
     src/hikogui/dispatch/socket_event_win32_impl.hpp
     src/hikogui/dispatch/task.hpp
     src/hikogui/dispatch/task_controller.hpp
+    src/hikogui/dispatch/thread_pool.hpp
     src/hikogui/dispatch/when_any.hpp
     src/hikogui/file/access_mode.hpp
+    src/hikogui/file/async_file.hpp
+    $<$<PLATFORM_ID:Linux>:${CMAKE_CURRENT_SOURCE_DIR}/src/hikogui/file/async_file_linux_intf.hpp>
+    src/hikogui/file/async_file_linux_intf.hpp
     src/hikogui/file/file.hpp
     src/hikogui/file/file_intf.hpp
     $<$<PLATFORM_ID:Linux>:${CMAKE_CURRENT_SOURCE_DIR}/src/hikogui/file/file_posix_impl.hpp>
@@ -401,6 +419,8 @@ target_sources(hikogui INTERFACE FILE_SET hikogui_include_files TYPE HEADERS BAS
     src/hikogui/telemetry/delayed_format.hpp
     src/hikogui/telemetry/format_check.hpp
     src/hikogui/telemetry/log.hpp
+    src/hikogui/telemetry/log_binary.hpp
+    src/hikogui/telemetry/log_file.hpp
     src/hikogui/telemetry/telemetry.hpp
     src/hikogui/telemetry/trace.hpp
     src/hikogui/test.hpp
@@ -409,6 +429,7 @@ target_sources(hikogui INTERFACE FILE_SET hikogui_include_files TYPE HEADERS BAS
     src/hikogui/text/text_decoration.hpp
     src/hikogui/text/text_selection.hpp
     src/hikogui/text/text_shaper.hpp
+    src/hikogui/text/text_shaper_cache.hpp
     src/hikogui/text/text_shaper_char.hpp
     src/hikogui/text/text_shaper_line.hpp
     src/hikogui/text/text_style.hpp
@@ -440,6 +461,7 @@ target_sources(hikogui INTERFACE FILE_SET hikogui_include_files TYPE HEADERS BAS
     src/hikogui/unicode/ucd_grapheme_cluster_breaks.hpp
     src/hikogui/unicode/ucd_lexical_classes.hpp
     src/hikogui/unicode/ucd_line_break_classes.hpp
+    src/hikogui/unicode/ucd_normalization_quick_checks.hpp
     src/hikogui/unicode/ucd_scripts.hpp
     src/hikogui/unicode/ucd_sentence_break_properties.hpp
     src/hikogui/unicode/ucd_word_break_properties.hpp
@@ -493,6 +515,8 @@ target_sources(hikogui INTERFACE FILE_SET hikogui_include_files TYPE HEADERS BAS
     src/hikogui/utility/enum_metadata.hpp
     src/hikogui/utility/exception.hpp
     src/hikogui/utility/exception_intf.hpp
+    $<$<PLATFORM_ID:Linux>:${CMAKE_CURRENT_SOURCE_DIR}/src/hikogui/utility/exception_posix_impl.hpp>
+    src/hikogui/utility/exception_posix_impl.hpp
     $<$<PLATFORM_ID:Windows>:${CMAKE_CURRENT_SOURCE_DIR}/src/hikogui/utility/exception_win32_impl.hpp>
     src/hikogui/utility/exception_win32_impl.hpp
     src/hikogui/utility/fixed_string.hpp
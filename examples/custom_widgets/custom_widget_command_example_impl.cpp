@@ -23,7 +23,7 @@ public:
 
     // The set_constraints() function is called when the window is first initialized,
     // or when a widget wants to change its constraints.
-    [[nodiscard]] hi::box_constraints update_constraints() noexcept override
+    [[nodiscard]] hi::box_constraints do_update_constraints() noexcept override
     {
         // Reset _layout so that the set_layout() calculations will be triggered.
         _layout = {};
@@ -36,7 +36,7 @@ public:
     // a widget wants to change the internal layout.
     //
     // NOTE: The size of the layout may be larger than the maximum constraints of this widget.
-    void set_layout(hi::widget_layout const& context) noexcept override
+    void do_set_layout(hi::widget_layout const& context) noexcept override
     {
         // Update the `_layout` with the new context.
         if (compare_store(_layout, context)) {}
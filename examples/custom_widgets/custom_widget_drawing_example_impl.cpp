@@ -90,7 +90,7 @@ public:
 
     // The set_constraints() function is called when the window is first initialized,
     // or when a widget wants to change its constraints.
-    [[nodiscard]] hi::box_constraints update_constraints() noexcept override
+    [[nodiscard]] hi::box_constraints do_update_constraints() noexcept override
     {
         this->_glyph = find_glyph(hi::elusive_icon::Briefcase);
 
@@ -103,7 +103,7 @@ public:
                 // Could not get an image, retry.
                 _image_was_modified = true;
                 ++hi::global_counter<"drawing_widget:no-backing-image:constrain">;
-                process_event({hi::gui_event_type::window_reconstrain});
+                request_reconstrain();
             }
         }
 
@@ -121,7 +121,7 @@ public:
     // a widget wants to change the internal layout.
     //
     // NOTE: The size of the layout may be larger than the maximum constraints of this widget.
-    void set_layout(hi::widget_layout const& context) noexcept override
+    void do_set_layout(hi::widget_layout const& context) noexcept override
     {
         // Update the `_layout` with the new context, in this case we want to do some
         // calculations when the size of the widget was changed.
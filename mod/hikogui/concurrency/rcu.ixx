@@ -9,6 +9,10 @@ module;
 #include <tuple>
 #include <mutex>
 #include <memory>
+#include <atomic>
+#include <new>
+#include <cstdint>
+#include <cstddef>
 
 export module hikogui_concurrency_rcu;
 import hikogui_concurrency_unfair_mutex;
@@ -19,6 +23,10 @@ import hikogui_utility;
 export namespace hi::inline v1 {
 
 /** Read-copy-update.
+ *
+ * Readers lock the rcu, which is wait-free, and read the current value.
+ * Writers replace the value with a new copy; the old copy is destroyed
+ * by a later writer once all readers that could have seen it are done.
  *
  * @tparam T The type managed by RCU.
  * @tparam Allocator The allocator used to allocate objects of type T.
@@ -36,7 +44,19 @@ public:
      */
     constexpr rcu(allocator_type allocator = allocator_type{}) noexcept : _allocator(allocator) {}
 
-    ~rcu() = default;
+    ~rcu()
+    {
+        // There should be no readers left when the rcu is destroyed.
+        hi_axiom(not _idle_count.is_locked());
+
+        if (auto *ptr = _ptr.load(std::memory_order::acquire)) {
+            destroy(ptr);
+        }
+        for (auto const& [version, ptr] : _old_ptrs) {
+            destroy(ptr);
+        }
+    }
+
     rcu(rcu const&) = delete;
     rcu(rcu&&) = delete;
     rcu& operator=(rcu const&) = delete;
@@ -61,27 +81,11 @@ public:
      * @note A lock on the RCU should be held while dereferencing the returned pointer.
      * @return a const pointer to the current value.
      */
-    value_type const *get() const noexcept
+    [[nodiscard]] value_type const *get() const noexcept
     {
         return _ptr.load(std::memory_order::acquire);
     }
 
-    /** get the rcu-pointer.
-     *
-     * @note A lock on the RCU should be held while dereferencing the returned pointer.
-     * @note This function is unsafe you must follow the rules in
-     *       https://github.com/torvalds/linux/blob/master/Documentation/RCU/rcu_dereference.rst
-     * @return a const pointer to the current value.
-     */
-    value_type const *unsafe_get() noexcept
-    {
-#if defined(__alpha__) or defined(__alpha) or defined(_M_ALPHA)
-        return _ptr.load(std::memory_order::acquire);
-#else
-        return _ptr.load(std::memory_order::relaxed);
-#endif
-    }
-
     /** The version of the lock.
      *
      * @note This function should be called while holding the lock.
@@ -96,9 +100,9 @@ public:
      *
      * This function is useful in tests to determine if the old copies are properly deallocated.
      */
-    [[nodiscard]] size_t capacity() const noexcept
+    [[nodiscard]] std::size_t capacity() const noexcept
     {
-        hilet lock = std::scoped_lock(_old_ptrs_mutex);
+        auto const lock = std::scoped_lock(_old_ptrs_mutex);
         return _old_ptrs.size() + not empty();
     }
 
@@ -114,7 +118,7 @@ public:
     }
 
     /** Create a copy of the value at the given pointer.
-     * 
+     *
      * @note This function should be called while holding the lock.
      * @note It is undefined behavior to pass a nullptr as the argument
      * @param ptr The pointer to a value to copy.
@@ -138,7 +142,7 @@ public:
     {
         auto *new_ptr = std::allocator_traits<allocator_type>::allocate(_allocator, 1);
         lock();
-        value_type const * const ptr = get();
+        value_type const *const ptr = get();
         hi_assert_not_null(ptr);
         std::allocator_traits<allocator_type>::construct(_allocator, new_ptr, *ptr);
         unlock();
@@ -151,8 +155,7 @@ public:
      */
     void abort(value_type *ptr) const noexcept
     {
-        std::allocator_traits<allocator_type>::destroy(_allocator, ptr);
-        std::allocator_traits<allocator_type>::deallocate(_allocator, ptr, 1);
+        destroy(ptr);
     }
 
     /** Commit the copied value.
@@ -163,7 +166,7 @@ public:
     {
         lock();
         auto *old_ptr = exchange(ptr);
-        auto old_version = version();
+        auto const old_version = version();
         unlock();
         add_old_copy(old_version, old_ptr);
     }
@@ -178,22 +181,17 @@ public:
      *
      * @param args The arguments passed to the constructor of the value.
      */
-    void emplace(auto&&...args) noexcept
+    template<typename... Args>
+    void emplace(Args&&...args) noexcept
     {
         value_type *const new_ptr = std::allocator_traits<allocator_type>::allocate(_allocator, 1);
-        std::allocator_traits<allocator_type>::construct(_allocator, new_ptr, hi_forward(args)...);
-
-        lock();
-        auto *const old_ptr = exchange(new_ptr);
-        hilet old_version = version();
-        unlock();
-
-        add_old_copy(old_version, old_ptr);
+        std::allocator_traits<allocator_type>::construct(_allocator, new_ptr, std::forward<Args>(args)...);
+        commit(std::launder(new_ptr));
     }
 
     [[nodiscard]] bool empty() const noexcept
     {
-        return not to_bool(_ptr.load(std::memory_order::relaxed));
+        return _ptr.load(std::memory_order::relaxed) == nullptr;
     }
 
     explicit operator bool() const noexcept
@@ -203,15 +201,10 @@ public:
 
     void reset() noexcept
     {
-        lock();
-        auto *const old_ptr = _ptr.exchange(nullptr, std::memory_order::release);
-        hilet old_version = *_idle_count;
-        unlock();
-
-        add_old_copy(old_version, old_ptr);
+        commit(nullptr);
     }
 
-    rcu& operator=(nullptr_t) noexcept
+    rcu& operator=(std::nullptr_t) noexcept
     {
         reset();
         return *this;
@@ -228,20 +221,17 @@ public:
      */
     void add_old_copy(uint64_t old_version, value_type *old_ptr) noexcept
     {
-        if (not old_ptr) {
-            return;
-        }
-
-        hilet new_version = version();
+        auto const new_version = version();
 
-        hilet lock = std::scoped_lock(_old_ptrs_mutex);
-        _old_ptrs.emplace_back(old_version, old_ptr);
+        auto const lock = std::scoped_lock(_old_ptrs_mutex);
+        if (old_ptr) {
+            _old_ptrs.emplace_back(old_version, old_ptr);
+        }
 
         // Destroy all objects from previous idle-count versions.
         auto it = _old_ptrs.begin();
         while (it != _old_ptrs.end() and it->first < new_version) {
-            std::allocator_traits<allocator_type>::destroy(_allocator, it->second);
-            std::allocator_traits<allocator_type>::deallocate(_allocator, it->second, 1);
+            destroy(it->second);
             ++it;
         }
         _old_ptrs.erase(_old_ptrs.begin(), it);
@@ -254,7 +244,12 @@ private:
     mutable allocator_type _allocator;
     mutable unfair_mutex _old_ptrs_mutex;
     std::vector<std::pair<uint64_t, value_type *>> _old_ptrs;
+
+    void destroy(value_type *ptr) const noexcept
+    {
+        std::allocator_traits<allocator_type>::destroy(_allocator, ptr);
+        std::allocator_traits<allocator_type>::deallocate(_allocator, ptr, 1);
+    }
 };
 
 } // namespace hi::inline v1
-
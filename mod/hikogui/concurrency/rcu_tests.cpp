@@ -67,6 +67,9 @@ TEST(rcu, write_while_read)
     // The version does not increment while a lock is being held.
     ASSERT_EQ(object.version(), 1);
 
+    // The old value is still valid while the lock is held.
+    ASSERT_EQ(*ptr42, 42);
+
     object.unlock();
     ASSERT_EQ(object.version(), 2);
     // The capacity does not change when just reading.
@@ -79,3 +82,14 @@ TEST(rcu, write_while_read)
     ASSERT_EQ(object.capacity(), 0);
     ASSERT_TRUE(object.empty());
 }
+
+TEST(rcu, destroy)
+{
+    // The current and old values are destroyed with the rcu object.
+    auto object = rcu<std::string>{};
+    object.emplace("a long string which is not stored in-place");
+    object.lock();
+    object.emplace("another long string which is not stored in-place");
+    object.unlock();
+    ASSERT_EQ(object.capacity(), 2);
+}
@@ -26,12 +26,12 @@ export namespace hi::inline v1 {
  * ```cpp
  * idle_count.lock();
  * ... write protected data ...
- * auto old_version = idle_count.version();
+ * auto old_version = *idle_count;
  * idle_count.unlock();
  *
  * ... wait some time ...
- * 
- * auto new_version = idle_count.expanded_version(version);
+ *
+ * auto new_version = *idle_count;
  * if (new_version > old_version) {
  *   // All threads now see the new data.
  *   ... Delete old data ...
@@ -53,7 +53,7 @@ public:
      */
     [[nodiscard]] hi_force_inline bool is_locked() const noexcept
     {
-        return to_bool(_lock_count.load(std::memory_order::relaxed));
+        return _lock_count.load(std::memory_order::relaxed) != 0;
     }
 
     /** Start the critical section.
@@ -62,8 +62,8 @@ public:
      */
     hi_force_inline void lock() noexcept
     {
-        hilet lock_count = _lock_count.fetch_add(1, std::memory_order::acquire);
-        hi_axiom(lock_count != std::numeric_limits<uint32_t>::max());
+        auto const lock_count = _lock_count.fetch_add(1, std::memory_order::acquire);
+        hi_axiom(lock_count != std::numeric_limits<uint64_t>::max());
     }
 
     /** End the critical section.
@@ -72,19 +72,21 @@ public:
      */
     hi_force_inline void unlock() noexcept
     {
-        auto lock_count = _lock_count.fetch_sub(1, std::memory_order::release);
+        auto const lock_count = _lock_count.fetch_sub(1, std::memory_order::acq_rel);
         hi_axiom(lock_count != 0);
         if (lock_count == 1) {
             // No one is locking, increment the idle count.
-            _version.fetch_add(1, std::memory_order::relaxed);
+            // The release makes the reads of all the threads that unlocked
+            // visible to a writer that sees the new idle count.
+            _version.fetch_add(1, std::memory_order::release);
         }
     }
 
     /** Get the current idle-count.
      *
-     * @return The number of times the critcal section became idle, modulo 2^23.
+     * @return The number of times the critical section became idle.
      */
-    hi_force_inline uint64_t operator*() const noexcept
+    [[nodiscard]] hi_force_inline uint64_t operator*() const noexcept
     {
         return _version.load(std::memory_order::acquire);
     }
@@ -700,7 +700,7 @@ struct array_generic {
             a = {};
         } else {
             for (std::size_t i = 0; i != N; ++i) {
-                a[i] = to_value(to_mask(a[0]) << b);
+                a[i] = to_value(to_mask(a[i]) << b);
             }
         }
         return a;
@@ -718,7 +718,7 @@ struct array_generic {
             a = {};
         } else {
             for (std::size_t i = 0; i != N; ++i) {
-                a[i] = to_value(to_mask(a[0]) >> b);
+                a[i] = to_value(to_mask(a[i]) >> b);
             }
         }
         return a;
@@ -737,7 +737,7 @@ struct array_generic {
         }
 
         for (std::size_t i = 0; i != N; ++i) {
-            a[i] = to_value(to_signed_mask(a[0]) >> b);
+            a[i] = to_value(to_signed_mask(a[i]) >> b);
         }
         return a;
     }
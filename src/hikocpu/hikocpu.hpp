@@ -13,6 +13,7 @@
 #include "array_intrinsic_f32x4_x86.hpp" // export
 #include "array_intrinsic_f64x4_x86.hpp" // export
 #include "array_intrinsic_f64x2_x86.hpp" // export
+#include "array_intrinsic_i16x8_x86.hpp" // export
 #endif
 #include "array_intrinsic.hpp" // export
 #include "simd_intf.hpp" // export
@@ -46,6 +46,8 @@ enum class gui_event_type {
     window_redraw, ///< Request that part of the window gets redrawn on the next frame.
     window_relayout, ///< Request that widgets get laid out on the next frame.
     window_reconstrain, ///< Request that widget get constraint on the next frame.
+    window_relayout_branch, ///< Request that the widgets marked by `widget_intf::request_relayout()` get laid out on the next frame.
+    window_reconstrain_branch, ///< Request that the widgets marked by `widget_intf::request_reconstrain()` get constraint on the next frame.
     window_resize, ///< Request that the window resizes to desired constraints on the next frame.
     window_minimize, ///< Request the window to minimize.
     window_maximize, ///< Request the window to maximize.
@@ -132,6 +134,8 @@ constexpr auto gui_event_type_metadata = enum_metadata{
     gui_event_type::window_redraw, "window_redraw",
     gui_event_type::window_relayout, "window_relayout",
     gui_event_type::window_reconstrain, "window_reconstrain",
+    gui_event_type::window_relayout_branch, "window_relayout_branch",
+    gui_event_type::window_reconstrain_branch, "window_reconstrain_branch",
     gui_event_type::window_resize, "window_resize",
     gui_event_type::window_minimize, "window_minimize",
     gui_event_type::window_maximize, "window_maximize",
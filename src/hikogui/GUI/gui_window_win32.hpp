@@ -198,7 +198,9 @@ public:
         hi_assert_not_null(_widget);
 
         // When a widget requests it or a window-wide event like language change
-        // has happened all the widgets will be set_constraints().
+        // has happened the widgets will be reconstrained. Only the widgets that
+        // requested it, and their parents, are visited; the number of widgets visited
+        // is counted by "widget:constrain:visit" and "widget:layout:visit".
         auto need_reconstrain = _reconstrain.exchange(false, std::memory_order_relaxed);
 
 #if 0
@@ -208,6 +210,7 @@ public:
 
         if (need_reconstrain) {
             auto const t2 = trace<"window::constrain">();
+            ++global_counter<"gui_window:constrain">;
 
             theme = get_selected_theme().transform(pixel_density);
             _widget_constraints = _widget->update_constraints();
@@ -261,6 +264,7 @@ public:
 
         if (need_reconstrain or need_relayout or widget_size != rectangle.size()) {
             auto const t2 = trace<"window::layout">();
+            ++global_counter<"gui_window:layout">;
             widget_size = rectangle.size();
 
             // Guarantee that the layout size is always at least the minimum size.
@@ -807,10 +811,26 @@ public:
             return true;
 
         case window_relayout:
+            // Not sent by a widget for itself, so all the widgets are laid out.
+            if (_widget) {
+                _widget->invalidate_layout();
+            }
+            _relayout.store(true, std::memory_order_relaxed);
+            return true;
+
+        case window_relayout_branch:
             _relayout.store(true, std::memory_order_relaxed);
             return true;
 
         case window_reconstrain:
+            // Not sent by a widget for itself, for example a change of theme, so all the widgets are reconstrained.
+            if (_widget) {
+                _widget->invalidate_constraints();
+            }
+            _reconstrain.store(true, std::memory_order_relaxed);
+            return true;
+
+        case window_reconstrain_branch:
             _reconstrain.store(true, std::memory_order_relaxed);
             return true;
 
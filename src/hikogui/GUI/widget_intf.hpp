@@ -12,6 +12,7 @@
 #include "../layout/layout.hpp"
 #include "../GFX/GFX.hpp"
 #include "../telemetry/telemetry.hpp"
+#include "../dispatch/dispatch.hpp"
 #include "../theme/theme.hpp"
 #include "../macros.hpp"
 #include <coroutine>
@@ -70,7 +71,7 @@ public:
                 // The layout has changed which means its size may have changed
                 // which would require a re-layout and re-constrain of the widget.
                 ++global_counter<"widget:style:reconstrain">;
-                process_event({gui_event_type::window_reconstrain});
+                request_reconstrain();
 
             } else if (to_bool(mask & style_modify_mask::redraw)) {
                 // The color attributes, or border magnitude has changed which
@@ -90,11 +91,16 @@ public:
             if (old_state) {
                 if (need_reconstrain(*old_state, *state)) {
                     ++global_counter<"widget:state:reconstrain">;
-                    process_event({gui_event_type::window_reconstrain});
+                    // A change of mode may hide or show this widget, which
+                    // changes how the parent arranges its children.
+                    if (auto *p = parent()) {
+                        p->request_reconstrain();
+                    }
+                    request_reconstrain();
 
                 } else if (need_relayout(*old_state, *state)) {
                     ++global_counter<"widget:state:relayout">;
-                    process_event({gui_event_type::window_relayout});
+                    request_relayout();
 
                 } else if (need_redraw(*old_state, *state)) {
                     ++global_counter<"widget:state:redraw">;
@@ -212,8 +218,12 @@ public:
 
     /** Update the constraints of the widget.
      *
-     * Typically the implementation of this function starts with recursively calling update_constraints()
-     * on its children.
+     * The constraints are only recalculated by `do_update_constraints()` when this
+     * widget has requested a reconstrain, otherwise the cached constraints are returned.
+     *
+     * When only widgets further down the tree have requested a reconstrain, those
+     * are updated first; if their constraints come out unchanged this widget keeps
+     * its own constraints and is not recalculated.
      *
      * If the container, due to a change in constraints, wants the window to resize to the minimum size
      * it should call `request_resize()`.
@@ -221,20 +231,129 @@ public:
      * @post This function will change what is returned by `widget::minimum_size()`, `widget::preferred_size()`
      *       and `widget::maximum_size()`.
      */
-    [[nodiscard]] virtual box_constraints update_constraints() noexcept = 0;
+    [[nodiscard]] box_constraints update_constraints() noexcept
+    {
+        if (_reconstrain or _reconstrain_child) {
+            ++global_counter<"widget:constrain:visit">;
+        }
+
+        if (_reconstrain_child and not _reconstrain) {
+            _reconstrain_child = false;
+            _relayout_child = true;
+
+            for (auto& child : children(false)) {
+                if (child._reconstrain or child._reconstrain_child) {
+                    auto const old_constraints = child._constraints;
+                    if (child.update_constraints() != old_constraints) {
+                        _reconstrain = true;
+                    }
+                }
+            }
+        }
+
+        if (_reconstrain) {
+            _reconstrain = false;
+            _reconstrain_child = false;
+            _relayout = true;
+
+            auto const old_constraints = _constraints;
+            auto const old_layout = _layout;
+            _constraints = do_update_constraints();
+            if (_constraints == old_constraints) {
+                // The parent may not lay out this widget again, keep the layout
+                // so that set_layout() can pass it down the tree.
+                _layout = old_layout;
+            }
+        }
+
+        return _constraints;
+    }
 
     /** Update the internal layout of the widget.
-     * This function is called when the size of this widget must change, or if any of the
-     * widget request a re-layout.
      *
-     * This function may be used for expensive calculations, such as geometry calculations,
-     * which should only be done when the data or sizes change; it should cache these calculations.
+     * The layout is only recalculated by `do_set_layout()` when the context differs from
+     * the previous layout, or when this widget has requested a relayout. When only widgets
+     * further down the tree have requested a relayout, those are laid out again with their
+     * previous layout.
+     *
+     * The `display_time_point` of the context is ignored when comparing with the previous
+     * layout; widgets that animate should call `request_relayout()` for each frame.
      *
-     * @post This function will change what is returned by `widget::size()` and the transformation
-     *       matrices.
      * @param context The layout for this child.
      */
-    virtual void set_layout(widget_layout const& context) noexcept = 0;
+    void set_layout(widget_layout const& context) noexcept
+    {
+        auto context_ = context;
+        context_.display_time_point = _layout.display_time_point;
+
+        if (_relayout or context_ != _layout) {
+            ++global_counter<"widget:layout:visit">;
+            _relayout = false;
+            _relayout_child = false;
+
+            // The layout is cleared so that do_set_layout() does not skip its
+            // calculations when comparing the context with the previous layout.
+            _layout = {};
+            do_set_layout(context);
+
+        } else if (_relayout_child) {
+            ++global_counter<"widget:layout:visit">;
+            _relayout_child = false;
+
+            for (auto& child : children(false)) {
+                if ((child._relayout or child._relayout_child) and child._layout) {
+                    auto child_context = child._layout;
+                    child_context.display_time_point = context.display_time_point;
+                    child.set_layout(child_context);
+                }
+            }
+        }
+    }
+
+    /** Request the constraints of this widget to be updated on the next frame.
+     *
+     * This widget is marked for reconstrain, and its parents are marked so
+     * that only this branch of the widget tree is visited.
+     */
+    void request_reconstrain() noexcept
+    {
+        hi_axiom(loop::main().on_thread());
+
+        _reconstrain = true;
+        for (auto *p = parent(); p != nullptr; p = p->parent()) {
+            p->_reconstrain_child = true;
+        }
+        process_event({gui_event_type::window_reconstrain_branch});
+    }
+
+    /** Request the layout of this widget to be updated on the next frame.
+     *
+     * This widget is marked for relayout, and its parents are marked so
+     * that only this branch of the widget tree is visited.
+     */
+    void request_relayout() noexcept
+    {
+        hi_axiom(loop::main().on_thread());
+
+        _relayout = true;
+        for (auto *p = parent(); p != nullptr; p = p->parent()) {
+            p->_relayout_child = true;
+        }
+        process_event({gui_event_type::window_relayout_branch});
+    }
+
+    /** Mark this widget and all its children to be reconstrained.
+     *
+     * This is used by the window for a `window_reconstrain` event, which is
+     * sent for window-wide changes like the theme that affect every widget.
+     */
+    void invalidate_constraints() noexcept;
+
+    /** Mark this widget and all its children to be laid out.
+     *
+     * This is used by the window for a `window_relayout` event.
+     */
+    void invalidate_layout() noexcept;
 
     /** Get the current layout for this widget.
      */
@@ -355,8 +474,50 @@ protected:
 
     widget_layout _layout;
 
+    /** Calculate the constraints of the widget.
+     *
+     * Typically the implementation of this function starts with recursively calling update_constraints()
+     * on its children.
+     *
+     * @see update_constraints()
+     */
+    [[nodiscard]] virtual box_constraints do_update_constraints() noexcept = 0;
+
+    /** Calculate the internal layout of the widget.
+     *
+     * This function may be used for expensive calculations, such as geometry calculations,
+     * which should only be done when the data or sizes change; it should cache these calculations.
+     * It should call set_layout() on each visible child.
+     *
+     * @see set_layout()
+     * @param context The layout for this child.
+     */
+    virtual void do_set_layout(widget_layout const& context) noexcept = 0;
+
 private:
     widget_intf *_parent = nullptr;
+
+    /** The constraints returned by the last call to do_update_constraints().
+     */
+    box_constraints _constraints = {};
+
+    /** This widget needs to be reconstrained.
+     *
+     * The flags are only accessed from the main thread.
+     */
+    bool _reconstrain = true;
+
+    /** A widget further down the tree needs to be reconstrained.
+     */
+    bool _reconstrain_child = false;
+
+    /** This widget needs to be laid out.
+     */
+    bool _relayout = true;
+
+    /** A widget further down the tree needs to be laid out.
+     */
+    bool _relayout_child = false;
 };
 
 inline widget_intf *get_if(widget_intf *start, widget_id id, bool include_invisible) noexcept
@@ -408,9 +569,25 @@ inline void apply_window_data(widget_intf& start, gui_window *new_window, unit::
     });
 }
 
+inline void widget_intf::invalidate_constraints() noexcept
+{
+    apply(*this, [](widget_intf& w) {
+        w._reconstrain = true;
+    });
+}
+
+inline void widget_intf::invalidate_layout() noexcept
+{
+    apply(*this, [](widget_intf& w) {
+        w._relayout = true;
+    });
+}
+
 inline void widget_intf::set_parent(widget_intf *new_parent) noexcept
 {
     _parent = new_parent;
+    _reconstrain = true;
+    _relayout = true;
     apply_window_data(
         *this,
         new_parent ? new_parent->window : nullptr,
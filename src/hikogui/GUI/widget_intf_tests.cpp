@@ -0,0 +1,187 @@
+// Copyright Take Vos 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include "widget_intf.hpp"
+#include <hikotest/hikotest.hpp>
+#include <memory>
+#include <vector>
+#include <chrono>
+
+TEST_SUITE(widget_intf_suite) {
+
+/** A widget without a window, which counts how often it is constrained and laid out.
+ */
+class stub_widget : public hi::widget_intf {
+public:
+    hi::extent2 size = {10.0f, 10.0f};
+    std::size_t nr_constrained = 0;
+    std::size_t nr_laid_out = 0;
+
+    stub_widget& add_child()
+    {
+        auto& child = *_children.emplace_back(std::make_unique<stub_widget>());
+        child.set_parent(this);
+        return child;
+    }
+
+    [[nodiscard]] hi::generator<widget_intf&> children(bool include_invisible) noexcept override
+    {
+        for (auto& child : _children) {
+            co_yield *child;
+        }
+    }
+
+    // clang-format off
+    void draw(hi::draw_context const&) noexcept override {}
+    [[nodiscard]] hi::hitbox hitbox_test(hi::point2) const noexcept override { return {}; }
+    [[nodiscard]] bool accepts_keyboard_focus(hi::keyboard_focus_group) const noexcept override { return false; }
+    void request_redraw() const noexcept override {}
+    bool process_event(hi::gui_event const&) const noexcept override { return true; }
+    bool handle_event(hi::gui_event const&) noexcept override { return false; }
+    bool handle_event_recursive(hi::gui_event const&, std::vector<hi::widget_id> const&) noexcept override { return false; }
+    [[nodiscard]] hi::widget_id find_next_widget(hi::widget_id, hi::keyboard_focus_group, hi::keyboard_focus_direction) const noexcept override { return {}; }
+    void scroll_to_show(hi::aarectangle) noexcept override {}
+    // clang-format on
+
+protected:
+    [[nodiscard]] hi::box_constraints do_update_constraints() noexcept override
+    {
+        ++nr_constrained;
+        for (auto& child : _children) {
+            std::ignore = child->update_constraints();
+        }
+        return {size, size, size};
+    }
+
+    void do_set_layout(hi::widget_layout const& context) noexcept override
+    {
+        ++nr_laid_out;
+        _layout = context;
+        for (auto& child : _children) {
+            child->set_layout(context);
+        }
+    }
+
+private:
+    std::vector<std::unique_ptr<stub_widget>> _children;
+};
+
+[[nodiscard]] static hi::widget_layout make_layout(int frame)
+{
+    return hi::widget_layout{
+        hi::extent2{100.0f, 100.0f},
+        hi::gui_window_size::normal,
+        hi::subpixel_orientation::unknown,
+        hi::utc_nanoseconds{std::chrono::milliseconds{16 * (frame + 1)}}};
+}
+
+/** Build a tree: root -> (a -> a1, b), and do the initial constrain and layout.
+ */
+struct stub_tree {
+    stub_widget root;
+    stub_widget& a = root.add_child();
+    stub_widget& a1 = a.add_child();
+    stub_widget& b = root.add_child();
+
+    stub_tree()
+    {
+        std::ignore = root.update_constraints();
+        root.set_layout(make_layout(0));
+    }
+};
+
+TEST_CASE(initial_test)
+{
+    auto tree = stub_tree{};
+    for (auto *w : {&tree.root, &tree.a, &tree.a1, &tree.b}) {
+        REQUIRE(w->nr_constrained == 1);
+        REQUIRE(w->nr_laid_out == 1);
+    }
+
+    // Nothing was requested, nothing is visited.
+    std::ignore = tree.root.update_constraints();
+    tree.root.set_layout(make_layout(1));
+    for (auto *w : {&tree.root, &tree.a, &tree.a1, &tree.b}) {
+        REQUIRE(w->nr_constrained == 1);
+        REQUIRE(w->nr_laid_out == 1);
+    }
+}
+
+TEST_CASE(unchanged_constraints_test)
+{
+    auto tree = stub_tree{};
+
+    // a1 is reconstrained, but its constraints stay the same; so neither a nor
+    // the root are recalculated, and the clean subtree b is skipped.
+    tree.a1.request_reconstrain();
+    std::ignore = tree.root.update_constraints();
+    REQUIRE(tree.a1.nr_constrained == 2);
+    REQUIRE(tree.a.nr_constrained == 1);
+    REQUIRE(tree.root.nr_constrained == 1);
+    REQUIRE(tree.b.nr_constrained == 1);
+
+    // Only a1 is laid out again, with its previous layout.
+    tree.root.set_layout(make_layout(1));
+    REQUIRE(tree.a1.nr_laid_out == 2);
+    REQUIRE(tree.a.nr_laid_out == 1);
+    REQUIRE(tree.root.nr_laid_out == 1);
+    REQUIRE(tree.b.nr_laid_out == 1);
+    REQUIRE(tree.a1.layout().shape == tree.a.layout().shape);
+}
+
+TEST_CASE(changed_constraints_test)
+{
+    auto tree = stub_tree{};
+
+    // a1 grows, so a is reconstrained. a's own constraints stay the same, so the root is not.
+    tree.a1.size = {20.0f, 20.0f};
+    tree.a1.request_reconstrain();
+    std::ignore = tree.root.update_constraints();
+    REQUIRE(tree.a1.nr_constrained == 2);
+    REQUIRE(tree.a.nr_constrained == 2);
+    REQUIRE(tree.root.nr_constrained == 1);
+    REQUIRE(tree.b.nr_constrained == 1);
+
+    // a grows, so the root is reconstrained; b is still returned from the cache.
+    tree.a.size = {20.0f, 20.0f};
+    tree.a.request_reconstrain();
+    std::ignore = tree.root.update_constraints();
+    REQUIRE(tree.a.nr_constrained == 3);
+    REQUIRE(tree.root.nr_constrained == 2);
+    REQUIRE(tree.a1.nr_constrained == 2);
+    REQUIRE(tree.b.nr_constrained == 1);
+
+    // The root is laid out again, b gets the same layout and is skipped.
+    tree.root.set_layout(make_layout(1));
+    REQUIRE(tree.root.nr_laid_out == 2);
+    REQUIRE(tree.a.nr_laid_out == 2);
+    REQUIRE(tree.a1.nr_laid_out == 2);
+    REQUIRE(tree.b.nr_laid_out == 1);
+}
+
+TEST_CASE(relayout_child_test)
+{
+    auto tree = stub_tree{};
+
+    tree.a1.request_relayout();
+    tree.root.set_layout(make_layout(1));
+    REQUIRE(tree.a1.nr_laid_out == 2);
+    REQUIRE(tree.a.nr_laid_out == 1);
+    REQUIRE(tree.root.nr_laid_out == 1);
+    REQUIRE(tree.b.nr_laid_out == 1);
+
+    // The child is laid out with its previous layout, at the new display time.
+    REQUIRE(tree.a1.layout().shape == tree.a.layout().shape);
+    REQUIRE(tree.a1.layout().display_time_point == make_layout(1).display_time_point);
+
+    // A different layout of the root is passed down the whole tree.
+    auto layout = make_layout(2);
+    layout.shape.rectangle = hi::aarectangle{hi::extent2{50.0f, 50.0f}};
+    tree.root.set_layout(layout);
+    for (auto *w : {&tree.root, &tree.a, &tree.a1, &tree.b}) {
+        REQUIRE(w->nr_laid_out == (w == &tree.a1 ? 3 : 2));
+    }
+}
+
+}; // TEST_SUITE(widget_intf_suite)
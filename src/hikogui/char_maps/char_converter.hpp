@@ -10,14 +10,19 @@
 
 #include "../utility/utility.hpp"
 #include "../macros.hpp"
+#include <hikocpu/hikocpu.hpp>
 #include <string>
 #include <string_view>
 #include <bit>
 #include <compare>
 #include <array>
+#include <iterator>
 #if defined(HI_HAS_SSE2)
 #include <emmintrin.h>
 #endif
+#if defined(HI_HAS_X86)
+#include "utf_8_x86.hpp"
+#endif
 
 hi_export_module(hikogui.char_maps.char_converter);
 
@@ -279,15 +284,110 @@ private:
         }
     }
 
+    /** Count chunks of text that include non-ASCII characters.
+     *
+     * This handles UTF-8 to and from UTF-16 and UTF-32, and validation of UTF-8.
+     */
+    template<typename It, typename EndIt>
+    constexpr void _size_chunk(It& it, EndIt last, size_t& count) const noexcept
+    {
+        if (not std::is_constant_evaluated()) {
+#if defined(HI_HAS_X86)
+            if constexpr (not std::contiguous_iterator<It>) {
+                return;
+
+            } else if constexpr (From == "utf-8" and (To == "utf-8" or To == "utf-16" or To == "utf-32")) {
+                if (has_sse4_1()) {
+                    while (std::distance(it, last) >= 16) {
+                        auto num_code_points = 0_uz;
+                        auto num_surrogates = 0_uz;
+                        auto const size = detail::utf_8_count_sse4_1(std::addressof(*it), num_code_points, num_surrogates);
+                        if (size == 0) {
+                            // The next code-point is invalid, or not handled by the SIMD algorithm.
+                            break;
+                        }
+
+                        it += size;
+                        if constexpr (To == "utf-8") {
+                            count += size;
+                        } else if constexpr (To == "utf-16") {
+                            count += num_code_points + num_surrogates;
+                        } else {
+                            count += num_code_points;
+                        }
+                    }
+                }
+
+            } else if constexpr ((From == "utf-16" or From == "utf-32") and To == "utf-8") {
+                if (has_sse4_1()) {
+                    while (std::distance(it, last) >= 16) {
+                        auto size = 0_uz;
+                        auto const num_code_units = From == "utf-16" ?
+                            detail::utf_16_count_utf_8_sse4_1(std::addressof(*it), size) :
+                            detail::utf_32_count_utf_8_sse4_1(std::addressof(*it), size);
+                        if (num_code_units == 0) {
+                            break;
+                        }
+
+                        it += num_code_units;
+                        count += size;
+                    }
+                }
+            }
+#endif
+        }
+    }
+
+    /** Convert chunks of text that include non-ASCII characters.
+     *
+     * This handles UTF-8 to and from UTF-16 and UTF-32.
+     */
+    template<typename SrcIt, typename SrcEndIt, typename DstIt>
+    void _convert_chunk(SrcIt& src, SrcEndIt src_last, DstIt& dst) const noexcept
+    {
+#if defined(HI_HAS_X86)
+        constexpr auto has_chunk = std::contiguous_iterator<SrcIt> and std::contiguous_iterator<DstIt> and
+            ((From == "utf-8" and (To == "utf-16" or To == "utf-32")) or ((From == "utf-16" or From == "utf-32") and To == "utf-8"));
+
+        if constexpr (has_chunk) {
+            if (has_sse4_1()) {
+                // The functions write beyond the converted text, the minimum size
+                // makes sure this stays inside the output.
+                while (std::distance(src, src_last) >= detail::utf_8_x86_min_size) {
+                    auto dst_size = 0_uz;
+                    auto src_size = 0_uz;
+                    if constexpr (From == "utf-8" and To == "utf-16") {
+                        src_size = detail::utf_8_to_utf_16_sse4_1(std::addressof(*src), std::addressof(*dst), dst_size);
+                    } else if constexpr (From == "utf-8") {
+                        src_size = detail::utf_8_to_utf_32_sse4_1(std::addressof(*src), std::addressof(*dst), dst_size);
+                    } else if constexpr (From == "utf-16") {
+                        src_size = detail::utf_16_to_utf_8_sse4_1(std::addressof(*src), std::addressof(*dst), dst_size);
+                    } else {
+                        src_size = detail::utf_32_to_utf_8_sse4_1(std::addressof(*src), std::addressof(*dst), dst_size);
+                    }
+
+                    if (src_size == 0) {
+                        // The next code-point is invalid, or not handled by the SIMD algorithm.
+                        break;
+                    }
+                    src += src_size;
+                    dst += dst_size;
+                }
+            }
+        }
+#endif
+    }
+
     template<typename It, typename EndIt>
     [[nodiscard]] constexpr std::pair<size_t, bool> _size(It it, EndIt last) const noexcept
     {
         auto count = 0_uz;
         auto valid = true;
         while (true) {
-            // This loop toggles between converting chunks of ASCII characters and converting
-            // a single non-ASCII character.
+            // This loop toggles between converting chunks of characters and converting
+            // a single character.
             _size_ascii(it, last, count);
+            _size_chunk(it, last, count);
 
             if (it == last) {
                 break;
@@ -308,9 +408,10 @@ private:
     void _convert(SrcIt src, SrcEndIt src_last, DstIt dst) const noexcept
     {
         while (true) {
-            // This loop toggles between converting chunks of ASCII characters and converting
-            // a single non-ASCII character.
+            // This loop toggles between converting chunks of characters and converting
+            // a single character.
             _convert_ascii(src, src_last, dst);
+            _convert_chunk(src, src_last, dst);
 
             if (src == src_last) {
                 break;
@@ -3,6 +3,7 @@
 // (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
 
 #include "utf_8.hpp"
+#include "utf_16.hpp"
 #include "utf_32.hpp"
 #include <hikotest/hikotest.hpp>
 
@@ -18,4 +19,44 @@ TEST_CASE(utf8_to_utf32_large_char_at_end)
 
     REQUIRE(result == expected);
 }
+
+// The following texts are long enough to be converted in chunks.
+
+TEST_CASE(utf8_mixed_scripts)
+{
+    auto test = std::string{};
+    auto expected = std::u32string{};
+    for (auto i = 0; i != 8; ++i) {
+        // "hello " in English, Russian, Hebrew, Japanese and an emoji.
+        test += "hello \xd0\xbf\xd1\x80\xd0\xb8\xd0\xb2\xd0\xb5\xd1\x82 \xd7\xa9\xd7\x9c\xd7\x95\xd7\x9d "
+                "\xe3\x81\x93\xe3\x82\x93\xe3\x81\xab\xe3\x81\xa1\xe3\x81\xaf \xf0\x9f\x98\x80 ";
+        expected += U"hello \u043f\u0440\u0438\u0432\u0435\u0442 \u05e9\u05dc\u05d5\u05dd \u3053\u3093\u306b\u3061\u306f \U0001f600 ";
+    }
+
+    auto const utf32 = hi::char_converter<"utf-8", "utf-32">{}.convert<std::u32string>(test);
+    REQUIRE(utf32 == expected);
+
+    auto const utf16 = hi::char_converter<"utf-8", "utf-16">{}.convert<std::u16string>(test);
+    REQUIRE(utf16 == hi::char_converter<"utf-32", "utf-16">{}.convert<std::u16string>(expected));
+
+    REQUIRE(hi::char_converter<"utf-32", "utf-8">{}.convert<std::string>(utf32) == test);
+    REQUIRE(hi::char_converter<"utf-16", "utf-8">{}.convert<std::string>(utf16) == test);
+    REQUIRE(hi::char_converter<"utf-8", "utf-8">{}.convert<std::string>(test) == test);
+}
+
+TEST_CASE(utf8_invalid_in_long_text)
+{
+    auto const text = std::string{"\xd0\xbf\xd1\x80\xd0\xb8\xd0\xb2\xd0\xb5\xd1\x82 \xd0\xbf\xd1\x80\xd0\xb8\xd0\xb2\xd0\xb5\xd1\x82 "};
+    auto const expected_text = std::u32string{U"\u043f\u0440\u0438\u0432\u0435\u0442 \u043f\u0440\u0438\u0432\u0435\u0442 "};
+
+    // A lone continuation byte is decoded as CP-1252, a surrogate is replaced.
+    auto const test = text + "\x80" + text + "\xed\xa0\x80" + text;
+    auto const expected = expected_text + U"\u20ac" + expected_text + U"\ufffd" + expected_text;
+
+    REQUIRE(hi::char_converter<"utf-8", "utf-32">{}.convert<std::u32string>(test) == expected);
+    REQUIRE(
+        hi::char_converter<"utf-8", "utf-8">{}.convert<std::string>(test) ==
+        hi::char_converter<"utf-32", "utf-8">{}.convert<std::string>(expected));
+}
+
 }; // TEST_SUITE(char_converter_suite)
@@ -0,0 +1,648 @@
+// Copyright Take Vos 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+/** @file char_maps/utf_8_x86.hpp SIMD validation and transcoding of UTF-8.
+ * @ingroup char_maps
+ *
+ * The functions in this file handle a single chunk of text and return how
+ * much of the text was handled. When a chunk contains invalid text, or text
+ * that is not handled by the SIMD algorithms, zero is returned and the caller
+ * should handle the next code-point with the scalar algorithm.
+ *
+ * These functions are compiled for SSE4.1 and must only be called after
+ * checking `has_sse4_1()`.
+ */
+
+#pragma once
+
+#include "../utility/utility.hpp"
+#include "../macros.hpp"
+#include <hikocpu/hikocpu.hpp>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstddef>
+#include <emmintrin.h>
+#include <tmmintrin.h>
+#include <smmintrin.h>
+
+hi_export_module(hikogui.char_maps.utf_8_x86);
+
+hi_warning_push();
+// C26490: Don't use reinterpret_cast.
+// Needed for SIMD intrinsics.
+hi_warning_ignore_msvc(26490);
+
+hi_export namespace hi { inline namespace v1 {
+namespace detail {
+
+/** The number of code-units that must be available after the current position
+ * to call one of the UTF-8 SIMD functions.
+ *
+ * The functions read 16 bytes of UTF-8, or 16 code-units of UTF-16 or UTF-32.
+ * They also write a full register, beyond the code-units that were converted,
+ * which is safe when the output was sized for the text remaining.
+ */
+constexpr std::ptrdiff_t utf_8_x86_min_size = 48;
+
+struct utf_8_decode_shuffle {
+    /** Shuffle the bytes of each code-point into a 16 or 32 bit lane, last byte first.
+     */
+    std::array<uint8_t, 16> shuffle = {};
+
+    /** The number of code-points that are decoded.
+     */
+    uint8_t count = 0;
+
+    /** The lanes are 16 bit, all code-points are one or two bytes.
+     */
+    bool is_16bit = false;
+};
+
+struct utf_8_decode_index {
+    uint16_t shuffle_index = 0;
+
+    /** The number of bytes that are decoded.
+     */
+    uint8_t size = 0;
+};
+
+struct utf_8_decode_tables {
+    /** Indexed by a 12 bit mask, with a bit set on each last byte of a code-point.
+     */
+    std::array<utf_8_decode_index, 4096> index;
+    std::array<utf_8_decode_shuffle, 768> shuffles;
+};
+
+[[nodiscard]] consteval utf_8_decode_tables make_utf_8_decode_tables() noexcept
+{
+    auto r = utf_8_decode_tables{};
+    auto num_shuffles = 0_uz;
+
+    // Deduplicate the shuffles by the lengths of the code-points.
+    auto ids = std::array<uint16_t, 0x3000>{};
+
+    for (auto mask = 0_uz; mask != 4096; ++mask) {
+        auto lengths = std::array<std::size_t, 12>{};
+        auto num_lengths = 0_uz;
+        auto start = 0_uz;
+        for (auto i = 0_uz; i != 12; ++i) {
+            if ((mask >> i) & 1) {
+                lengths[num_lengths++] = i - start + 1;
+                start = i + 1;
+            }
+        }
+
+        auto is_16bit = true;
+        for (auto i = 0_uz; i != std::min(num_lengths, 8_uz); ++i) {
+            is_16bit &= lengths[i] <= 2;
+        }
+
+        auto const max_count = is_16bit ? 8_uz : 4_uz;
+        auto count = 0_uz;
+        auto key = is_16bit ? 0x2000_uz : 0_uz;
+        while (count != std::min(num_lengths, max_count) and lengths[count] <= 4) {
+            key |= (lengths[count] - 1) << (is_16bit ? count : count * 2);
+            ++count;
+        }
+        key |= count << 8;
+
+        auto shuffle = utf_8_decode_shuffle{};
+        shuffle.count = narrow_cast<uint8_t>(count);
+        shuffle.is_16bit = is_16bit;
+        shuffle.shuffle.fill(0x80);
+
+        auto size = 0_uz;
+        auto const lane_size = is_16bit ? 2_uz : 4_uz;
+        for (auto i = 0_uz; i != count; ++i) {
+            for (auto j = 0_uz; j != lengths[i]; ++j) {
+                shuffle.shuffle[i * lane_size + j] = narrow_cast<uint8_t>(size + lengths[i] - 1 - j);
+            }
+            size += lengths[i];
+        }
+
+        if (ids[key] == 0) {
+            r.shuffles.at(num_shuffles) = shuffle;
+            ids[key] = narrow_cast<uint16_t>(++num_shuffles);
+        }
+
+        r.index[mask].shuffle_index = narrow_cast<uint16_t>(ids[key] - 1);
+        r.index[mask].size = narrow_cast<uint8_t>(size);
+    }
+    return r;
+}
+
+constexpr auto utf_8_decode_tables = make_utf_8_decode_tables();
+
+/** Check a chunk of UTF-8 for errors.
+ *
+ * This is the "lookup" algorithm from: John Keiser, Daniel Lemire,
+ * "Validating UTF-8 In Less Than One Instruction Per Byte".
+ *
+ * The chunk is checked as if it follows ASCII text. A code-point that
+ * continues beyond the chunk is not checked.
+ *
+ * @param chunk 16 bytes of UTF-8.
+ * @return Non-zero when the chunk contains an error.
+ */
+hi_target("sse,sse2,ssse3,sse4.1")
+[[nodiscard]] hi_force_inline inline __m128i utf_8_errors_sse4_1(__m128i chunk) noexcept
+{
+    constexpr uint8_t too_short = 1 << 0;
+    constexpr uint8_t too_long = 1 << 1;
+    constexpr uint8_t overlong_3 = 1 << 2;
+    constexpr uint8_t too_large = 1 << 3;
+    constexpr uint8_t surrogate = 1 << 4;
+    constexpr uint8_t overlong_2 = 1 << 5;
+    constexpr uint8_t too_large_1000 = 1 << 6;
+    constexpr uint8_t overlong_4 = 1 << 6;
+    constexpr uint8_t two_conts = 1 << 7;
+    constexpr uint8_t carry = too_short | too_long | two_conts;
+
+    auto const byte_1_high_table = _mm_setr_epi8(
+        too_long,
+        too_long,
+        too_long,
+        too_long,
+        too_long,
+        too_long,
+        too_long,
+        too_long,
+        two_conts,
+        two_conts,
+        two_conts,
+        two_conts,
+        too_short | overlong_2,
+        too_short,
+        too_short | overlong_3 | surrogate,
+        char_cast<char>(too_short | too_large | too_large_1000 | overlong_4));
+
+    auto const byte_1_low_table = _mm_setr_epi8(
+        char_cast<char>(carry | overlong_3 | overlong_2 | overlong_4),
+        char_cast<char>(carry | overlong_2),
+        char_cast<char>(carry),
+        char_cast<char>(carry),
+        char_cast<char>(carry | too_large),
+        char_cast<char>(carry | too_large | too_large_1000),
+        char_cast<char>(carry | too_large | too_large_1000),
+        char_cast<char>(carry | too_large | too_large_1000),
+        char_cast<char>(carry | too_large | too_large_1000),
+        char_cast<char>(carry | too_large | too_large_1000),
+        char_cast<char>(carry | too_large | too_large_1000),
+        char_cast<char>(carry | too_large | too_large_1000),
+        char_cast<char>(carry | too_large | too_large_1000),
+        char_cast<char>(carry | too_large | too_large_1000 | surrogate),
+        char_cast<char>(carry | too_large | too_large_1000),
+        char_cast<char>(carry | too_large | too_large_1000));
+
+    auto const byte_2_high_table = _mm_setr_epi8(
+        too_short,
+        too_short,
+        too_short,
+        too_short,
+        too_short,
+        too_short,
+        too_short,
+        too_short,
+        char_cast<char>(too_long | overlong_2 | two_conts | overlong_3 | too_large_1000 | overlong_4),
+        char_cast<char>(too_long | overlong_2 | two_conts | overlong_3 | too_large),
+        char_cast<char>(too_long | overlong_2 | two_conts | surrogate | too_large),
+        char_cast<char>(too_long | overlong_2 | two_conts | surrogate | too_large),
+        too_short,
+        too_short,
+        too_short,
+        too_short);
+
+    auto const nibble_mask = _mm_set1_epi8(0x0f);
+    auto const zero = _mm_setzero_si128();
+
+    auto const prev1 = _mm_alignr_epi8(chunk, zero, 15);
+    auto const byte_1_high = _mm_shuffle_epi8(byte_1_high_table, _mm_and_si128(_mm_srli_epi16(prev1, 4), nibble_mask));
+    auto const byte_1_low = _mm_shuffle_epi8(byte_1_low_table, _mm_and_si128(prev1, nibble_mask));
+    auto const byte_2_high = _mm_shuffle_epi8(byte_2_high_table, _mm_and_si128(_mm_srli_epi16(chunk, 4), nibble_mask));
+    auto const special_cases = _mm_and_si128(_mm_and_si128(byte_1_high, byte_1_low), byte_2_high);
+
+    // The third and fourth byte of a code-point must be continuation bytes.
+    auto const prev2 = _mm_alignr_epi8(chunk, zero, 14);
+    auto const prev3 = _mm_alignr_epi8(chunk, zero, 13);
+    auto const is_third_byte = _mm_subs_epu8(prev2, _mm_set1_epi8(char_cast<char>(0b1110'0000 - 1)));
+    auto const is_fourth_byte = _mm_subs_epu8(prev3, _mm_set1_epi8(char_cast<char>(0b1111'0000 - 1)));
+    auto const must_be_23 = _mm_cmpgt_epi8(_mm_or_si128(is_third_byte, is_fourth_byte), zero);
+    auto const must_be_23_80 = _mm_and_si128(must_be_23, _mm_set1_epi8(char_cast<char>(0x80)));
+
+    return _mm_xor_si128(must_be_23_80, special_cases);
+}
+
+/** Get a mask with a bit set for each continuation byte.
+ */
+hi_target("sse,sse2,ssse3,sse4.1")
+[[nodiscard]] hi_force_inline inline uint32_t utf_8_continuation_mask_sse4_1(__m128i chunk) noexcept
+{
+    // Continuation bytes are 0x80 - 0xbf, as signed -128 to -65.
+    return truncate<uint32_t>(_mm_movemask_epi8(_mm_cmplt_epi8(chunk, _mm_set1_epi8(-64))));
+}
+
+/** Decode up to 12 bytes of validated UTF-8 into 32 bit code-points.
+ *
+ * @param chunk 16 bytes of UTF-8, starting at a code-point.
+ * @param[out] lo The first four code-points.
+ * @param[out] hi The next four code-points, only for 16 bit lanes.
+ * @return The shuffle that was used.
+ */
+hi_target("sse,sse2,ssse3,sse4.1")
+[[nodiscard]] hi_force_inline inline utf_8_decode_index
+utf_8_decode_sse4_1(__m128i chunk, uint32_t continuation_mask, __m128i& lo, __m128i& hi, utf_8_decode_shuffle const *& shuffle) noexcept
+{
+    // A code-point ends where the next byte is not a continuation byte.
+    auto const end_mask = ~(continuation_mask >> 1) & 0xfff;
+    auto const index = utf_8_decode_tables.index[end_mask];
+    shuffle = &utf_8_decode_tables.shuffles[index.shuffle_index];
+
+    auto const shuffle_ = _mm_loadu_si128(reinterpret_cast<__m128i const *>(shuffle->shuffle.data()));
+    auto const lanes = _mm_shuffle_epi8(chunk, shuffle_);
+
+    if (shuffle->is_16bit) {
+        // [0xxxxxxx, 0] or [10xxxxxx, 110yyyyy]
+        auto const ascii_or_last = _mm_and_si128(lanes, _mm_set1_epi16(0x7f));
+        auto const first = _mm_srli_epi16(_mm_and_si128(lanes, _mm_set1_epi16(0x1f00)), 2);
+        auto const code_points = _mm_or_si128(ascii_or_last, first);
+        lo = _mm_cvtepu16_epi32(code_points);
+        hi = _mm_cvtepu16_epi32(_mm_srli_si128(code_points, 8));
+
+    } else {
+        // The last byte of a code-point is in the low byte of the lane, the first byte of
+        // a four byte code-point makes the lane negative.
+        auto const is_4 = _mm_srai_epi32(lanes, 31);
+        auto const mask = _mm_or_si128(_mm_set1_epi32(0x000f'3f7f), _mm_and_si128(is_4, _mm_set1_epi32(0x0730'0000)));
+        auto const t = _mm_and_si128(lanes, mask);
+
+        auto r = _mm_and_si128(t, _mm_set1_epi32(0x7f));
+        r = _mm_or_si128(r, _mm_srli_epi32(_mm_and_si128(t, _mm_set1_epi32(0x3f00)), 2));
+        r = _mm_or_si128(r, _mm_srli_epi32(_mm_and_si128(t, _mm_set1_epi32(0x3f'0000)), 4));
+        r = _mm_or_si128(r, _mm_srli_epi32(_mm_and_si128(t, _mm_set1_epi32(0x0700'0000)), 6));
+        lo = r;
+    }
+    return index;
+}
+
+/** Convert a chunk of UTF-8 to UTF-32.
+ *
+ * @param src A pointer to at least `utf_8_x86_min_size` bytes of UTF-8, starting at a code-point.
+ * @param dst A pointer to the UTF-32 output.
+ * @param[out] dst_size The number of code-points written.
+ * @return The number of bytes converted, or zero if the chunk is invalid.
+ */
+hi_target("sse,sse2,ssse3,sse4.1")
+[[nodiscard]] inline std::size_t utf_8_to_utf_32_sse4_1(void const *src, void *dst, std::size_t& dst_size) noexcept
+{
+    auto const chunk = _mm_loadu_si128(static_cast<__m128i const *>(src));
+    auto *dst_ = static_cast<__m128i *>(dst);
+
+    if (_mm_movemask_epi8(chunk) == 0) {
+        auto const zero = _mm_setzero_si128();
+        auto const lo = _mm_unpacklo_epi8(chunk, zero);
+        auto const hi = _mm_unpackhi_epi8(chunk, zero);
+        _mm_storeu_si128(dst_, _mm_unpacklo_epi16(lo, zero));
+        _mm_storeu_si128(dst_ + 1, _mm_unpackhi_epi16(lo, zero));
+        _mm_storeu_si128(dst_ + 2, _mm_unpacklo_epi16(hi, zero));
+        _mm_storeu_si128(dst_ + 3, _mm_unpackhi_epi16(hi, zero));
+        dst_size = 16;
+        return 16;
+    }
+
+    auto const errors = utf_8_errors_sse4_1(chunk);
+    if (not _mm_testz_si128(errors, errors)) {
+        return 0;
+    }
+
+    auto lo = __m128i{};
+    auto hi = __m128i{};
+    auto const *shuffle = static_cast<utf_8_decode_shuffle const *>(nullptr);
+    auto const index = utf_8_decode_sse4_1(chunk, utf_8_continuation_mask_sse4_1(chunk), lo, hi, shuffle);
+
+    _mm_storeu_si128(dst_, lo);
+    if (shuffle->is_16bit) {
+        _mm_storeu_si128(dst_ + 1, hi);
+    }
+    dst_size = shuffle->count;
+    return index.size;
+}
+
+/** Convert a chunk of UTF-8 to UTF-16.
+ *
+ * @param src A pointer to at least `utf_8_x86_min_size` bytes of UTF-8, starting at a code-point.
+ * @param dst A pointer to the UTF-16 output.
+ * @param[out] dst_size The number of code-units written.
+ * @return The number of bytes converted, or zero if the chunk is invalid.
+ */
+hi_target("sse,sse2,ssse3,sse4.1")
+[[nodiscard]] inline std::size_t utf_8_to_utf_16_sse4_1(void const *src, void *dst, std::size_t& dst_size) noexcept
+{
+    auto const chunk = _mm_loadu_si128(static_cast<__m128i const *>(src));
+    auto *dst_ = static_cast<__m128i *>(dst);
+
+    if (_mm_movemask_epi8(chunk) == 0) {
+        auto const zero = _mm_setzero_si128();
+        _mm_storeu_si128(dst_, _mm_unpacklo_epi8(chunk, zero));
+        _mm_storeu_si128(dst_ + 1, _mm_unpackhi_epi8(chunk, zero));
+        dst_size = 16;
+        return 16;
+    }
+
+    auto const errors = utf_8_errors_sse4_1(chunk);
+    if (not _mm_testz_si128(errors, errors)) {
+        return 0;
+    }
+
+    auto lo = __m128i{};
+    auto hi = __m128i{};
+    auto const *shuffle = static_cast<utf_8_decode_shuffle const *>(nullptr);
+    auto const index = utf_8_decode_sse4_1(chunk, utf_8_continuation_mask_sse4_1(chunk), lo, hi, shuffle);
+
+    if (shuffle->is_16bit) {
+        _mm_storeu_si128(dst_, _mm_packus_epi32(lo, hi));
+        dst_size = shuffle->count;
+
+    } else if (_mm_movemask_epi8(_mm_cmpgt_epi32(lo, _mm_set1_epi32(0xffff))) == 0) {
+        _mm_storel_epi64(dst_, _mm_packus_epi32(lo, lo));
+        dst_size = shuffle->count;
+
+    } else {
+        // Encode code-points outside the basic multilingual plane as surrogate pairs.
+        alignas(16) auto code_points = std::array<uint32_t, 4>{};
+        _mm_store_si128(reinterpret_cast<__m128i *>(code_points.data()), lo);
+
+        auto code_units = std::array<uint16_t, 8>{};
+        dst_size = 0;
+        for (auto i = 0_uz; i != shuffle->count; ++i) {
+            auto const code_point = code_points[i];
+            if (code_point < 0x1'0000) {
+                code_units[dst_size++] = truncate<uint16_t>(code_point);
+            } else {
+                auto const tmp = code_point - 0x1'0000;
+                code_units[dst_size++] = truncate<uint16_t>(0xd800 + (tmp >> 10));
+                code_units[dst_size++] = truncate<uint16_t>(0xdc00 + (tmp & 0x3ff));
+            }
+        }
+        _mm_storeu_si128(dst_, _mm_loadu_si128(reinterpret_cast<__m128i const *>(code_units.data())));
+    }
+    return index.size;
+}
+
+/** Validate a chunk of UTF-8 and count the code-units when converted.
+ *
+ * @param src A pointer to at least 16 bytes of UTF-8, starting at a code-point.
+ * @param[out] num_code_points The number of code-points in the validated text.
+ * @param[out] num_surrogates The number of code-points that are encoded in UTF-16 as surrogate pairs.
+ * @return The number of bytes validated, or zero if the chunk is invalid.
+ */
+hi_target("sse,sse2,ssse3,sse4.1")
+[[nodiscard]] inline std::size_t
+utf_8_count_sse4_1(void const *src, std::size_t& num_code_points, std::size_t& num_surrogates) noexcept
+{
+    auto const chunk = _mm_loadu_si128(static_cast<__m128i const *>(src));
+    if (_mm_movemask_epi8(chunk) == 0) {
+        num_code_points = 16;
+        num_surrogates = 0;
+        return 16;
+    }
+
+    auto const errors = utf_8_errors_sse4_1(chunk);
+    if (not _mm_testz_si128(errors, errors)) {
+        return 0;
+    }
+
+    // Stop at the start of the last code-point, which may continue beyond this chunk.
+    auto const starts_mask = ~utf_8_continuation_mask_sse4_1(chunk) & 0xffff;
+    auto const size = std::bit_width(starts_mask) - 1;
+    auto const size_mask = (1U << size) - 1;
+
+    auto const lead_4 = _mm_set1_epi8(char_cast<char>(0xf0));
+    auto const lead_4_mask = truncate<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(chunk, lead_4), chunk)));
+    num_code_points = std::popcount(starts_mask & size_mask);
+    num_surrogates = std::popcount(lead_4_mask & size_mask);
+    return size;
+}
+
+struct utf_8_encode_shuffle {
+    std::array<uint8_t, 16> shuffle = {};
+    uint8_t size = 0;
+};
+
+/** The shuffles to pack four code-points of one to three bytes.
+ *
+ * Indexed by the mask of code-points of two or more bytes, and the mask of
+ * code-points of three bytes shifted left by four.
+ */
+[[nodiscard]] consteval std::array<utf_8_encode_shuffle, 256> make_utf_8_encode_shuffles() noexcept
+{
+    auto r = std::array<utf_8_encode_shuffle, 256>{};
+    for (auto i = 0_uz; i != 256; ++i) {
+        r[i].shuffle.fill(0x80);
+
+        auto size = 0_uz;
+        for (auto lane = 0_uz; lane != 4; ++lane) {
+            auto const length = 1 + ((i >> lane) & 1) + ((i >> (lane + 4)) & 1);
+            for (auto j = 0_uz; j != length; ++j) {
+                r[i].shuffle[size++] = narrow_cast<uint8_t>(lane * 4 + j);
+            }
+        }
+        r[i].size = narrow_cast<uint8_t>(size);
+    }
+    return r;
+}
+
+constexpr auto utf_8_encode_shuffles = make_utf_8_encode_shuffles();
+
+/** Encode four code-points in the basic multilingual plane as UTF-8.
+ *
+ * @param code_points Four code-points, none of them surrogates.
+ * @param dst A pointer to the output, where 16 bytes may be written.
+ * @return The number of bytes of UTF-8.
+ */
+hi_target("sse,sse2,ssse3,sse4.1")
+[[nodiscard]] hi_force_inline inline std::size_t utf_8_encode_sse4_1(__m128i code_points, void *dst) noexcept
+{
+    auto const is_2 = _mm_cmpgt_epi32(code_points, _mm_set1_epi32(0x7f));
+    auto const is_3 = _mm_cmpgt_epi32(code_points, _mm_set1_epi32(0x7ff));
+
+    auto const t1 = _mm_and_si128(code_points, _mm_set1_epi32(0x3f));
+    auto const t2 = _mm_and_si128(_mm_srli_epi32(code_points, 6), _mm_set1_epi32(0x3f));
+    auto const t3 = _mm_srli_epi32(code_points, 12);
+
+    // [110yyyyy, 10xxxxxx]
+    auto const two = _mm_or_si128(
+        _mm_or_si128(_mm_srli_epi32(code_points, 6), _mm_slli_epi32(t1, 8)), _mm_set1_epi32(0x80c0));
+    // [1110zzzz, 10yyyyyy, 10xxxxxx]
+    auto const three = _mm_or_si128(
+        _mm_or_si128(t3, _mm_or_si128(_mm_slli_epi32(t2, 8), _mm_slli_epi32(t1, 16))), _mm_set1_epi32(0x8080e0));
+
+    auto const lanes = _mm_blendv_epi8(_mm_blendv_epi8(code_points, two, is_2), three, is_3);
+
+    auto const index = _mm_movemask_ps(_mm_castsi128_ps(is_2)) | (_mm_movemask_ps(_mm_castsi128_ps(is_3)) << 4);
+    auto const& shuffle = utf_8_encode_shuffles[index];
+    auto const shuffle_ = _mm_loadu_si128(reinterpret_cast<__m128i const *>(shuffle.shuffle.data()));
+    _mm_storeu_si128(static_cast<__m128i *>(dst), _mm_shuffle_epi8(lanes, shuffle_));
+    return shuffle.size;
+}
+
+/** Convert a chunk of UTF-32 to UTF-8.
+ *
+ * @param src A pointer to at least `utf_8_x86_min_size` code-units of UTF-32.
+ * @param dst A pointer to the UTF-8 output.
+ * @param[out] dst_size The number of bytes written.
+ * @return The number of code-points converted, or zero if the chunk contains
+ *         code-points outside the basic multilingual plane or surrogates.
+ */
+hi_target("sse,sse2,ssse3,sse4.1")
+[[nodiscard]] inline std::size_t utf_32_to_utf_8_sse4_1(void const *src, void *dst, std::size_t& dst_size) noexcept
+{
+    auto const *src_ = static_cast<__m128i const *>(src);
+    auto *dst_ = static_cast<uint8_t *>(dst);
+    auto const c0 = _mm_loadu_si128(src_);
+    auto const c1 = _mm_loadu_si128(src_ + 1);
+
+    auto const all = _mm_or_si128(c0, c1);
+    if (_mm_testz_si128(all, _mm_set1_epi32(0xffff'ff80))) {
+        auto const c2 = _mm_loadu_si128(src_ + 2);
+        auto const c3 = _mm_loadu_si128(src_ + 3);
+        if (_mm_testz_si128(_mm_or_si128(c2, c3), _mm_set1_epi32(0xffff'ff80))) {
+            auto const ascii = _mm_packus_epi16(_mm_packus_epi32(c0, c1), _mm_packus_epi32(c2, c3));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(dst_), ascii);
+            dst_size = 16;
+            return 16;
+        }
+    }
+
+    auto const surrogate = _mm_set1_epi32(0xd800);
+    auto const surrogate_mask = _mm_set1_epi32(0xffff'f800);
+    if (not _mm_testz_si128(_mm_max_epu32(c0, c1), _mm_set1_epi32(0xffff'0000))) {
+        return 0;
+    }
+
+    auto const is_surrogate =
+        _mm_or_si128(_mm_cmpeq_epi32(_mm_and_si128(c0, surrogate_mask), surrogate), _mm_cmpeq_epi32(_mm_and_si128(c1, surrogate_mask), surrogate));
+    if (not _mm_testz_si128(is_surrogate, is_surrogate)) {
+        return 0;
+    }
+
+    dst_size = utf_8_encode_sse4_1(c0, dst_);
+    dst_size += utf_8_encode_sse4_1(c1, dst_ + dst_size);
+    return 8;
+}
+
+/** Convert a chunk of UTF-16 to UTF-8.
+ *
+ * @param src A pointer to at least `utf_8_x86_min_size` code-units of UTF-16.
+ * @param dst A pointer to the UTF-8 output.
+ * @param[out] dst_size The number of bytes written.
+ * @return The number of code-units converted, or zero if the chunk contains surrogates.
+ */
+hi_target("sse,sse2,ssse3,sse4.1")
+[[nodiscard]] inline std::size_t utf_16_to_utf_8_sse4_1(void const *src, void *dst, std::size_t& dst_size) noexcept
+{
+    auto const *src_ = static_cast<__m128i const *>(src);
+    auto *dst_ = static_cast<uint8_t *>(dst);
+    auto const c0 = _mm_loadu_si128(src_);
+    auto const c1 = _mm_loadu_si128(src_ + 1);
+
+    if (_mm_testz_si128(_mm_or_si128(c0, c1), _mm_set1_epi16(char_cast<short>(uint16_t{0xff80})))) {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst_), _mm_packus_epi16(c0, c1));
+        dst_size = 16;
+        return 16;
+    }
+
+    auto const is_surrogate =
+        _mm_cmpeq_epi16(_mm_and_si128(c0, _mm_set1_epi16(char_cast<short>(uint16_t{0xf800}))), _mm_set1_epi16(char_cast<short>(uint16_t{0xd800})));
+    if (not _mm_testz_si128(is_surrogate, is_surrogate)) {
+        return 0;
+    }
+
+    dst_size = utf_8_encode_sse4_1(_mm_cvtepu16_epi32(c0), dst_);
+    dst_size += utf_8_encode_sse4_1(_mm_cvtepu16_epi32(_mm_srli_si128(c0, 8)), dst_ + dst_size);
+    return 8;
+}
+
+/** Count the number of UTF-8 code-units needed for a chunk of UTF-32.
+ *
+ * @param src A pointer to at least 16 code-units of UTF-32.
+ * @param[out] size The number of bytes needed.
+ * @return The number of code-points counted, or zero if the chunk contains
+ *         code-points outside the basic multilingual plane or surrogates.
+ */
+hi_target("sse,sse2,ssse3,sse4.1")
+[[nodiscard]] inline std::size_t utf_32_count_utf_8_sse4_1(void const *src, std::size_t& size) noexcept
+{
+    auto const *src_ = static_cast<__m128i const *>(src);
+    auto const c0 = _mm_loadu_si128(src_);
+    auto const c1 = _mm_loadu_si128(src_ + 1);
+    auto const c2 = _mm_loadu_si128(src_ + 2);
+    auto const c3 = _mm_loadu_si128(src_ + 3);
+
+    auto const max = _mm_max_epu32(_mm_max_epu32(c0, c1), _mm_max_epu32(c2, c3));
+    if (not _mm_testz_si128(max, _mm_set1_epi32(0xffff'0000))) {
+        return 0;
+    }
+
+    // The code-points fit in 16 bits, continue as UTF-16.
+    auto const lo = _mm_packus_epi32(c0, c1);
+    auto const hi = _mm_packus_epi32(c2, c3);
+
+    auto const surrogate = _mm_set1_epi16(char_cast<short>(uint16_t{0xd800}));
+    auto const surrogate_mask = _mm_set1_epi16(char_cast<short>(uint16_t{0xf800}));
+    auto const is_surrogate = _mm_or_si128(
+        _mm_cmpeq_epi16(_mm_and_si128(lo, surrogate_mask), surrogate), _mm_cmpeq_epi16(_mm_and_si128(hi, surrogate_mask), surrogate));
+    if (not _mm_testz_si128(is_surrogate, is_surrogate)) {
+        return 0;
+    }
+
+    auto const zero = _mm_setzero_si128();
+    auto const not_1_lo = _mm_cmpeq_epi16(_mm_and_si128(lo, _mm_set1_epi16(char_cast<short>(uint16_t{0xff80}))), zero);
+    auto const not_1_hi = _mm_cmpeq_epi16(_mm_and_si128(hi, _mm_set1_epi16(char_cast<short>(uint16_t{0xff80}))), zero);
+    auto const not_3_lo = _mm_cmpeq_epi16(_mm_and_si128(lo, surrogate_mask), zero);
+    auto const not_3_hi = _mm_cmpeq_epi16(_mm_and_si128(hi, surrogate_mask), zero);
+
+    auto const num_1 = std::popcount(truncate<uint32_t>(_mm_movemask_epi8(_mm_packs_epi16(not_1_lo, not_1_hi))));
+    auto const num_3 = std::popcount(truncate<uint32_t>(_mm_movemask_epi8(_mm_packs_epi16(not_3_lo, not_3_hi))));
+    size = 48 - num_1 - num_3;
+    return 16;
+}
+
+/** Count the number of UTF-8 code-units needed for a chunk of UTF-16.
+ *
+ * @param src A pointer to at least 16 code-units of UTF-16.
+ * @param[out] size The number of bytes needed.
+ * @return The number of code-units counted, or zero if the chunk contains surrogates.
+ */
+hi_target("sse,sse2,ssse3,sse4.1")
+[[nodiscard]] inline std::size_t utf_16_count_utf_8_sse4_1(void const *src, std::size_t& size) noexcept
+{
+    auto const *src_ = static_cast<__m128i const *>(src);
+    auto const lo = _mm_loadu_si128(src_);
+    auto const hi = _mm_loadu_si128(src_ + 1);
+
+    auto const surrogate = _mm_set1_epi16(char_cast<short>(uint16_t{0xd800}));
+    auto const surrogate_mask = _mm_set1_epi16(char_cast<short>(uint16_t{0xf800}));
+    auto const is_surrogate = _mm_or_si128(
+        _mm_cmpeq_epi16(_mm_and_si128(lo, surrogate_mask), surrogate), _mm_cmpeq_epi16(_mm_and_si128(hi, surrogate_mask), surrogate));
+    if (not _mm_testz_si128(is_surrogate, is_surrogate)) {
+        return 0;
+    }
+
+    auto const zero = _mm_setzero_si128();
+    auto const not_1_lo = _mm_cmpeq_epi16(_mm_and_si128(lo, _mm_set1_epi16(char_cast<short>(uint16_t{0xff80}))), zero);
+    auto const not_1_hi = _mm_cmpeq_epi16(_mm_and_si128(hi, _mm_set1_epi16(char_cast<short>(uint16_t{0xff80}))), zero);
+    auto const not_3_lo = _mm_cmpeq_epi16(_mm_and_si128(lo, surrogate_mask), zero);
+    auto const not_3_hi = _mm_cmpeq_epi16(_mm_and_si128(hi, surrogate_mask), zero);
+
+    auto const num_1 = std::popcount(truncate<uint32_t>(_mm_movemask_epi8(_mm_packs_epi16(not_1_lo, not_1_hi))));
+    auto const num_3 = std::popcount(truncate<uint32_t>(_mm_movemask_epi8(_mm_packs_epi16(not_3_lo, not_3_hi))));
+    size = 48 - num_1 - num_3;
+    return 16;
+}
+
+} // namespace detail
+}} // namespace hi::v1
+
+hi_warning_pop();
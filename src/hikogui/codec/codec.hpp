@@ -8,6 +8,7 @@
 #include "huffman.hpp" // export
 #include "indent.hpp" // export
 #include "inflate.hpp" // export
+#include "inflate_stream.hpp" // export
 #include "JSON.hpp" // export
 #include "jsonpath.hpp" // export
 #include "pickle.hpp" // export
@@ -6,169 +6,174 @@
 
 #include "../utility/utility.hpp"
 #include "../macros.hpp"
-#include <span>
 #include <vector>
+#include <array>
 #include <algorithm>
+#include <cstdint>
 
 hi_export_module(hikogui.codec.huffman);
 
 hi_export namespace hi { inline namespace v1 {
 
-hi_export template<typename T>
-class huffman_tree {
-    static_assert(std::is_integral_v<T> && std::is_signed_v<T>);
-
-    using state_t = T const *;
-
-    /** The internal data structure holding the tree.
-     * A pair of values are added to the list for each tree-node.
-     * The values have the following meaning:
-     *  - negative number are relative offset from the current
-     *    position to the next tree node. So that it is possible
-     *    to simply add the negative value to the iterator.
-     *  - positive number is the symbol value + 1.
-     *  - zero was unused or not yet assigned.
-     */
-    std::vector<T> tree;
-
+/** A table driven canonical-huffman decoder.
+ *
+ * Codes up to `PrimaryBits` long are decoded with a single lookup in the
+ * primary table. Longer codes use a second lookup in a sub-table, which is
+ * selected by the first `PrimaryBits` bits of the code.
+ *
+ * Like deflate, the bits of the code are read LSB first from the stream.
+ *
+ * @tparam PrimaryBits The number of bits used to index the primary table.
+ */
+hi_export template<std::size_t PrimaryBits>
+class huffman_table {
 public:
-    huffman_tree() noexcept
-    {
-        tree.push_back(0);
-        tree.push_back(0);
-    }
-
-    /** Add a symbol to the huffman_tree.
-     *
+    /** The maximum length of a code, as used by deflate.
      */
-    void add(int symbol, int code, int code_length) noexcept
-    {
-        hi_axiom(code_length >= 1);
-
-        int offset = 0;
-        while (--code_length > 0) {
-            auto const select = (code >> code_length) & 1;
-            offset += select;
-
-            int value = tree[offset];
+    constexpr static std::size_t max_code_length = 15;
 
-            // value may not be a leaf.
-            hi_axiom(value <= 0);
+    static_assert(PrimaryBits >= 1 and PrimaryBits <= max_code_length);
 
-            if (value == 0) {
-                // Unused node entry. Point to the first of two new entries.
-                value = -(narrow_cast<int>(ssize(tree)) - offset);
+    struct entry_type {
+        /** The symbol, or the offset of the sub-table.
+         */
+        uint16_t value = 0;
 
-                tree[offset] = narrow_cast<T>(value);
-                tree.push_back(0);
-                tree.push_back(0);
-            }
-
-            // Go to the next entry.
-            offset -= value;
-        }
+        /** The length of the code, zero when the code is not in the table.
+         */
+        uint8_t length = 0;
 
-        // place the symbol as a leaf.
-        auto const select = code & 1;
-        offset += select;
+        /** The number of bits to index the sub-table, zero for a symbol.
+         */
+        uint8_t sub_table_bits = 0;
+    };
 
-        hi_axiom(tree[offset] == 0);
-        tree[offset] = narrow_cast<T>(symbol + 1);
-    }
+    huffman_table() noexcept = default;
+    huffman_table(huffman_table const&) = default;
+    huffman_table(huffman_table&&) noexcept = default;
+    huffman_table& operator=(huffman_table const&) = default;
+    huffman_table& operator=(huffman_table&&) noexcept = default;
 
-    [[nodiscard]] state_t start() const noexcept
-    {
-        return tree.data();
-    }
-
-    /** Get a symbol from the huffman-tree.
-     *
-     * Before `get()` is called use `start()` to create a state to
-     * pass between invocations. State is invalid after `get()` returns
-     * a symbol or throws.
+    /** Decode a symbol.
      *
-     * @param code_bit The next bit from the huffman encoded stream.
-     * @param state The state carried between invocations @see start().
-     * @return Positive numbers are symbols, negative means more code_bits
-     *         are needed.
-     * @throw parse-error on invalid code-bit sequence.
+     * @param bits The next bits of the stream, the first bit in the LSB. At least
+     *             `max_code_length` bits, or padded with zeros at the end of the stream.
+     * @return The entry of the symbol, with `length` set to the number of bits
+     *         to consume; or zero if the code is not in the table.
      */
-    [[nodiscard]] int get(bool code_bit, state_t& state) const
+    [[nodiscard]] hi_force_inline entry_type decode(uint64_t bits) const noexcept
     {
-        state += static_cast<ptrdiff_t>(code_bit);
+        hi_axiom(not _table.empty());
 
-        if (*state == 0) {
-            throw parse_error("Code not in huffman tree.");
+        auto const entry = _table[bits & primary_mask];
+        if (entry.sub_table_bits == 0) [[likely]] {
+            return entry;
         }
 
-        auto value = *state;
-        state -= static_cast<ptrdiff_t>(value);
-        return value - 1;
-    }
-
-    [[nodiscard]] std::size_t get_symbol(std::span<std::byte const> bytes, std::size_t& bit_offset) const noexcept
-    {
-        auto state = start();
-        while (true) {
-            int symbol;
-            if ((symbol = get(get_bit(bytes, bit_offset), state)) >= 0) {
-                return static_cast<std::size_t>(symbol);
-            }
-        }
+        auto const sub_table_mask = (uint64_t{1} << entry.sub_table_bits) - 1;
+        return _table[entry.value + ((bits >> PrimaryBits) & sub_table_mask)];
     }
 
     /** Build a canonical-huffman table from a set of lengths.
+     *
+     * @param lengths The length of the code of each symbol, zero if the symbol is unused.
+     * @param nr_symbols The number of symbols.
+     * @throw parse_error When the lengths do not describe a valid prefix code.
      */
-    [[nodiscard]] static huffman_tree from_lengths(uint8_t const *lengths, std::size_t nr_symbols)
+    [[nodiscard]] static huffman_table from_lengths(uint8_t const *lengths, std::size_t nr_symbols)
     {
         hi_assert_not_null(lengths);
-        hi_axiom(nr_symbols < std::numeric_limits<T>::min());
-
-        struct symbol_length_t {
-            T symbol;
-            uint8_t length;
-
-            symbol_length_t(T symbol, uint8_t length) : symbol(symbol), length(length) {}
-        };
-
-        std::vector<symbol_length_t> symbol_lengths;
-        symbol_lengths.reserve(nr_symbols);
+        hi_axiom(nr_symbols <= std::numeric_limits<uint16_t>::max());
 
-        for (T symbol = T{0}; symbol != narrow_cast<T>(nr_symbols); ++symbol) {
-            symbol_lengths.emplace_back(symbol, lengths[symbol]);
+        auto length_count = std::array<uint32_t, max_code_length + 1>{};
+        for (auto symbol = 0_uz; symbol != nr_symbols; ++symbol) {
+            hi_check(lengths[symbol] <= max_code_length, "Huffman code length too long");
+            ++length_count[lengths[symbol]];
+        }
+        length_count[0] = 0;
+
+        // The first code of each length, see RFC 1951 section 3.2.2.
+        auto next_code = std::array<uint32_t, max_code_length + 1>{};
+        auto code = uint32_t{0};
+        for (auto length = 1_uz; length <= max_code_length; ++length) {
+            code = (code + length_count[length - 1]) << 1;
+            next_code[length] = code;
+            hi_check(code + length_count[length] <= (uint32_t{1} << length), "Huffman code lengths are over-subscribed");
         }
 
-        // Sort the table based on the length of the code, followed by symbol
-        std::sort(symbol_lengths.begin(), symbol_lengths.end(), [](auto const& a, auto const& b) {
-            if (a.length == b.length) {
-                return a.symbol < b.symbol;
-            } else {
-                return a.length < b.length;
+        // Assign the codes, bit-reversed since they are read LSB first, and
+        // determine the size of each sub-table from its longest code.
+        auto codes = std::vector<uint16_t>(nr_symbols, 0);
+        auto sub_table_bits = std::array<uint8_t, primary_size>{};
+        for (auto symbol = 0_uz; symbol != nr_symbols; ++symbol) {
+            auto const length = lengths[symbol];
+            if (length == 0) {
+                continue;
             }
-        });
 
-        auto r = huffman_tree{};
+            codes[symbol] = reverse_bits(next_code[length]++, length);
+            if (length > PrimaryBits) {
+                auto& bits = sub_table_bits[codes[symbol] & primary_mask];
+                bits = std::max(bits, narrow_cast<uint8_t>(length - PrimaryBits));
+            }
+        }
 
-        int code = 0;
-        int prev_length = 0;
-        for (auto&& entry : symbol_lengths) {
-            if (entry.length != 0) {
-                code <<= (entry.length - prev_length);
+        auto r = huffman_table{};
+        r._table.resize(primary_size);
+        for (auto i = 0_uz; i != primary_size; ++i) {
+            if (sub_table_bits[i] != 0) {
+                r._table[i] = entry_type{narrow_cast<uint16_t>(r._table.size()), narrow_cast<uint8_t>(PrimaryBits), sub_table_bits[i]};
+                r._table.resize(r._table.size() + (1_uz << sub_table_bits[i]));
+            }
+        }
 
-                r.add(entry.symbol, code, entry.length);
-                ++code;
+        // Fill in every entry whose index starts with the code.
+        for (auto symbol = 0_uz; symbol != nr_symbols; ++symbol) {
+            auto const length = lengths[symbol];
+            if (length == 0) {
+                continue;
             }
 
-            prev_length = entry.length;
+            auto const entry = entry_type{narrow_cast<uint16_t>(symbol), length, 0};
+            auto const code_ = codes[symbol];
+            if (length <= PrimaryBits) {
+                for (auto i = 0_uz + code_; i < primary_size; i += 1_uz << length) {
+                    r._table[i] = entry;
+                }
+            } else {
+                auto const sub_table = r._table[code_ & primary_mask];
+                auto const sub_table_size = 1_uz << sub_table.sub_table_bits;
+                for (auto i = 0_uz + (code_ >> PrimaryBits); i < sub_table_size; i += 1_uz << (length - PrimaryBits)) {
+                    r._table[sub_table.value + i] = entry;
+                }
+            }
         }
 
         return r;
     }
 
-    [[nodiscard]] static huffman_tree from_lengths(std::vector<uint8_t> const& lengths)
+    [[nodiscard]] static huffman_table from_lengths(std::vector<uint8_t> const& lengths)
     {
         return from_lengths(lengths.data(), lengths.size());
     }
+
+private:
+    constexpr static std::size_t primary_size = 1_uz << PrimaryBits;
+    constexpr static std::size_t primary_mask = primary_size - 1;
+
+    /** The primary table, followed by the sub-tables.
+     */
+    std::vector<entry_type> _table;
+
+    [[nodiscard]] constexpr static uint16_t reverse_bits(uint32_t code, std::size_t length) noexcept
+    {
+        auto r = uint16_t{0};
+        for (auto i = 0_uz; i != length; ++i) {
+            r = narrow_cast<uint16_t>((r << 1) | (code & 1));
+            code >>= 1;
+        }
+        return r;
+    }
 };
 
 }} // namespace hi::v1
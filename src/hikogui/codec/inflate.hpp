@@ -10,178 +10,277 @@
 #include "../macros.hpp"
 #include "huffman.hpp"
 #include <span>
+#include <array>
+#include <cstring>
+#include <cstdint>
 
 hi_export_module(hikogui.codec.inflate);
 
 hi_export namespace hi { inline namespace v1 {
 namespace detail {
 
-inline void inflate_copy_block(std::span<std::byte const> bytes, std::size_t& bit_offset, std::size_t max_size, bstring& r)
-{
-    auto offset = (bit_offset + 7) / 8;
+/** Read bits LSB first from a span of bytes, through a 64 bit buffer.
+ *
+ * The buffer is refilled with a single unaligned load while there are at
+ * least 8 bytes left in the input, after which it falls back to loading a
+ * byte at a time.
+ */
+class inflate_bit_reader {
+public:
+    inflate_bit_reader() noexcept = default;
+
+    /** Start reading bits.
+     *
+     * @param bytes The input.
+     * @param offset The byte offset in the input to start reading.
+     */
+    inflate_bit_reader(std::span<std::byte const> bytes, std::size_t offset) noexcept : _bytes(bytes), _offset(offset)
+    {
+        hi_axiom(offset <= bytes.size());
+    }
 
-    auto LEN = **make_placement_ptr<little_uint16_buf_t>(bytes, offset);
-    [[maybe_unused]] auto NLEN = **make_placement_ptr<little_uint16_buf_t>(bytes, offset);
+    /** Continue reading bits from a new span of bytes.
+     *
+     * Bits that are still in the buffer are read before the new bytes.
+     *
+     * @pre All bytes of the previous span must have been loaded into the buffer.
+     * @param bytes The input that follows the previous input.
+     */
+    void set_input(std::span<std::byte const> bytes) noexcept
+    {
+        hi_axiom(_offset == _bytes.size());
+        _bytes = bytes;
+        _offset = 0;
+    }
 
-    hi_check((offset + LEN) <= bytes.size(), "input buffer overrun");
-    hi_check((r.size() + LEN) <= max_size, "output buffer overrun");
-    r.append(&bytes[offset], LEN);
+    /** The number of bits in the buffer.
+     */
+    [[nodiscard]] hi_force_inline std::size_t size() const noexcept
+    {
+        return _nr_bits;
+    }
+
+    /** The offset in bits from the start of the input of the next bit.
+     */
+    [[nodiscard]] std::size_t bit_offset() const noexcept
+    {
+        return _offset * 8 - _nr_bits;
+    }
+
+    /** Fill the buffer with at least 56 bits, if there is enough input left.
+     */
+    hi_force_inline void refill() noexcept
+    {
+        if (_offset + sizeof(uint64_t) <= _bytes.size()) [[likely]] {
+            // Load 8 bytes, but only account for the whole bytes that fit in
+            // the buffer. The partial byte is loaded again on the next refill.
+            _bits |= load_le<uint64_t>(_bytes.data() + _offset) << _nr_bits;
+            _offset += (63 - _nr_bits) >> 3;
+            _nr_bits |= 56;
+
+        } else {
+            while (_nr_bits <= 56 and _offset < _bytes.size()) {
+                _bits |= static_cast<uint64_t>(_bytes[_offset++]) << _nr_bits;
+                _nr_bits += 8;
+            }
+        }
+    }
+
+    /** The bits in the buffer, the next bit in the LSB.
+     *
+     * Bits beyond `size()` are either zero or the bits that follow in the input.
+     */
+    [[nodiscard]] hi_force_inline uint64_t peek() const noexcept
+    {
+        return _bits;
+    }
+
+    /** Remove bits from the buffer.
+     */
+    hi_force_inline void consume(std::size_t nr_bits) noexcept
+    {
+        hi_axiom(nr_bits <= _nr_bits);
+        _bits >>= nr_bits;
+        _nr_bits -= nr_bits;
+    }
+
+    /** Read a number of bits.
+     *
+     * @param nr_bits The number of bits to read, at most 56.
+     * @return The bits, the first bit read in the LSB.
+     * @throw parse_error When reading beyond the end of the input.
+     */
+    [[nodiscard]] hi_force_inline std::size_t get(std::size_t nr_bits)
+    {
+        hi_axiom(nr_bits <= 56);
+
+        if (_nr_bits < nr_bits) {
+            refill();
+            hi_check(_nr_bits >= nr_bits, "Input buffer overrun");
+        }
+
+        auto const r = _bits & ((uint64_t{1} << nr_bits) - 1);
+        consume(nr_bits);
+        return narrow_cast<std::size_t>(r);
+    }
+
+    /** Skip to the start of the next byte.
+     */
+    void align_to_byte() noexcept
+    {
+        consume(_nr_bits & 7);
+    }
+
+    /** Read a number of bytes directly from the input.
+     *
+     * @pre The reader must be aligned to a byte.
+     * @param nr_bytes The number of bytes to read.
+     * @return The bytes from the input.
+     * @throw parse_error When reading beyond the end of the input.
+     */
+    [[nodiscard]] std::span<std::byte const> get_bytes(std::size_t nr_bytes)
+    {
+        hi_axiom(_nr_bits % 8 == 0);
+
+        auto const offset = _offset - _nr_bits / 8;
+        hi_check(offset + nr_bytes <= _bytes.size(), "Input buffer overrun");
+
+        _offset = offset + nr_bytes;
+        _bits = 0;
+        _nr_bits = 0;
+        return _bytes.subspan(offset, nr_bytes);
+    }
+
+private:
+    std::span<std::byte const> _bytes;
+    std::size_t _offset = 0;
+    uint64_t _bits = 0;
+    std::size_t _nr_bits = 0;
+};
+
+using inflate_literal_table = huffman_table<10>;
+using inflate_distance_table = huffman_table<9>;
+using inflate_code_length_table = huffman_table<7>;
+
+/** The base length of the length symbols 257 to 285.
+ */
+constexpr auto inflate_length_base = std::array<uint16_t, 29>{
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+
+/** The number of extra bits of the length symbols 257 to 285.
+ */
+constexpr auto inflate_length_extra_bits =
+    std::array<uint8_t, 29>{0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+
+/** The base distance of the distance symbols 0 to 29.
+ */
+constexpr auto inflate_distance_base = std::array<uint16_t, 30>{1,    2,    3,    4,    5,    7,     9,     13,    17,  25,
+                                                                33,   49,   65,   97,   129,  193,   257,   385,   513, 769,
+                                                                1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+
+/** The number of extra bits of the distance symbols 0 to 29.
+ */
+constexpr auto inflate_distance_extra_bits = std::array<uint8_t, 30>{0, 0, 0, 0, 1, 1, 2, 2,  3,  3,  4,  4,  5,  5,  6,
+                                                                     6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+/** Decode the next symbol from the input.
+ *
+ * @throw parse_error When the code is not in the table, or on reading beyond the end of the input.
+ */
+template<std::size_t PrimaryBits>
+[[nodiscard]] hi_force_inline std::size_t inflate_decode_symbol(inflate_bit_reader& reader, huffman_table<PrimaryBits> const& table)
+{
+    reader.refill();
 
-    bit_offset = offset * 8;
+    auto const entry = table.decode(reader.peek());
+    if (entry.length == 0) {
+        throw parse_error("Code not in huffman table.");
+    }
+    hi_check(entry.length <= reader.size(), "Input buffer overrun");
+
+    reader.consume(entry.length);
+    return entry.value;
 }
 
-[[nodiscard]] inline std::size_t
-inflate_decode_length(std::span<std::byte const> bytes, std::size_t& bit_offset, std::size_t symbol)
+[[nodiscard]] hi_force_inline std::size_t inflate_decode_length(inflate_bit_reader& reader, std::size_t symbol)
 {
-    switch (symbol) {
-    case 257:
-        return 3;
-    case 258:
-        return 4;
-    case 259:
-        return 5;
-    case 260:
-        return 6;
-    case 261:
-        return 7;
-    case 262:
-        return 8;
-    case 263:
-        return 9;
-    case 264:
-        return 10;
-    case 265:
-        return get_bits(bytes, bit_offset, 1) + 11;
-    case 266:
-        return get_bits(bytes, bit_offset, 1) + 13;
-    case 267:
-        return get_bits(bytes, bit_offset, 1) + 15;
-    case 268:
-        return get_bits(bytes, bit_offset, 1) + 17;
-    case 269:
-        return get_bits(bytes, bit_offset, 2) + 19;
-    case 270:
-        return get_bits(bytes, bit_offset, 2) + 23;
-    case 271:
-        return get_bits(bytes, bit_offset, 2) + 27;
-    case 272:
-        return get_bits(bytes, bit_offset, 2) + 31;
-    case 273:
-        return get_bits(bytes, bit_offset, 3) + 35;
-    case 274:
-        return get_bits(bytes, bit_offset, 3) + 43;
-    case 275:
-        return get_bits(bytes, bit_offset, 3) + 51;
-    case 276:
-        return get_bits(bytes, bit_offset, 3) + 59;
-    case 277:
-        return get_bits(bytes, bit_offset, 4) + 67;
-    case 278:
-        return get_bits(bytes, bit_offset, 4) + 83;
-    case 279:
-        return get_bits(bytes, bit_offset, 4) + 99;
-    case 280:
-        return get_bits(bytes, bit_offset, 4) + 115;
-    case 281:
-        return get_bits(bytes, bit_offset, 5) + 131;
-    case 282:
-        return get_bits(bytes, bit_offset, 5) + 163;
-    case 283:
-        return get_bits(bytes, bit_offset, 5) + 195;
-    case 284:
-        return get_bits(bytes, bit_offset, 5) + 227;
-    case 285:
-        return 258;
-    default:
+    if (symbol > 285) {
         throw parse_error(std::format("Literal/Length symbol out of range {}", symbol));
     }
+
+    auto const i = symbol - 257;
+    return inflate_length_base[i] + reader.get(inflate_length_extra_bits[i]);
 }
 
-[[nodiscard]] inline std::size_t
-inflate_decode_distance(std::span<std::byte const> bytes, std::size_t& bit_offset, std::size_t symbol)
+[[nodiscard]] hi_force_inline std::size_t inflate_decode_distance(inflate_bit_reader& reader, std::size_t symbol)
 {
-    switch (symbol) {
-    case 0:
-        return 1;
-    case 1:
-        return 2;
-    case 2:
-        return 3;
-    case 3:
-        return 4;
-    case 4:
-        return get_bits(bytes, bit_offset, 1) + 5;
-    case 5:
-        return get_bits(bytes, bit_offset, 1) + 7;
-    case 6:
-        return get_bits(bytes, bit_offset, 2) + 9;
-    case 7:
-        return get_bits(bytes, bit_offset, 2) + 13;
-    case 8:
-        return get_bits(bytes, bit_offset, 3) + 17;
-    case 9:
-        return get_bits(bytes, bit_offset, 3) + 25;
-    case 10:
-        return get_bits(bytes, bit_offset, 4) + 33;
-    case 11:
-        return get_bits(bytes, bit_offset, 4) + 49;
-    case 12:
-        return get_bits(bytes, bit_offset, 5) + 65;
-    case 13:
-        return get_bits(bytes, bit_offset, 5) + 97;
-    case 14:
-        return get_bits(bytes, bit_offset, 6) + 129;
-    case 15:
-        return get_bits(bytes, bit_offset, 6) + 193;
-    case 16:
-        return get_bits(bytes, bit_offset, 7) + 257;
-    case 17:
-        return get_bits(bytes, bit_offset, 7) + 385;
-    case 18:
-        return get_bits(bytes, bit_offset, 8) + 513;
-    case 19:
-        return get_bits(bytes, bit_offset, 8) + 769;
-    case 20:
-        return get_bits(bytes, bit_offset, 9) + 1025;
-    case 21:
-        return get_bits(bytes, bit_offset, 9) + 1537;
-    case 22:
-        return get_bits(bytes, bit_offset, 10) + 2049;
-    case 23:
-        return get_bits(bytes, bit_offset, 10) + 3073;
-    case 24:
-        return get_bits(bytes, bit_offset, 11) + 4097;
-    case 25:
-        return get_bits(bytes, bit_offset, 11) + 6145;
-    case 26:
-        return get_bits(bytes, bit_offset, 12) + 8193;
-    case 27:
-        return get_bits(bytes, bit_offset, 12) + 12289;
-    case 28:
-        return get_bits(bytes, bit_offset, 13) + 16385;
-    case 29:
-        return get_bits(bytes, bit_offset, 13) + 24577;
-    default:
+    if (symbol > 29) {
         throw parse_error(std::format("Distance symbol out of range {}", symbol));
     }
+
+    return inflate_distance_base[symbol] + reader.get(inflate_distance_extra_bits[symbol]);
+}
+
+/** Copy a back-reference to the end of the output.
+ *
+ * @param r The output.
+ * @param distance The distance from the end of the output to the start of the copy.
+ * @param length The number of bytes to copy.
+ */
+inline void inflate_copy_match(bstring& r, std::size_t distance, std::size_t length)
+{
+    hi_check(distance <= r.size(), "Distance beyond start of decompressed data");
+    hi_axiom(distance != 0);
+
+    auto const offset = r.size();
+    r.resize(offset + length);
+
+    auto *dst = r.data() + offset;
+    auto const *src = dst - distance;
+
+    if (distance == 1) {
+        // Run of a single byte.
+        std::memset(dst, static_cast<int>(*src), length);
+        return;
+    }
+
+    if (distance >= sizeof(uint64_t)) {
+        // Chunks of 8 bytes never overlap, a later chunk may read from an
+        // earlier chunk which was already written.
+        for (; length >= sizeof(uint64_t); length -= sizeof(uint64_t)) {
+            std::memcpy(dst, src, sizeof(uint64_t));
+            dst += sizeof(uint64_t);
+            src += sizeof(uint64_t);
+        }
+    }
+
+    for (; length != 0; --length) {
+        *dst++ = *src++;
+    }
+}
+
+inline void inflate_copy_block(inflate_bit_reader& reader, std::size_t max_size, bstring& r)
+{
+    reader.align_to_byte();
+
+    auto const LEN = reader.get(16);
+    auto const NLEN = reader.get(16);
+    hi_check(LEN == (~NLEN & 0xffff), "Stored block LEN does not match NLEN");
+
+    auto const bytes = reader.get_bytes(LEN);
+    hi_check((r.size() + LEN) <= max_size, "output buffer overrun");
+    r.append(bytes.data(), bytes.size());
 }
 
 inline void inflate_block(
-    std::span<std::byte const> bytes,
-    std::size_t& bit_offset,
+    inflate_bit_reader& reader,
     std::size_t max_size,
-    huffman_tree<int16_t> const& literal_tree,
-    huffman_tree<int16_t> const& distance_tree,
+    inflate_literal_table const& literal_table,
+    inflate_distance_table const& distance_table,
     bstring& r)
 {
     while (true) {
-        // Test only every get_symbol, the trailer is at least 32 bits (Checksum)
-        // - 15 bits maximum huffman code.
-        // -  5 bits extra length.
-        // -  7 bits rounding up to byte.
-        hi_check(((bit_offset + 27) >> 3) <= bytes.size(), "Input buffer overrun");
-
-        auto const literal_symbol = literal_tree.get_symbol(bytes, bit_offset);
+        auto const literal_symbol = inflate_decode_symbol(reader, literal_table);
 
         if (literal_symbol <= 255) {
             hi_check(r.size() < max_size, "Output buffer overrun");
@@ -192,31 +291,18 @@ inline void inflate_block(
             return;
 
         } else {
-            auto const length = inflate_decode_length(bytes, bit_offset, literal_symbol);
+            auto const length = inflate_decode_length(reader, literal_symbol);
             hi_check(r.size() + length <= max_size, "Output buffer overrun");
 
-            // Test only every get_symbol, the trailer is at least 32 bits (Checksum)
-            // - 15 bits maximum huffman code.
-            // -  7 bits rounding up to byte.
-            hi_check(((bit_offset + 22) >> 3) <= bytes.size(), "Input buffer overrun");
-            auto const distance_symbol = distance_tree.get_symbol(bytes, bit_offset);
-
-            // Test only every inflate_decode_distance, the trailer is at least 32 bits (Checksum)
-            // - 13 bits extra length.
-            // -  7 bits rounding up to byte.
-            hi_check(((bit_offset + 20) >> 3) <= bytes.size(), "Input buffer overrun");
-            auto const distance = inflate_decode_distance(bytes, bit_offset, distance_symbol);
-
-            hi_check(distance <= r.size(), "Distance beyond start of decompressed data");
-            auto src_i = r.size() - distance;
-            for (auto i = 0; i != length; ++i) {
-                r.push_back(r[src_i++]);
-            }
+            auto const distance_symbol = inflate_decode_symbol(reader, distance_table);
+            auto const distance = inflate_decode_distance(reader, distance_symbol);
+
+            inflate_copy_match(r, distance, length);
         }
     }
 }
 
-inline huffman_tree<int16_t> deflate_fixed_literal_tree = []() {
+inline inflate_literal_table deflate_fixed_literal_table = []() {
     std::vector<uint8_t> lengths;
 
     for (int i = 0; i <= 143; ++i) {
@@ -232,62 +318,51 @@ inline huffman_tree<int16_t> deflate_fixed_literal_tree = []() {
         lengths.push_back(8);
     }
 
-    return huffman_tree<int16_t>::from_lengths(lengths);
+    return inflate_literal_table::from_lengths(lengths);
 }();
 
-inline huffman_tree<int16_t> deflate_fixed_distance_tree = []() {
+inline inflate_distance_table deflate_fixed_distance_table = []() {
     std::vector<uint8_t> lengths;
 
     for (int i = 0; i <= 31; ++i) {
         lengths.push_back(5);
     }
 
-    return huffman_tree<int16_t>::from_lengths(lengths);
+    return inflate_distance_table::from_lengths(lengths);
 }();
 
-inline void inflate_fixed_block(std::span<std::byte const> bytes, std::size_t& bit_offset, std::size_t max_size, bstring& r)
+inline void inflate_fixed_block(inflate_bit_reader& reader, std::size_t max_size, bstring& r)
 {
-    inflate_block(bytes, bit_offset, max_size, deflate_fixed_literal_tree, deflate_fixed_distance_tree, r);
+    inflate_block(reader, max_size, deflate_fixed_literal_table, deflate_fixed_distance_table, r);
 }
 
-[[nodiscard]] inline huffman_tree<int16_t>
-inflate_code_lengths(std::span<std::byte const> bytes, std::size_t& bit_offset, std::size_t nr_symbols)
+[[nodiscard]] inline inflate_code_length_table inflate_code_lengths(inflate_bit_reader& reader, std::size_t nr_symbols)
 {
     // The symbols are in different order in the table.
     constexpr auto symbols = std::array<int16_t, 19>{16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
 
-    hi_check(((bit_offset + (3 * static_cast<std::size_t>(nr_symbols)) + 7) >> 3) <= bytes.size(), "Input buffer overrun");
-
     auto lengths = std::vector<uint8_t>(symbols.size(), 0);
     for (auto i = 0_uz; i != nr_symbols; ++i) {
         auto const symbol = symbols[i];
-        lengths[symbol] = narrow_cast<uint8_t>(get_bits(bytes, bit_offset, 3));
+        lengths[symbol] = narrow_cast<uint8_t>(reader.get(3));
     }
-    return huffman_tree<int16_t>::from_lengths(std::move(lengths));
+    return inflate_code_length_table::from_lengths(lengths);
 }
 
-inline std::vector<uint8_t> inflate_lengths(
-    std::span<std::byte const> bytes,
-    std::size_t& bit_offset,
-    std::size_t nr_symbols,
-    huffman_tree<int16_t> const& code_length_tree)
+inline std::vector<uint8_t>
+inflate_lengths(inflate_bit_reader& reader, std::size_t nr_symbols, inflate_code_length_table const& code_length_table)
 {
     auto r = std::vector<uint8_t>{};
     r.reserve(nr_symbols);
 
     auto prev_length = 0_uz;
     while (r.size() < nr_symbols) {
-        // Test only every get_symbol, the trailer is at least 32 bits (Checksum)
-        // -  7 bits maximum huffman code.
-        // -  7 bits extra length.
-        // -  7 bits rounding up to byte.
-        hi_check(((bit_offset + 21) >> 3) <= bytes.size(), "Input buffer overrun");
-        auto const symbol = code_length_tree.get_symbol(bytes, bit_offset);
+        auto const symbol = inflate_decode_symbol(reader, code_length_table);
 
         switch (symbol) {
         case 16:
             {
-                auto copy_length = get_bits(bytes, bit_offset, 2) + 3;
+                auto copy_length = reader.get(2) + 3;
                 while (copy_length--) {
                     r.push_back(static_cast<uint8_t>(prev_length));
                 }
@@ -295,7 +370,7 @@ inline std::vector<uint8_t> inflate_lengths(
             break;
         case 17:
             {
-                auto copy_length = get_bits(bytes, bit_offset, 3) + 3;
+                auto copy_length = reader.get(3) + 3;
                 while (copy_length--) {
                     r.push_back(0);
                 }
@@ -303,7 +378,7 @@ inline std::vector<uint8_t> inflate_lengths(
             break;
         case 18:
             {
-                auto copy_length = get_bits(bytes, bit_offset, 7) + 11;
+                auto copy_length = reader.get(7) + 11;
                 while (copy_length--) {
                     r.push_back(0);
                 }
@@ -314,72 +389,68 @@ inline std::vector<uint8_t> inflate_lengths(
         }
     }
 
+    hi_check(r.size() == nr_symbols, "Repeated code lengths beyond the number of symbols");
     return r;
 }
 
-inline void inflate_dynamic_block(std::span<std::byte const> bytes, std::size_t& bit_offset, std::size_t max_size, bstring& r)
+inline void inflate_dynamic_block(inflate_bit_reader& reader, std::size_t max_size, bstring& r)
 {
-    // Test all lengths, the trailer is at least 32 bits (Checksum)
-    // - 14 bits lengths
-    // -  7 bits rounding up to byte.
-    hi_check(((bit_offset + 21) >> 3) <= bytes.size(), "Input buffer overrun");
-    auto const HLIT = get_bits(bytes, bit_offset, 5);
-    auto const HDIST = get_bits(bytes, bit_offset, 5);
-    auto const HCLEN = get_bits(bytes, bit_offset, 4);
+    auto const HLIT = reader.get(5);
+    auto const HDIST = reader.get(5);
+    auto const HCLEN = reader.get(4);
 
-    auto const code_length_tree = inflate_code_lengths(bytes, bit_offset, HCLEN + 4);
+    auto const code_length_table = inflate_code_lengths(reader, HCLEN + 4);
 
-    auto const lengths = inflate_lengths(bytes, bit_offset, HLIT + HDIST + 258, code_length_tree);
+    auto const lengths = inflate_lengths(reader, HLIT + HDIST + 258, code_length_table);
     hi_check(lengths[256] != 0, "The end-of-block symbol must be in the table");
 
     auto const lengths_ptr = lengths.data();
     hi_assert_not_null(lengths_ptr);
-    auto const literal_tree = huffman_tree<int16_t>::from_lengths(lengths_ptr, HLIT + 257);
-    auto const distance_tree = huffman_tree<int16_t>::from_lengths(&lengths_ptr[HLIT + 257], HDIST + 1);
+    auto const literal_table = inflate_literal_table::from_lengths(lengths_ptr, HLIT + 257);
+    auto const distance_table = inflate_distance_table::from_lengths(&lengths_ptr[HLIT + 257], HDIST + 1);
 
-    inflate_block(bytes, bit_offset, max_size, literal_tree, distance_tree, r);
+    inflate_block(reader, max_size, literal_table, distance_table, r);
 }
 
 } // namespace detail
 
 /** Inflate compressed data using the deflate algorithm
- * `bytes` should include at least 32 bit of trailer, for the overflow check which
- * will slightly overrun the actual compressed data for performance reasons.
+ *
+ * The compressed data is read through a 64 bit buffer, and huffman codes are
+ * decoded using lookup tables.
  *
  * - gzip has a CRC32+ISIZE trailer.
- *   Since gzip has no end-of-segment indicator, we need to include the trailer
- *   in the byte array passed to inflate anyway.
  * - zlib has a 32 bit check value.
- *   Since zlib has no end-of-segment indicator, we need to include the trailer
- *   in the byte array passed to inflate anyway.
  * - png IDAT chunks include the full zlib-format, including the 32 bit check value.
+ *
+ * @param bytes The compressed data.
+ * @param[in,out] offset The byte offset of the deflate stream in @a bytes; on return
+ *                the offset of the first byte after the deflate stream.
+ * @param max_size The maximum size of the decompressed data.
+ * @return The decompressed data.
+ * @throw parse_error On invalid compressed data.
  */
 hi_export [[nodiscard]] inline bstring
 inflate(std::span<std::byte const> bytes, std::size_t& offset, std::size_t max_size = 0x0100'0000)
 {
-    std::size_t bit_offset = offset * 8;
+    auto reader = detail::inflate_bit_reader{bytes, offset};
 
     auto r = bstring{};
 
     auto BFINAL = false;
     do {
-        // Test all lengths, the trailer is at least 32 bits (Checksum)
-        // - 3 bits header
-        // - 7 bits rounding up to byte.
-        hi_check(((bit_offset + 10) >> 3) <= bytes.size(), "Input buffer overrun");
-
-        BFINAL = get_bit(bytes, bit_offset);
-        auto const BTYPE = get_bits(bytes, bit_offset, 2);
+        BFINAL = to_bool(reader.get(1));
+        auto const BTYPE = reader.get(2);
 
         switch (BTYPE) {
         case 0:
-            detail::inflate_copy_block(bytes, bit_offset, max_size, r);
+            detail::inflate_copy_block(reader, max_size, r);
             break;
         case 1:
-            detail::inflate_fixed_block(bytes, bit_offset, max_size, r);
+            detail::inflate_fixed_block(reader, max_size, r);
             break;
         case 2:
-            detail::inflate_dynamic_block(bytes, bit_offset, max_size, r);
+            detail::inflate_dynamic_block(reader, max_size, r);
             break;
         default:
             throw parse_error("Reserved block type");
@@ -387,7 +458,7 @@ inflate(std::span<std::byte const> bytes, std::size_t& offset, std::size_t max_s
 
     } while (!BFINAL);
 
-    offset = (bit_offset + 7) / 8;
+    offset = (reader.bit_offset() + 7) / 8;
     return r;
 }
 
@@ -0,0 +1,477 @@
+// Copyright Take Vos 2020-2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include "../utility/utility.hpp"
+#include "../parser/parser.hpp"
+#include "../macros.hpp"
+#include "inflate.hpp"
+#include "huffman.hpp"
+#include <span>
+#include <array>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+hi_export_module(hikogui.codec.inflate_stream);
+
+hi_export namespace hi { inline namespace v1 {
+
+/** A resumable inflate decoder.
+ *
+ * The compressed data is passed in chunks with `feed()`, and the decompressed
+ * data is pulled with `read()` into a buffer owned by the caller. Beyond the
+ * huffman tables only a 32 KiB sliding window is kept for back-references.
+ *
+ * This decodes a raw deflate stream; the zlib or gzip headers and trailers
+ * must be handled by the caller.
+ *
+ * Example:
+ * ```
+ * auto stream = inflate_stream{};
+ * while (not stream.done()) {
+ *     if (stream.need_input()) {
+ *         stream.feed(next_chunk());
+ *     }
+ *     consume(buffer.first(stream.read(buffer)));
+ * }
+ * ```
+ */
+hi_export class inflate_stream {
+public:
+    /** The size of the sliding window, the maximum distance of a back-reference.
+     */
+    constexpr static std::size_t window_size = 32768;
+
+    inflate_stream() : _window(window_size) {}
+
+    inflate_stream(inflate_stream const&) = delete;
+    inflate_stream(inflate_stream&&) noexcept = default;
+    inflate_stream& operator=(inflate_stream const&) = delete;
+    inflate_stream& operator=(inflate_stream&&) noexcept = default;
+
+    /** Check if the next chunk of compressed data is needed to continue.
+     */
+    [[nodiscard]] bool need_input() const noexcept
+    {
+        return _need_input;
+    }
+
+    /** Check if the end of the last block has been decoded.
+     */
+    [[nodiscard]] bool done() const noexcept
+    {
+        return _state == state_type::done;
+    }
+
+    /** The total number of bytes decompressed.
+     */
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return _size;
+    }
+
+    /** Pass the next chunk of compressed data.
+     *
+     * The data must remain valid until `need_input()` returns true again, or
+     * `done()` returns true.
+     *
+     * @pre `need_input()` must be true.
+     * @param bytes The next chunk of compressed data.
+     */
+    void feed(std::span<std::byte const> bytes) noexcept
+    {
+        hi_axiom(_need_input);
+        _reader.set_input(bytes);
+        _need_input = bytes.empty();
+    }
+
+    /** Decompress data.
+     *
+     * @param output The buffer to write the decompressed data to.
+     * @return The number of bytes written; less than the size of @a output
+     *         when `need_input()` or `done()` returns true.
+     * @throw parse_error On invalid compressed data.
+     */
+    [[nodiscard]] std::size_t read(std::span<std::byte> output)
+    {
+        auto n = 0_uz;
+        while (n != output.size() and not _need_input) {
+            switch (_state) {
+            case state_type::block_header:
+                read_block_header();
+                break;
+            case state_type::stored_header:
+                read_stored_header();
+                break;
+            case state_type::stored_data:
+                read_stored_data(output, n);
+                break;
+            case state_type::dynamic_header:
+                read_dynamic_header();
+                break;
+            case state_type::code_lengths:
+                read_code_lengths();
+                break;
+            case state_type::lengths:
+                read_lengths();
+                break;
+            case state_type::huffman_data:
+                read_huffman_data(output, n);
+                break;
+            case state_type::match:
+                read_match(output, n);
+                break;
+            case state_type::done:
+                return n;
+            default:
+                hi_no_default();
+            }
+        }
+        return n;
+    }
+
+private:
+    enum class state_type : uint8_t {
+        block_header,
+        stored_header,
+        stored_data,
+        dynamic_header,
+        code_lengths,
+        lengths,
+        huffman_data,
+        match,
+        done
+    };
+
+    constexpr static std::size_t window_mask = window_size - 1;
+
+    /** The symbols in the order their code length is stored.
+     */
+    constexpr static auto code_length_symbols =
+        std::array<uint8_t, 19>{16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+    detail::inflate_bit_reader _reader;
+    state_type _state = state_type::block_header;
+    bool _need_input = true;
+    bool _final_block = false;
+
+    /** The last 32 KiB of decompressed data.
+     */
+    std::vector<std::byte> _window;
+    std::size_t _size = 0;
+
+    std::size_t _stored_size = 0;
+    std::size_t _match_length = 0;
+    std::size_t _match_distance = 0;
+
+    std::size_t _nr_literal_symbols = 0;
+    std::size_t _nr_distance_symbols = 0;
+    std::size_t _nr_code_length_symbols = 0;
+    std::size_t _code_length_index = 0;
+    std::vector<uint8_t> _lengths;
+    detail::inflate_code_length_table _code_length_table;
+
+    /** The tables of the current dynamic block.
+     */
+    detail::inflate_literal_table _literal_table;
+    detail::inflate_distance_table _distance_table;
+
+    /** The current block uses the fixed tables instead of the dynamic tables.
+     */
+    bool _fixed_tables = false;
+
+    [[nodiscard]] detail::inflate_literal_table const& literal_table() const noexcept
+    {
+        return _fixed_tables ? detail::deflate_fixed_literal_table : _literal_table;
+    }
+
+    [[nodiscard]] detail::inflate_distance_table const& distance_table() const noexcept
+    {
+        return _fixed_tables ? detail::deflate_fixed_distance_table : _distance_table;
+    }
+
+    /** Make sure there are enough bits in the buffer.
+     *
+     * @return True if there are at least @a nr_bits in the buffer.
+     */
+    [[nodiscard]] bool has_bits(std::size_t nr_bits) noexcept
+    {
+        if (_reader.size() < nr_bits) {
+            _reader.refill();
+        }
+        return _reader.size() >= nr_bits;
+    }
+
+    /** Decode a symbol, if there are enough bits in the buffer.
+     *
+     * @param table The table to decode with.
+     * @param[out] symbol The decoded symbol.
+     * @return True if the symbol was decoded, false if more input is needed.
+     * @throw parse_error When the code is not in the table.
+     */
+    template<std::size_t PrimaryBits>
+    [[nodiscard]] bool try_decode_symbol(huffman_table<PrimaryBits> const& table, std::size_t& symbol)
+    {
+        _reader.refill();
+
+        auto const entry = table.decode(_reader.peek());
+        if (entry.length == 0) {
+            // With fewer bits than the longest code the zero padding may
+            // select an unused code.
+            if (_reader.size() < huffman_table<PrimaryBits>::max_code_length) {
+                return false;
+            }
+            throw parse_error("Code not in huffman table.");
+        }
+        if (entry.length > _reader.size()) {
+            return false;
+        }
+
+        _reader.consume(entry.length);
+        symbol = entry.value;
+        return true;
+    }
+
+    /** Read extra bits, if there are enough bits in the buffer.
+     */
+    [[nodiscard]] bool try_get(std::size_t nr_bits, std::size_t& value) noexcept
+    {
+        if (not has_bits(nr_bits)) {
+            return false;
+        }
+        value = _reader.get(nr_bits);
+        return true;
+    }
+
+    void put(std::byte value, std::span<std::byte> output, std::size_t& n) noexcept
+    {
+        _window[_size++ & window_mask] = value;
+        output[n++] = value;
+    }
+
+    void end_of_block() noexcept
+    {
+        _state = _final_block ? state_type::done : state_type::block_header;
+    }
+
+    void read_block_header()
+    {
+        if (not has_bits(3)) {
+            _need_input = true;
+            return;
+        }
+
+        _final_block = to_bool(_reader.get(1));
+        switch (_reader.get(2)) {
+        case 0:
+            _state = state_type::stored_header;
+            break;
+        case 1:
+            _fixed_tables = true;
+            _state = state_type::huffman_data;
+            break;
+        case 2:
+            _state = state_type::dynamic_header;
+            break;
+        default:
+            throw parse_error("Reserved block type");
+        }
+    }
+
+    void read_stored_header()
+    {
+        _reader.align_to_byte();
+        if (not has_bits(32)) {
+            _need_input = true;
+            return;
+        }
+
+        auto const LEN = _reader.get(16);
+        auto const NLEN = _reader.get(16);
+        hi_check(LEN == (~NLEN & 0xffff), "Stored block LEN does not match NLEN");
+
+        _stored_size = LEN;
+        _state = state_type::stored_data;
+    }
+
+    void read_stored_data(std::span<std::byte> output, std::size_t& n)
+    {
+        while (_stored_size != 0 and n != output.size()) {
+            if (not has_bits(8)) {
+                _need_input = true;
+                return;
+            }
+
+            put(static_cast<std::byte>(_reader.get(8)), output, n);
+            --_stored_size;
+        }
+
+        if (_stored_size == 0) {
+            end_of_block();
+        }
+    }
+
+    void read_dynamic_header()
+    {
+        if (not has_bits(14)) {
+            _need_input = true;
+            return;
+        }
+
+        _nr_literal_symbols = _reader.get(5) + 257;
+        _nr_distance_symbols = _reader.get(5) + 1;
+        _nr_code_length_symbols = _reader.get(4) + 4;
+
+        _lengths.assign(code_length_symbols.size(), 0);
+        _code_length_index = 0;
+        _state = state_type::code_lengths;
+    }
+
+    void read_code_lengths()
+    {
+        for (; _code_length_index != _nr_code_length_symbols; ++_code_length_index) {
+            if (not has_bits(3)) {
+                _need_input = true;
+                return;
+            }
+            _lengths[code_length_symbols[_code_length_index]] = narrow_cast<uint8_t>(_reader.get(3));
+        }
+        _code_length_table = detail::inflate_code_length_table::from_lengths(_lengths);
+
+        _lengths.clear();
+        _state = state_type::lengths;
+    }
+
+    void read_lengths()
+    {
+        auto const nr_symbols = _nr_literal_symbols + _nr_distance_symbols;
+
+        while (_lengths.size() < nr_symbols) {
+            // Refill before taking the snapshot, so that restoring it does not
+            // un-read input. Either the buffer now holds enough bits for a
+            // whole code, or the input is exhausted.
+            _reader.refill();
+            auto const saved_reader = _reader;
+
+            auto symbol = 0_uz;
+            auto extra = 0_uz;
+            if (not try_decode_symbol(_code_length_table, symbol)) {
+                _need_input = true;
+                return;
+            }
+
+            switch (symbol) {
+            case 16:
+                if (not try_get(2, extra)) {
+                    _reader = saved_reader;
+                    _need_input = true;
+                    return;
+                }
+                hi_check(not _lengths.empty(), "Repeat of a code length without a previous length");
+                {
+                    auto const prev_length = _lengths.back();
+                    _lengths.insert(_lengths.end(), extra + 3, prev_length);
+                }
+                break;
+            case 17:
+                if (not try_get(3, extra)) {
+                    _reader = saved_reader;
+                    _need_input = true;
+                    return;
+                }
+                _lengths.insert(_lengths.end(), extra + 3, uint8_t{0});
+                break;
+            case 18:
+                if (not try_get(7, extra)) {
+                    _reader = saved_reader;
+                    _need_input = true;
+                    return;
+                }
+                _lengths.insert(_lengths.end(), extra + 11, uint8_t{0});
+                break;
+            default:
+                _lengths.push_back(narrow_cast<uint8_t>(symbol));
+            }
+        }
+
+        hi_check(_lengths.size() == nr_symbols, "Repeated code lengths beyond the number of symbols");
+        hi_check(_lengths[256] != 0, "The end-of-block symbol must be in the table");
+
+        _literal_table = detail::inflate_literal_table::from_lengths(_lengths.data(), _nr_literal_symbols);
+        _distance_table = detail::inflate_distance_table::from_lengths(_lengths.data() + _nr_literal_symbols, _nr_distance_symbols);
+        _fixed_tables = false;
+        _state = state_type::huffman_data;
+    }
+
+    void read_huffman_data(std::span<std::byte> output, std::size_t& n)
+    {
+        while (n != output.size()) {
+            // A literal or a length/distance pair is decoded as a whole, or
+            // not at all when there is not enough input.
+            _reader.refill();
+            auto const saved_reader = _reader;
+
+            auto literal_symbol = 0_uz;
+            if (not try_decode_symbol(literal_table(), literal_symbol)) {
+                _need_input = true;
+                return;
+            }
+
+            if (literal_symbol <= 255) {
+                put(static_cast<std::byte>(literal_symbol), output, n);
+                continue;
+
+            } else if (literal_symbol == 256) {
+                end_of_block();
+                return;
+
+            } else if (literal_symbol > 285) {
+                throw parse_error(std::format("Literal/Length symbol out of range {}", literal_symbol));
+            }
+
+            auto const length_i = literal_symbol - 257;
+            auto length_extra = 0_uz;
+            auto distance_symbol = 0_uz;
+            if (not try_get(detail::inflate_length_extra_bits[length_i], length_extra) or
+                not try_decode_symbol(distance_table(), distance_symbol)) {
+                _reader = saved_reader;
+                _need_input = true;
+                return;
+            }
+
+            if (distance_symbol > 29) {
+                throw parse_error(std::format("Distance symbol out of range {}", distance_symbol));
+            }
+
+            auto distance_extra = 0_uz;
+            if (not try_get(detail::inflate_distance_extra_bits[distance_symbol], distance_extra)) {
+                _reader = saved_reader;
+                _need_input = true;
+                return;
+            }
+
+            _match_length = detail::inflate_length_base[length_i] + length_extra;
+            _match_distance = detail::inflate_distance_base[distance_symbol] + distance_extra;
+            hi_check(_match_distance <= _size, "Distance beyond start of decompressed data");
+
+            _state = state_type::match;
+            return;
+        }
+    }
+
+    void read_match(std::span<std::byte> output, std::size_t& n) noexcept
+    {
+        for (; _match_length != 0 and n != output.size(); --_match_length) {
+            put(_window[(_size - _match_distance) & window_mask], output, n);
+        }
+
+        if (_match_length == 0) {
+            _state = state_type::huffman_data;
+        }
+    }
+};
+
+}} // namespace hi::v1
@@ -0,0 +1,90 @@
+// Copyright Take Vos 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include "inflate_stream.hpp"
+#include "../file/file.hpp"
+#include "../container/container.hpp"
+#include "../path/path.hpp"
+#include "../utility/utility.hpp"
+#include <hikotest/hikotest.hpp>
+#include <algorithm>
+#include <array>
+#include <string>
+
+TEST_SUITE(inflate_stream_suite) {
+
+/** Decompress a gzip file by passing small chunks and reading into a small buffer.
+ */
+static hi::bstring inflate_in_chunks(std::filesystem::path const& path, std::size_t chunk_size)
+{
+    auto const view = hi::file_view{path};
+    auto const bytes = as_span<std::byte const>(view);
+
+    // Skip the gzip header, these files only have the optional file name.
+    auto offset = std::size_t{10};
+    if (hi::to_bool(std::to_integer<uint8_t>(bytes[3]) & 0x08)) {
+        while (bytes[offset++] != std::byte{0}) {}
+    }
+
+    auto r = hi::bstring{};
+    auto buffer = std::array<std::byte, 100>{};
+    auto stream = hi::inflate_stream{};
+    while (not stream.done()) {
+        if (stream.need_input()) {
+            REQUIRE(offset != bytes.size());
+            auto const n = std::min(chunk_size, bytes.size() - offset);
+            stream.feed(bytes.subspan(offset, n));
+            offset += n;
+        }
+
+        auto const n = stream.read(buffer);
+        r.append(buffer.data(), n);
+    }
+
+    REQUIRE(stream.size() == r.size());
+    return r;
+}
+
+static void check_inflate_in_chunks(std::string const& name, std::size_t chunk_size)
+{
+    auto const decompressed = inflate_in_chunks(hi::library_test_data_dir() / (name + ".gz"), chunk_size);
+
+    auto const original = hi::file_view{hi::library_test_data_dir() / name};
+    auto const original_bytes = as_bstring_view(original);
+
+    REQUIRE(decompressed.size() == original_bytes.size());
+    for (size_t i = 0; i != decompressed.size(); ++i) {
+        REQUIRE(decompressed[i] == original_bytes[i]);
+    }
+}
+
+TEST_CASE(inflate_empty)
+{
+    check_inflate_in_chunks("gzip_test1.bin", 7);
+}
+
+TEST_CASE(inflate_single_a)
+{
+    check_inflate_in_chunks("gzip_test2.bin", 7);
+}
+
+TEST_CASE(inflate_text)
+{
+    check_inflate_in_chunks("gzip_test3.bin", 1);
+    check_inflate_in_chunks("gzip_test3.bin", 7);
+}
+
+TEST_CASE(inflate_caterbury_html)
+{
+    check_inflate_in_chunks("gzip_test4.bin", 1);
+    check_inflate_in_chunks("gzip_test4.bin", 4096);
+}
+
+TEST_CASE(inflate_sum)
+{
+    check_inflate_in_chunks("gzip_test7.bin", 7);
+    check_inflate_in_chunks("gzip_test7.bin", 4096);
+}
+
+};
@@ -10,15 +10,20 @@
 #include "../geometry/geometry.hpp"
 #include "../container/container.hpp"
 #include "../parser/parser.hpp"
+#include "../dispatch/dispatch.hpp"
 #include "../macros.hpp"
 #include "zlib.hpp"
 #include <span>
 #include <vector>
 #include <cstddef>
 #include <cstdint>
-#include <numeric>
+#include <cstring>
+#include <array>
 #include <filesystem>
 #include <memory>
+#include <thread>
+#include <atomic>
+#include <algorithm>
 
 hi_export_module(hikogui.codec.png);
 
@@ -49,26 +54,122 @@ public:
 
     void decode_image(pixmap_span<sfloat_rgba16> image) const
     {
+        // The image data is decompressed one line at a time, so that only the
+        // current and previous line are kept in memory.
+        auto stream = zlib_stream{};
+        auto chunk_it = _idat_chunk_data.cbegin();
+
         // There is a filter selection byte in front of every line.
-        auto const image_data_size = _stride * _height;
+        auto line = std::vector<uint8_t>(_stride, uint8_t{0});
+        auto prev_line = std::vector<uint8_t>(_stride, uint8_t{0});
 
-        auto image_data = decompress_IDATs(image_data_size);
-        hi_check(ssize(image_data) == image_data_size, "Uncompressed image data has incorrect size.");
+        for (int y = 0; y != _height; ++y) {
+            read_line(stream, chunk_it, line);
+            unfilter_line(line, std::span(prev_line).subspan(1, _bytes_per_line));
 
-        unfilter_lines(image_data);
+            auto const inv_y = _height - y - 1;
+            data_to_image_line(std::as_bytes(std::span(line).subspan(1, _bytes_per_line)), image[inv_y]);
 
-        data_to_image(image_data, image);
+            std::swap(line, prev_line);
+        }
     }
 
-    [[nodiscard]] static pixmap<sfloat_rgba16> load(std::filesystem::path const& path)
+    /** Decode the image using multiple threads.
+     *
+     * The calling thread decompresses and unfilters bands of lines, while
+     * the workers of the global thread pool convert the previous bands to
+     * pixels. Small images are decoded on the calling thread.
+     *
+     * @param image The image to decode into.
+     * @param nr_threads The number of bands that are converted at the same time;
+     *                   zero for the number of hardware threads.
+     */
+    void decode_image(pixmap_span<sfloat_rgba16> image, std::size_t nr_threads) const
+    {
+        if (nr_threads == 0) {
+            nr_threads = std::max(std::size_t{1}, narrow_cast<std::size_t>(std::thread::hardware_concurrency()));
+        }
+
+        auto const height = narrow_cast<std::size_t>(_height);
+        auto const stride = narrow_cast<std::size_t>(_stride);
+
+        // A band of about 64 kByte of image data amortizes the cost of handing
+        // it over to another thread.
+        auto const band_height = std::max(std::size_t{1}, std::size_t{0x10000} / stride);
+        if (nr_threads == 1 or height <= band_height) {
+            return decode_image(image);
+        }
+
+        auto stream = zlib_stream{};
+        auto chunk_it = _idat_chunk_data.cbegin();
+        auto prev_line = std::vector<uint8_t>(stride, uint8_t{0});
+
+        // A job may still be queued after the calling thread converted its band
+        // itself, so the bands are shared with the jobs.
+        auto bands = std::make_shared<std::vector<band_type>>(nr_threads);
+
+        // Also when an exception is thrown, the image must not be written
+        // to after this function returns.
+        auto const d = defer([&] {
+            for (auto& band : *bands) {
+                wait_for_band(band, image);
+            }
+        });
+
+        auto band_i = 0_uz;
+        for (auto y = 0_uz; y < height; y += band_height, band_i = (band_i + 1) % nr_threads) {
+            auto& band = (*bands)[band_i];
+            wait_for_band(band, image);
+
+            band.y = y;
+            band.nr_lines = std::min(band_height, height - y);
+            band.data.resize(band.nr_lines * stride);
+
+            for (auto i = 0_uz; i != band.nr_lines; ++i) {
+                auto const line = std::span(band.data).subspan(i * stride, stride);
+                auto const prev = i == 0 ? std::span<uint8_t const>(prev_line) :
+                                           std::span<uint8_t const>(band.data).subspan((i - 1) * stride, stride);
+
+                read_line(stream, chunk_it, line);
+                unfilter_line(line, prev.subspan(1, _bytes_per_line));
+            }
+            std::ranges::copy(std::span(band.data).last(stride), prev_line.begin());
+
+            band.state.store(band_state::queued, std::memory_order::release);
+            thread_pool::global().submit([this, bands, &band, image] {
+                if (claim_band(band)) {
+                    convert_band(band, image);
+                }
+            });
+        }
+    }
+
+    /** Load a PNG image from a file.
+     *
+     * @param path The path to the PNG file.
+     * @param nr_threads The number of bands that are converted at the same time;
+     *                   zero for the number of hardware threads.
+     */
+    [[nodiscard]] static pixmap<sfloat_rgba16> load(std::filesystem::path const& path, std::size_t nr_threads = 1)
     {
         auto const png_data = png(file_view{path});
         auto image = pixmap<sfloat_rgba16>{png_data.width(), png_data.height()};
-        png_data.decode_image(image);
+        png_data.decode_image(image, nr_threads);
         return image;
     }
 
 private:
+    enum class band_state : uint8_t { idle, queued, converting };
+
+    /** A band of unfiltered lines, to be converted to pixels.
+     */
+    struct band_type {
+        std::vector<uint8_t> data;
+        std::size_t y = 0;
+        std::size_t nr_lines = 0;
+        std::atomic<band_state> state = band_state::idle;
+    };
+
     struct PNGHeader {
         uint8_t signature[8];
     };
@@ -156,34 +257,40 @@ private:
         throw parse_error("string is not null terminated.");
     }
 
-    static uint8_t paeth_predictor(uint8_t _a, uint8_t _b, uint8_t _c) noexcept
+    /** Get a big-endian sample of one or two bytes.
+     */
+    template<int BytesPerSample>
+    [[nodiscard]] hi_force_inline static uint16_t get_sample(uint8_t const *ptr) noexcept
     {
-        auto const a = static_cast<int>(_a);
-        auto const b = static_cast<int>(_b);
-        auto const c = static_cast<int>(_c);
-
-        auto const p = a + b - c;
-        auto const pa = std::abs(p - a);
-        auto const pb = std::abs(p - b);
-        auto const pc = std::abs(p - c);
-
-        if (pa <= pb && pa <= pc) {
-            return narrow_cast<uint8_t>(a);
-        } else if (pb <= pc) {
-            return narrow_cast<uint8_t>(b);
+        if constexpr (BytesPerSample == 2) {
+            return static_cast<uint16_t>((ptr[0] << 8) | ptr[1]);
         } else {
-            return narrow_cast<uint8_t>(c);
+            return ptr[0];
         }
     }
 
-    static uint16_t get_sample(std::span<std::byte const> bytes, ssize_t& offset, bool two_bytes)
+    /** Load the bytes of a single pixel, each byte in a 16 bit element.
+     */
+    template<int BytesPerPixel>
+    [[nodiscard]] hi_force_inline static i16x8 load_pixel(uint8_t const *ptr) noexcept
+    {
+        static_assert(BytesPerPixel <= 8);
+
+        auto r = std::array<uint8_t, 8>{};
+        std::memcpy(r.data(), ptr, BytesPerPixel);
+        return i16x8(r);
+    }
+
+    /** Store the low byte of each 16 bit element of a single pixel.
+     */
+    template<int BytesPerPixel>
+    hi_force_inline static void store_pixel(uint8_t *ptr, i16x8 value) noexcept
     {
-        uint16_t value = static_cast<uint8_t>(bytes[offset++]);
-        if (two_bytes) {
-            value <<= 8;
-            value |= static_cast<uint8_t>(bytes[offset++]);
+        static_assert(BytesPerPixel <= 8);
+
+        for (auto i = 0; i != BytesPerPixel; ++i) {
+            ptr[i] = static_cast<uint8_t>(value[i]);
         }
-        return value;
     }
 
     void read_header(std::span<std::byte const> bytes, std::size_t& offset)
@@ -392,152 +499,251 @@ private:
         }
     }
 
-    [[nodiscard]] bstring decompress_IDATs(std::size_t image_data_size) const
+    /** Decompress the next line from the IDAT chunks.
+     *
+     * @param stream The decompression stream of the image data.
+     * @param chunk_it The next IDAT chunk to pass to the stream.
+     * @param[out] line The line including its filter selection byte.
+     */
+    void read_line(
+        zlib_stream& stream,
+        std::vector<std::span<std::byte const>>::const_iterator& chunk_it,
+        std::span<uint8_t> line) const
     {
-        if (ssize(_idat_chunk_data) == 1) {
-            return zlib_decompress(_idat_chunk_data[0], image_data_size);
-        } else {
-            // Merge all idat chunks together.
-            auto const compressed_data_size =
-                std::accumulate(_idat_chunk_data.cbegin(), _idat_chunk_data.cend(), ssize_t{0}, [](auto const& a, auto const& b) {
-                    return a + ssize(b);
-                });
-
-            bstring compressed_data;
-            compressed_data.reserve(compressed_data_size);
-            for (auto const chunk_data : _idat_chunk_data) {
-                std::copy(chunk_data.begin(), chunk_data.end(), std::back_inserter(compressed_data));
+        auto const bytes = std::as_writable_bytes(line);
+
+        auto n = 0_uz;
+        while (n != bytes.size()) {
+            hi_check(not stream.done(), "Uncompressed image data is too short.");
+
+            if (stream.need_input()) {
+                hi_check(chunk_it != _idat_chunk_data.cend(), "Compressed image data is truncated.");
+                stream.feed(*chunk_it++);
             }
 
-            return zlib_decompress(compressed_data, image_data_size);
+            n += stream.read(bytes.subspan(n));
         }
     }
 
-    void unfilter_lines(bstring& image_data) const
+    void unfilter_line(std::span<uint8_t> line, std::span<uint8_t const> prev_line) const
     {
-        auto const image_bytes = std::span(reinterpret_cast<uint8_t *>(image_data.data()), image_data.size());
-        auto zero_line = std::vector<uint8_t>(_bytes_per_line, uint8_t{0});
-
-        auto prev_line = std::span(zero_line.data(), zero_line.size());
-        for (auto y = 0_uz; y != _height; ++y) {
-            auto const line = image_bytes.subspan(y * _stride, _stride);
-            unfilter_line(line, prev_line);
-            prev_line = line.subspan(1, _bytes_per_line);
+        switch (_bytes_per_pixel) {
+        case 1:
+            return unfilter_line<1>(line, prev_line);
+        case 2:
+            return unfilter_line<2>(line, prev_line);
+        case 3:
+            return unfilter_line<3>(line, prev_line);
+        case 4:
+            return unfilter_line<4>(line, prev_line);
+        case 6:
+            return unfilter_line<6>(line, prev_line);
+        case 8:
+            return unfilter_line<8>(line, prev_line);
+        default:
+            hi_no_default();
         }
     }
 
+    template<int BytesPerPixel>
     void unfilter_line(std::span<uint8_t> line, std::span<uint8_t const> prev_line) const
     {
         switch (line[0]) {
         case 0:
             return;
         case 1:
-            return unfilter_line_sub(line.subspan(1, _bytes_per_line), prev_line);
+            return unfilter_line_sub<BytesPerPixel>(line.subspan(1, _bytes_per_line));
         case 2:
             return unfilter_line_up(line.subspan(1, _bytes_per_line), prev_line);
         case 3:
-            return unfilter_line_average(line.subspan(1, _bytes_per_line), prev_line);
+            return unfilter_line_average<BytesPerPixel>(line.subspan(1, _bytes_per_line), prev_line);
         case 4:
-            return unfilter_line_paeth(line.subspan(1, _bytes_per_line), prev_line);
+            return unfilter_line_paeth<BytesPerPixel>(line.subspan(1, _bytes_per_line), prev_line);
         default:
             throw parse_error("Unknown line-filter type");
         }
     }
 
-    void unfilter_line_sub(std::span<uint8_t> line, std::span<uint8_t const> prev_line) const noexcept
+    /** Unfilter a line with the Sub filter.
+     *
+     * The Sub, Average and Paeth filters depend on the unfiltered pixel to the
+     * left, so these are vectorized over the bytes of a single pixel.
+     */
+    template<int BytesPerPixel>
+    static void unfilter_line_sub(std::span<uint8_t> line) noexcept
     {
-        for (int i = 0; i != _bytes_per_line; ++i) {
-            auto const j = i - _bytes_per_pixel;
+        hi_axiom(line.size() % BytesPerPixel == 0);
+
+        auto const byte_mask = i16x8::broadcast(0xff);
 
-            uint8_t prev_raw = j >= 0 ? line[j] : 0;
-            line[i] += prev_raw;
+        auto left = i16x8{};
+        for (auto i = 0_uz; i != line.size(); i += BytesPerPixel) {
+            left = (load_pixel<BytesPerPixel>(line.data() + i) + left) & byte_mask;
+            store_pixel<BytesPerPixel>(line.data() + i, left);
         }
     }
 
-    void unfilter_line_up(std::span<uint8_t> line, std::span<uint8_t const> prev_line) const noexcept
+    static void unfilter_line_up(std::span<uint8_t> line, std::span<uint8_t const> prev_line) noexcept
     {
-        for (int i = 0; i != _bytes_per_line; ++i) {
+        hi_axiom(line.size() == prev_line.size());
+
+        // There is no dependency between bytes, so this loop is vectorized by the compiler.
+        for (auto i = 0_uz; i != line.size(); ++i) {
             line[i] += prev_line[i];
         }
     }
 
-    void unfilter_line_average(std::span<uint8_t> line, std::span<uint8_t const> prev_line) const noexcept
+    template<int BytesPerPixel>
+    static void unfilter_line_average(std::span<uint8_t> line, std::span<uint8_t const> prev_line) noexcept
     {
-        for (int i = 0; i != _bytes_per_line; ++i) {
-            auto const j = i - _bytes_per_pixel;
+        hi_axiom(line.size() == prev_line.size());
+        hi_axiom(line.size() % BytesPerPixel == 0);
 
-            uint8_t prev_raw = j >= 0 ? line[j] : 0;
-            line[i] += (prev_raw + prev_line[i]) / 2;
+        auto const byte_mask = i16x8::broadcast(0xff);
+
+        auto left = i16x8{};
+        for (auto i = 0_uz; i != line.size(); i += BytesPerPixel) {
+            auto const up = load_pixel<BytesPerPixel>(prev_line.data() + i);
+            left = (load_pixel<BytesPerPixel>(line.data() + i) + ((left + up) >> 1)) & byte_mask;
+            store_pixel<BytesPerPixel>(line.data() + i, left);
         }
     }
 
-    void unfilter_line_paeth(std::span<uint8_t> line, std::span<uint8_t const> prev_line) const noexcept
+    template<int BytesPerPixel>
+    static void unfilter_line_paeth(std::span<uint8_t> line, std::span<uint8_t const> prev_line) noexcept
     {
-        for (int i = 0; i != _bytes_per_line; ++i) {
-            auto const j = i - _bytes_per_pixel;
-
-            uint8_t const up = prev_line[i];
-            uint8_t const left = j >= 0 ? line[j] : 0;
-            uint8_t const left_up = j >= 0 ? prev_line[j] : 0;
-            line[i] += paeth_predictor(left, up, left_up);
+        hi_axiom(line.size() == prev_line.size());
+        hi_axiom(line.size() % BytesPerPixel == 0);
+
+        auto const byte_mask = i16x8::broadcast(0xff);
+
+        auto left = i16x8{};
+        auto left_up = i16x8{};
+        for (auto i = 0_uz; i != line.size(); i += BytesPerPixel) {
+            auto const up = load_pixel<BytesPerPixel>(prev_line.data() + i);
+
+            // The distances from the estimate `left + up - left_up` to each neighbour.
+            auto const left_distance = abs(up - left_up);
+            auto const up_distance = abs(left - left_up);
+            auto const left_up_distance = abs(left + up - left_up - left_up);
+            auto const min_distance = min(left_distance, min(up_distance, left_up_distance));
+
+            // On a tie prefer left, then up, then left-up.
+            auto const use_left = left_distance == min_distance;
+            auto const use_up = up_distance == min_distance;
+            auto predictor = (up & use_up) | andnot(use_up, left_up);
+            predictor = (left & use_left) | andnot(use_left, predictor);
+
+            left = (load_pixel<BytesPerPixel>(line.data() + i) + predictor) & byte_mask;
+            store_pixel<BytesPerPixel>(line.data() + i, left);
+            left_up = up;
         }
     }
 
-    void data_to_image(bstring bytes, pixmap_span<sfloat_rgba16> image) const noexcept
+    /** Take a queued band for conversion.
+     *
+     * @return true if the band was queued and the caller must convert it.
+     */
+    [[nodiscard]] static bool claim_band(band_type& band) noexcept
     {
-        auto bytes_span = std::span(bytes);
+        auto expected = band_state::queued;
+        return band.state.compare_exchange_strong(expected, band_state::converting, std::memory_order::acquire);
+    }
 
-        for (int y = 0; y != _height; ++y) {
-            int inv_y = _height - y - 1;
+    void convert_band(band_type& band, pixmap_span<sfloat_rgba16> image) const noexcept
+    {
+        auto const height = narrow_cast<std::size_t>(_height);
+        auto const stride = narrow_cast<std::size_t>(_stride);
 
-            auto bytes_line = bytes_span.subspan(inv_y * _stride + 1, _bytes_per_line);
-            auto pixel_line = image[y];
-            data_to_image_line(bytes_line, pixel_line);
+        for (auto i = 0_uz; i != band.nr_lines; ++i) {
+            auto const line = std::span(band.data).subspan(i * stride + 1, _bytes_per_line);
+            auto const inv_y = height - (band.y + i) - 1;
+            data_to_image_line(std::as_bytes(line), image[inv_y]);
         }
+
+        band.state.store(band_state::idle, std::memory_order::release);
+        band.state.notify_all();
     }
 
-    void data_to_image_line(std::span<std::byte const> bytes, std::span<sfloat_rgba16> line) const noexcept
+    /** Wait until the band is converted.
+     *
+     * A band that is still queued is converted on the calling thread, so that
+     * this does not deadlock when called from a worker of the thread pool.
+     */
+    void wait_for_band(band_type& band, pixmap_span<sfloat_rgba16> image) const noexcept
     {
-        auto const alpha_mul = _bit_depth == 16 ? 1.0f / 65535.0f : 1.0f / 255.0f;
-        for (int x = 0; x != _width; ++x) {
-            auto const value = extract_pixel_from_line(bytes, x);
-
-            auto const linear_RGB =
-                f32x4{_transfer_function[value.x()], _transfer_function[value.y()], _transfer_function[value.z()], 1.0f};
-
-            auto const linear_sRGB_color = _color_to_sRGB * linear_RGB;
-            auto const alpha = static_cast<float>(value.w()) * alpha_mul;
+        if (claim_band(band)) {
+            return convert_band(band, image);
+        }
 
-            // pre-multiply the alpha for use in texture-maps.
-            line[x] = linear_sRGB_color * f32x4::broadcast(alpha);
+        while (band.state.load(std::memory_order::acquire) == band_state::converting) {
+            band.state.wait(band_state::converting, std::memory_order::acquire);
         }
     }
 
-    u16x4 extract_pixel_from_line(std::span<std::byte const> bytes, int x) const noexcept
+    void data_to_image_line(std::span<std::byte const> bytes, std::span<sfloat_rgba16> line) const noexcept
     {
         hi_axiom(_bit_depth == 8 or _bit_depth == 16);
         hi_axiom(not _is_palletted);
 
-        uint16_t r = 0;
-        uint16_t g = 0;
-        uint16_t b = 0;
-        uint16_t a = 0;
-
-        ssize_t offset = x * _bytes_per_pixel;
-        if (_is_color) {
-            r = get_sample(bytes, offset, _bit_depth == 16);
-            g = get_sample(bytes, offset, _bit_depth == 16);
-            b = get_sample(bytes, offset, _bit_depth == 16);
-        } else {
-            r = g = b = get_sample(bytes, offset, _bit_depth == 16);
-        }
-        if (_has_alpha) {
-            a = get_sample(bytes, offset, _bit_depth == 16);
+        if (_bit_depth == 16) {
+            if (_is_color) {
+                return _has_alpha ? data_to_image_line<2, true, true>(bytes, line) : data_to_image_line<2, true, false>(bytes, line);
+            } else {
+                return _has_alpha ? data_to_image_line<2, false, true>(bytes, line) : data_to_image_line<2, false, false>(bytes, line);
+            }
         } else {
-            a = (_bit_depth == 16) ? 65535 : 255;
+            if (_is_color) {
+                return _has_alpha ? data_to_image_line<1, true, true>(bytes, line) : data_to_image_line<1, true, false>(bytes, line);
+            } else {
+                return _has_alpha ? data_to_image_line<1, false, true>(bytes, line) : data_to_image_line<1, false, false>(bytes, line);
+            }
         }
+    }
+
+    /** Convert a line of samples to linear, pre-multiplied sRGB.
+     *
+     * The pixel format is a template parameter so that the inner loop has no
+     * branches on the format of the samples.
+     */
+    template<int BytesPerSample, bool IsColor, bool HasAlpha>
+    void data_to_image_line(std::span<std::byte const> bytes, std::span<sfloat_rgba16> line) const noexcept
+    {
+        constexpr auto samples_per_pixel = (IsColor ? 3 : 1) + (HasAlpha ? 1 : 0);
+        constexpr auto bytes_per_pixel = samples_per_pixel * BytesPerSample;
+        constexpr auto alpha_mul = BytesPerSample == 2 ? 1.0f / 65535.0f : 1.0f / 255.0f;
+
+        auto const width = narrow_cast<std::size_t>(_width);
+        hi_axiom(line.size() >= width);
+        hi_axiom(bytes.size() >= width * bytes_per_pixel);
+
+        auto const *transfer_function = _transfer_function.data();
+        auto const *ptr = reinterpret_cast<uint8_t const *>(bytes.data());
+        for (auto x = 0_uz; x != width; ++x, ptr += bytes_per_pixel) {
+            auto linear_RGB = f32x4{};
+            if constexpr (IsColor) {
+                linear_RGB = f32x4{
+                    transfer_function[get_sample<BytesPerSample>(ptr)],
+                    transfer_function[get_sample<BytesPerSample>(ptr + BytesPerSample)],
+                    transfer_function[get_sample<BytesPerSample>(ptr + 2 * BytesPerSample)],
+                    1.0f};
+            } else {
+                linear_RGB = f32x4::broadcast(transfer_function[get_sample<BytesPerSample>(ptr)]);
+                linear_RGB.w() = 1.0f;
+            }
 
-        return u16x4{r, g, b, a};
+            auto linear_sRGB_color = _color_to_sRGB * linear_RGB;
+
+            if constexpr (HasAlpha) {
+                constexpr auto alpha_offset = (samples_per_pixel - 1) * BytesPerSample;
+                auto const alpha = static_cast<float>(get_sample<BytesPerSample>(ptr + alpha_offset)) * alpha_mul;
+
+                // pre-multiply the alpha for use in texture-maps.
+                linear_sRGB_color = linear_sRGB_color * f32x4::broadcast(alpha);
+            }
+
+            line[x] = linear_sRGB_color;
+        }
     }
 };
 
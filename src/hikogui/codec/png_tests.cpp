@@ -0,0 +1,27 @@
+// Copyright Take Vos 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include "png.hpp"
+#include "../path/path.hpp"
+#include <hikotest/hikotest.hpp>
+#include <initializer_list>
+#include <cstddef>
+
+TEST_SUITE(png_suite) {
+
+TEST_CASE(decode_multi_threaded_test)
+{
+    // The image is 200 x 276 pixels, which is decoded in 4 bands.
+    auto const path = hi::library_test_data_dir() / "png_test1.png";
+
+    auto const expected = hi::png::load(path, 1);
+    REQUIRE(expected.width() == 200);
+    REQUIRE(expected.height() == 276);
+
+    for (auto const nr_threads : std::initializer_list<std::size_t>{2, 3, 4, 8, 0}) {
+        REQUIRE(hi::png::load(path, nr_threads) == expected);
+    }
+}
+
+}; // TEST_SUITE(png_suite)
@@ -9,12 +9,28 @@
 #include "../parser/parser.hpp"
 #include "../macros.hpp"
 #include "inflate.hpp"
+#include "inflate_stream.hpp"
 #include <cstddef>
+#include <array>
+#include <algorithm>
 #include <filesystem>
 
 hi_export_module(hikogui.codec.zlib);
 
 hi_export namespace hi { inline namespace v1 {
+namespace detail {
+
+inline void zlib_check_header(uint8_t CMF, uint8_t FLG)
+{
+    auto const header_chksum = CMF * 256 + FLG;
+    hi_check(header_chksum % 31 == 0, "zlib header checksum failed.");
+
+    hi_check((CMF & 0xf) == 8, "zlib compression method must be 8");
+    hi_check(((CMF >> 4) & 0xf) <= 7, "zlib LZ77 window too large");
+    hi_check((FLG & 0x20) == 0, "zlib must not use a preset dictionary");
+}
+
+} // namespace detail
 
 [[nodiscard]] inline bstring zlib_decompress(std::span<std::byte const> bytes, std::size_t max_size)
 {
@@ -26,17 +42,7 @@ hi_export namespace hi { inline namespace v1 {
     auto offset = 0_uz;
 
     auto const header = make_placement_ptr<zlib_header>(bytes, offset);
-
-    auto const header_chksum = header->CMF * 256 + header->FLG;
-    hi_check(header_chksum % 31 == 0, "zlib header checksum failed.");
-
-    hi_check((header->CMF & 0xf) == 8, "zlib compression method must be 8");
-    hi_check(((header->CMF >> 4) & 0xf) <= 7, "zlib LZ77 window too large");
-    hi_check((header->FLG & 0x20) == 0, "zlib must not use a preset dictionary");
-
-    if (header->FLG & 0x20) {
-        [[maybe_unused]] auto FDICT = make_placement_ptr<big_uint32_buf_t>(bytes, offset);
-    }
+    detail::zlib_check_header(header->CMF, header->FLG);
 
     auto r = inflate(bytes, offset, max_size);
 
@@ -50,4 +56,72 @@ hi_export namespace hi { inline namespace v1 {
     return zlib_decompress(as_span<std::byte const>(file_view(path)), max_size);
 }
 
+/** A resumable zlib decoder.
+ *
+ * This is an `inflate_stream` which first strips the zlib header, which
+ * may be split over multiple chunks. Like `zlib_decompress()` the ADLER32
+ * trailer is not checked.
+ */
+hi_export class zlib_stream {
+public:
+    /** Check if the next chunk of compressed data is needed to continue.
+     */
+    [[nodiscard]] bool need_input() const noexcept
+    {
+        return _header_size != _header.size() or _inflate.need_input();
+    }
+
+    /** Check if the end of the compressed data has been decoded.
+     */
+    [[nodiscard]] bool done() const noexcept
+    {
+        return _inflate.done();
+    }
+
+    /** Pass the next chunk of compressed data.
+     *
+     * @pre `need_input()` must be true.
+     * @param bytes The next chunk of compressed data.
+     * @throw parse_error On an invalid zlib header.
+     */
+    void feed(std::span<std::byte const> bytes)
+    {
+        hi_axiom(need_input());
+
+        if (_header_size != _header.size()) {
+            auto const n = std::min(bytes.size(), _header.size() - _header_size);
+            std::copy_n(bytes.begin(), n, _header.begin() + _header_size);
+            _header_size += n;
+            bytes = bytes.subspan(n);
+
+            if (_header_size != _header.size()) {
+                return;
+            }
+            detail::zlib_check_header(std::to_integer<uint8_t>(_header[0]), std::to_integer<uint8_t>(_header[1]));
+        }
+
+        _inflate.feed(bytes);
+    }
+
+    /** Decompress data.
+     *
+     * @param output The buffer to write the decompressed data to.
+     * @return The number of bytes written; less than the size of @a output
+     *         when `need_input()` or `done()` returns true.
+     * @throw parse_error On invalid compressed data.
+     */
+    [[nodiscard]] std::size_t read(std::span<std::byte> output)
+    {
+        if (_header_size != _header.size()) {
+            return 0;
+        }
+        return _inflate.read(output);
+    }
+
+private:
+    std::array<std::byte, 2> _header = {};
+    std::size_t _header_size = 0;
+    inflate_stream _inflate;
+};
+
 }} // namespace hi::v1
@@ -0,0 +1,96 @@
+// Copyright Take Vos 2022.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include "rcu.hpp"
+#include "../macros.hpp"
+#include <hikotest/hikotest.hpp>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+TEST_SUITE(rcu) {
+
+TEST_CASE(read)
+{
+    auto object = hi::rcu<int>{};
+    REQUIRE(object.version() == uint64_t{0});
+    REQUIRE(object.empty());
+    REQUIRE(object.capacity() == std::size_t{0});
+    REQUIRE(object.get() == nullptr);
+
+    object.emplace(42);
+    REQUIRE(object.version() == uint64_t{1});
+    REQUIRE(not object.empty());
+    REQUIRE(object.capacity() == std::size_t{1});
+
+    object.lock();
+    auto ptr = object.get();
+    REQUIRE(ptr != nullptr);
+    REQUIRE(*ptr == 42);
+    REQUIRE(object.version() == uint64_t{1});
+
+    object.unlock();
+    REQUIRE(object.version() == uint64_t{2});
+}
+
+TEST_CASE(write_while_read)
+{
+    auto object = hi::rcu<int>{};
+    REQUIRE(object.version() == uint64_t{0});
+    REQUIRE(object.empty());
+    REQUIRE(object.get() == nullptr);
+    REQUIRE(object.capacity() == std::size_t{0});
+
+    object.emplace(42);
+    REQUIRE(object.version() == uint64_t{1});
+    REQUIRE(not object.empty());
+    REQUIRE(object.capacity() == std::size_t{1});
+
+    object.lock();
+    auto ptr42 = object.get();
+    REQUIRE(ptr42 != nullptr);
+    REQUIRE(*ptr42 == 42);
+    REQUIRE(object.version() == uint64_t{1});
+
+    object.emplace(5);
+    REQUIRE(object.version() == uint64_t{1});
+    REQUIRE(object.capacity() == std::size_t{2});
+
+    object.lock();
+    auto ptr5 = object.get();
+    REQUIRE(ptr5 != nullptr);
+    REQUIRE(*ptr5 == 5);
+    REQUIRE(object.version() == uint64_t{1});
+    object.unlock();
+    // The version does not increment while a lock is being held.
+    REQUIRE(object.version() == uint64_t{1});
+
+    // The old value is still valid while the lock is held.
+    REQUIRE(*ptr42 == 42);
+
+    object.unlock();
+    REQUIRE(object.version() == uint64_t{2});
+    // The capacity does not change when just reading.
+    REQUIRE(object.capacity() == std::size_t{2});
+
+    // Reset will assign nullptr.
+    // At this point there is no lock being held, so old allocations are removed.
+    object.reset();
+    REQUIRE(object.version() == uint64_t{3});
+    REQUIRE(object.capacity() == std::size_t{0});
+    REQUIRE(object.empty());
+}
+
+TEST_CASE(destroy)
+{
+    // The current and old values are destroyed with the rcu object.
+    auto object = hi::rcu<std::string>{};
+    object.emplace("a long string which is not stored in-place");
+    object.lock();
+    object.emplace("another long string which is not stored in-place");
+    object.unlock();
+    REQUIRE(object.capacity() == std::size_t{2});
+}
+
+};
@@ -6,9 +6,11 @@
 #include "function_fifo.hpp" // export
 #include "lean_vector.hpp" // export
 #include "polymorphic_optional.hpp" // export
+#include "rope.hpp" // export
 #include "secure_vector.hpp" // export
 #include "stable_set.hpp" // export
 #include "stack.hpp" // export
+#include "delta_undo_stack.hpp" // export
 #include "undo_stack.hpp" // export
 #include "vector_span.hpp" // export
 #include "void_span.hpp" // export
@@ -0,0 +1,193 @@
+// Copyright Take Vos 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include "../utility/utility.hpp"
+#include "../macros.hpp"
+#include <deque>
+#include <utility>
+#include <cstddef>
+
+hi_export_module(hikogui.container.delta_undo_stack);
+
+hi_export namespace hi::inline v1 {
+
+/** An undo stack which records edits instead of snapshots.
+ *
+ * Each entry holds the position of the edit together with the removed and
+ * the inserted text, so that the memory used is bounded by the size of the
+ * edits instead of the size of the document.
+ *
+ * Consecutive insertions, such as typing, may be coalesced into a single
+ * entry so that they are undone together. A coalesced edit may also replace
+ * the tail of the text inserted so far, like a dead-key character that is
+ * replaced by the composed character.
+ *
+ * Before an edit is undone or redone the stack checks that the text still
+ * contains what the edit left behind. If the text was changed in another
+ * way, the history is no longer valid and is cleared.
+ *
+ * @tparam Text A string-like type with `size()`, `compare()`, `substr()`,
+ *              `replace()` and `operator==()`.
+ * @tparam State Extra state to restore on undo and redo, like a selection.
+ */
+template<typename Text, typename State>
+class delta_undo_stack {
+public:
+    using text_type = Text;
+    using state_type = State;
+
+    delta_undo_stack(delta_undo_stack const&) = default;
+    delta_undo_stack(delta_undo_stack&&) noexcept = default;
+    delta_undo_stack& operator=(delta_undo_stack const&) = default;
+    delta_undo_stack& operator=(delta_undo_stack&&) noexcept = default;
+    delta_undo_stack(std::size_t max_depth) noexcept : _max_depth(max_depth) {}
+
+    /** The number of entries, including the entries that can be redone.
+     */
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return _entries.size();
+    }
+
+    /** Record an edit.
+     *
+     * This must be called before the edit is applied to the text. Any edits
+     * that could be redone are discarded.
+     *
+     * @param text The text before the edit.
+     * @param first The index of the first character that is replaced.
+     * @param size The number of characters that are replaced.
+     * @param replacement The text that is inserted at @a first.
+     * @param state The state before the edit.
+     * @param coalesce Merge this edit with the previous edit when it replaces
+     *                 text at the end of the previous coalesced edit. An
+     *                 edit that is cancelled out this way is removed.
+     */
+    void push(
+        text_type const& text,
+        std::size_t first,
+        std::size_t size,
+        text_type const& replacement,
+        state_type const& state,
+        bool coalesce = false)
+    {
+        hi_assert(first + size <= text.size());
+        hi_assert(_cursor <= _entries.size());
+        _entries.erase(_entries.begin() + _cursor, _entries.end());
+
+        if (coalesce and _may_coalesce and not _entries.empty()) {
+            auto& last = _entries.back();
+            if (last.coalesce and first >= last.first and first + size == last.first + last.inserted.size()) {
+                last.inserted.replace(first - last.first, size, replacement);
+                if (last.inserted == last.removed) {
+                    _entries.pop_back();
+                    _cursor = _entries.size();
+                }
+                return;
+            }
+        }
+
+        _entries.emplace_back(first, text.substr(first, size), replacement, state, state, coalesce);
+        while (_entries.size() > _max_depth) {
+            _entries.pop_front();
+        }
+        _cursor = _entries.size();
+        _may_coalesce = true;
+    }
+
+    void clear() noexcept
+    {
+        _entries.clear();
+        _cursor = 0;
+        _may_coalesce = false;
+    }
+
+    [[nodiscard]] bool can_undo() const noexcept
+    {
+        return _cursor != 0;
+    }
+
+    /** Undo the last edit.
+     *
+     * @param[in,out] text The current text, modified in-place.
+     * @param[in,out] state The current state, replaced by the state from
+     *                      before the edit.
+     * @return true if the edit was undone, false if the text did not match
+     *         the history, in which case the history is cleared.
+     */
+    [[nodiscard]] bool undo(text_type& text, state_type& state)
+    {
+        hi_assert(can_undo());
+
+        auto& entry = _entries[_cursor - 1];
+        if (entry.first + entry.inserted.size() > text.size() or
+            text.compare(entry.first, entry.inserted.size(), entry.inserted) != 0) {
+            clear();
+            return false;
+        }
+
+        text.replace(entry.first, entry.inserted.size(), entry.removed);
+        // Redo returns to the state from just before this undo.
+        entry.state_after = std::exchange(state, entry.state_before);
+        --_cursor;
+        _may_coalesce = false;
+        return true;
+    }
+
+    [[nodiscard]] bool can_redo() const noexcept
+    {
+        return _cursor < _entries.size();
+    }
+
+    /** Redo the last undone edit.
+     *
+     * @param[in,out] text The current text, modified in-place.
+     * @param[in,out] state The current state, replaced by the state from
+     *                      before the edit was undone.
+     * @return true if the edit was redone, false if the text did not match
+     *         the history, in which case the history is cleared.
+     */
+    [[nodiscard]] bool redo(text_type& text, state_type& state)
+    {
+        hi_assert(can_redo());
+
+        auto const& entry = _entries[_cursor];
+        if (entry.first + entry.removed.size() > text.size() or
+            text.compare(entry.first, entry.removed.size(), entry.removed) != 0) {
+            clear();
+            return false;
+        }
+
+        text.replace(entry.first, entry.removed.size(), entry.inserted);
+        state = entry.state_after;
+        ++_cursor;
+        _may_coalesce = false;
+        return true;
+    }
+
+private:
+    struct entry_type {
+        std::size_t first;
+        text_type removed;
+        text_type inserted;
+        state_type state_before;
+        state_type state_after;
+        bool coalesce;
+    };
+
+    std::deque<entry_type> _entries = {};
+    std::size_t _max_depth;
+
+    /** The number of entries that can be undone.
+     */
+    std::size_t _cursor = 0;
+
+    /** Set when the last operation was a push, so the next push may coalesce.
+     */
+    bool _may_coalesce = false;
+};
+
+} // namespace hi::inline v1
@@ -0,0 +1,159 @@
+// Copyright Take Vos 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include "delta_undo_stack.hpp"
+#include <hikotest/hikotest.hpp>
+#include <string>
+
+TEST_SUITE(delta_undo_stack) {
+
+using stack_type = hi::delta_undo_stack<std::string, int>;
+
+static void edit(stack_type& stack, std::string& text, int& state, std::size_t first, std::size_t size, std::string const& replacement, bool coalesce = false)
+{
+    stack.push(text, first, size, replacement, state, coalesce);
+    text.replace(first, size, replacement);
+    ++state;
+}
+
+TEST_CASE(undo_redo)
+{
+    auto stack = stack_type{10};
+    auto text = std::string{"hello world"};
+    auto state = 0;
+
+    edit(stack, text, state, 0, 5, "goodbye");
+    REQUIRE(text == "goodbye world");
+    edit(stack, text, state, 8, 5, "");
+    REQUIRE(text == "goodbye ");
+    REQUIRE(stack.can_undo());
+    REQUIRE(not stack.can_redo());
+
+    REQUIRE(stack.undo(text, state));
+    REQUIRE(text == "goodbye world");
+    REQUIRE(state == 1);
+    REQUIRE(stack.undo(text, state));
+    REQUIRE(text == "hello world");
+    REQUIRE(state == 0);
+    REQUIRE(not stack.can_undo());
+
+    REQUIRE(stack.redo(text, state));
+    REQUIRE(text == "goodbye world");
+    REQUIRE(state == 1);
+    REQUIRE(stack.redo(text, state));
+    REQUIRE(text == "goodbye ");
+    REQUIRE(state == 2);
+    REQUIRE(not stack.can_redo());
+}
+
+TEST_CASE(push_discards_redo)
+{
+    auto stack = stack_type{10};
+    auto text = std::string{"abc"};
+    auto state = 0;
+
+    edit(stack, text, state, 3, 0, "d");
+    edit(stack, text, state, 4, 0, "e");
+    REQUIRE(stack.undo(text, state));
+    REQUIRE(text == "abcd");
+
+    edit(stack, text, state, 0, 1, "x");
+    REQUIRE(text == "xbcd");
+    REQUIRE(stack.size() == std::size_t{2});
+    REQUIRE(not stack.can_redo());
+
+    REQUIRE(stack.undo(text, state));
+    REQUIRE(stack.undo(text, state));
+    REQUIRE(text == "abc");
+}
+
+TEST_CASE(coalesce_typing)
+{
+    auto stack = stack_type{10};
+    auto text = std::string{"ab"};
+    auto state = 0;
+
+    edit(stack, text, state, 2, 0, "c", true);
+    edit(stack, text, state, 3, 0, "d", true);
+    edit(stack, text, state, 4, 0, "e", true);
+    REQUIRE(text == "abcde");
+    REQUIRE(stack.size() == std::size_t{1});
+
+    // Typing at a different position starts a new entry.
+    edit(stack, text, state, 0, 0, "x", true);
+    REQUIRE(stack.size() == std::size_t{2});
+
+    REQUIRE(stack.undo(text, state));
+    REQUIRE(text == "abcde");
+    REQUIRE(stack.undo(text, state));
+    REQUIRE(text == "ab");
+    REQUIRE(state == 0);
+}
+
+TEST_CASE(max_depth)
+{
+    auto stack = stack_type{3};
+    auto text = std::string{};
+    auto state = 0;
+
+    for (auto i = 0; i != 10; ++i) {
+        edit(stack, text, state, text.size(), 0, "x");
+    }
+    REQUIRE(stack.size() == std::size_t{3});
+
+    REQUIRE(stack.undo(text, state));
+    REQUIRE(stack.undo(text, state));
+    REQUIRE(stack.undo(text, state));
+    REQUIRE(not stack.can_undo());
+    REQUIRE(text == "xxxxxxx");
+}
+
+TEST_CASE(coalesce_replace_tail)
+{
+    auto stack = stack_type{10};
+    auto text = std::string{"x"};
+    auto state = 0;
+
+    // Typing, then a dead-key character which is replaced by the composed character.
+    edit(stack, text, state, 1, 0, "a", true);
+    edit(stack, text, state, 2, 0, "'", true);
+    edit(stack, text, state, 2, 1, "", true);
+    edit(stack, text, state, 2, 0, "e", true);
+    REQUIRE(text == "xae");
+    REQUIRE(stack.size() == std::size_t{1});
+
+    REQUIRE(stack.undo(text, state));
+    REQUIRE(text == "x");
+    REQUIRE(state == 0);
+    REQUIRE(not stack.can_undo());
+
+    // An edit that is cancelled out is removed.
+    stack.clear();
+    edit(stack, text, state, 0, 1, "'", true);
+    edit(stack, text, state, 0, 1, "x", true);
+    REQUIRE(text == "x");
+    REQUIRE(not stack.can_undo());
+
+    // Replacing text before the coalesced edit starts a new entry.
+    edit(stack, text, state, 1, 0, "b", true);
+    edit(stack, text, state, 0, 2, "c", true);
+    REQUIRE(stack.size() == std::size_t{2});
+}
+
+TEST_CASE(external_change_clears)
+{
+    auto stack = stack_type{10};
+    auto text = std::string{"abc"};
+    auto state = 0;
+
+    edit(stack, text, state, 3, 0, "def");
+    text = "something else";
+
+    REQUIRE(not stack.undo(text, state));
+    REQUIRE(text == "something else");
+    REQUIRE(not stack.can_undo());
+    REQUIRE(not stack.can_redo());
+}
+
+};
@@ -0,0 +1,569 @@
+// Copyright Take Vos 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include "../utility/utility.hpp"
+#include "../macros.hpp"
+#include <memory>
+#include <vector>
+#include <iterator>
+#include <algorithm>
+#include <initializer_list>
+#include <span>
+#include <tuple>
+#include <limits>
+#include <compare>
+#include <concepts>
+#include <ranges>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+
+hi_export_module(hikogui.container.rope);
+
+hi_export namespace hi::inline v1 {
+
+/** A sequence with logarithmic insert and erase, and constant time copies.
+ *
+ * The rope is a height-balanced binary tree with the elements stored in
+ * leaves of up to `LeafSize` elements. Nodes are immutable and shared
+ * between copies of a rope, so a copy, for example a snapshot for an undo
+ * history, is O(1) and only the nodes on the path of an edit are copied.
+ *
+ *  - `insert()`, `erase()`, `replace()`, `substr()`, concatenation: O(log n)
+ *    plus the size of the inserted elements.
+ *  - `operator[]`: O(log n).
+ *  - iteration: amortized O(1) per element.
+ *
+ * The iterators are random-access and can be passed to algorithms that take
+ * an iterator pair, such as the unicode break algorithms. Iterators are
+ * invalidated by any modification of the rope.
+ *
+ * @tparam T The type of the elements.
+ * @tparam LeafSize The maximum number of elements in a leaf.
+ */
+template<typename T, std::size_t LeafSize = 512>
+class rope {
+public:
+    static_assert(LeafSize >= 2);
+
+    using value_type = T;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type const&;
+    using const_reference = value_type const&;
+
+    constexpr static size_type leaf_size = LeafSize;
+
+private:
+    struct node_type;
+    using node_ptr = std::shared_ptr<node_type const>;
+
+    struct node_type {
+        size_type size;
+
+        /** The height of the node, leaves have a height of zero.
+         */
+        uint8_t height;
+
+        node_ptr left;
+        node_ptr right;
+        std::vector<value_type> elements;
+
+        [[nodiscard]] bool is_leaf() const noexcept
+        {
+            return height == 0;
+        }
+    };
+
+public:
+    class const_iterator {
+    public:
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = rope::value_type;
+        using difference_type = rope::difference_type;
+        using reference = rope::const_reference;
+        using pointer = value_type const *;
+
+        constexpr const_iterator() noexcept = default;
+        constexpr const_iterator(const_iterator const&) noexcept = default;
+        constexpr const_iterator(const_iterator&&) noexcept = default;
+        constexpr const_iterator& operator=(const_iterator const&) noexcept = default;
+        constexpr const_iterator& operator=(const_iterator&&) noexcept = default;
+
+        const_iterator(rope const *rope, size_type index) noexcept : _rope(rope), _index(index) {}
+
+        [[nodiscard]] size_type index() const noexcept
+        {
+            return _index;
+        }
+
+        [[nodiscard]] reference operator*() const noexcept
+        {
+            return get(_index);
+        }
+
+        [[nodiscard]] pointer operator->() const noexcept
+        {
+            return std::addressof(get(_index));
+        }
+
+        /** Get an element relative to this iterator.
+         *
+         * The leaf that is found is remembered, so that accessing nearby
+         * elements through the same iterator is fast.
+         */
+        [[nodiscard]] reference operator[](difference_type n) const noexcept
+        {
+            return get(_index + n);
+        }
+
+        const_iterator& operator++() noexcept
+        {
+            ++_index;
+            return *this;
+        }
+
+        const_iterator operator++(int) noexcept
+        {
+            auto tmp = *this;
+            ++_index;
+            return tmp;
+        }
+
+        const_iterator& operator--() noexcept
+        {
+            --_index;
+            return *this;
+        }
+
+        const_iterator operator--(int) noexcept
+        {
+            auto tmp = *this;
+            --_index;
+            return tmp;
+        }
+
+        const_iterator& operator+=(difference_type n) noexcept
+        {
+            _index += n;
+            return *this;
+        }
+
+        const_iterator& operator-=(difference_type n) noexcept
+        {
+            _index -= n;
+            return *this;
+        }
+
+        [[nodiscard]] friend const_iterator operator+(const_iterator lhs, difference_type rhs) noexcept
+        {
+            return lhs += rhs;
+        }
+
+        [[nodiscard]] friend const_iterator operator+(difference_type lhs, const_iterator rhs) noexcept
+        {
+            return rhs += lhs;
+        }
+
+        [[nodiscard]] friend const_iterator operator-(const_iterator lhs, difference_type rhs) noexcept
+        {
+            return lhs -= rhs;
+        }
+
+        [[nodiscard]] friend difference_type operator-(const_iterator const& lhs, const_iterator const& rhs) noexcept
+        {
+            return static_cast<difference_type>(lhs._index) - static_cast<difference_type>(rhs._index);
+        }
+
+        [[nodiscard]] friend bool operator==(const_iterator const& lhs, const_iterator const& rhs) noexcept
+        {
+            return lhs._index == rhs._index;
+        }
+
+        [[nodiscard]] friend std::strong_ordering operator<=>(const_iterator const& lhs, const_iterator const& rhs) noexcept
+        {
+            return lhs._index <=> rhs._index;
+        }
+
+    private:
+        rope const *_rope = nullptr;
+        size_type _index = 0;
+
+        /** The leaf containing the last accessed element.
+         */
+        mutable node_type const *_leaf = nullptr;
+        mutable size_type _leaf_first = 0;
+
+        [[nodiscard]] reference get(size_type index) const noexcept
+        {
+            if (_leaf == nullptr or index < _leaf_first or index >= _leaf_first + _leaf->size) {
+                hi_assert_not_null(_rope);
+                std::tie(_leaf, _leaf_first) = _rope->find_leaf(index);
+            }
+            return _leaf->elements[index - _leaf_first];
+        }
+    };
+
+    using iterator = const_iterator;
+
+    rope(rope const&) noexcept = default;
+    rope(rope&&) noexcept = default;
+    rope& operator=(rope const&) noexcept = default;
+    rope& operator=(rope&&) noexcept = default;
+    rope() noexcept = default;
+
+    template<std::input_iterator It, std::sentinel_for<It> ItEnd>
+    rope(It first, ItEnd last) : _root(make_tree(first, last))
+    {
+    }
+
+    rope(std::initializer_list<value_type> list) : rope(list.begin(), list.end()) {}
+
+    template<std::ranges::input_range Range>
+        requires(not std::same_as<std::remove_cvref_t<Range>, rope>)
+    explicit rope(Range const& range) : rope(std::ranges::begin(range), std::ranges::end(range))
+    {
+    }
+
+    [[nodiscard]] size_type size() const noexcept
+    {
+        return _root ? _root->size : 0;
+    }
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return not _root;
+    }
+
+    [[nodiscard]] const_iterator begin() const noexcept
+    {
+        return {this, 0};
+    }
+
+    [[nodiscard]] const_iterator cbegin() const noexcept
+    {
+        return begin();
+    }
+
+    [[nodiscard]] const_iterator end() const noexcept
+    {
+        return {this, size()};
+    }
+
+    [[nodiscard]] const_iterator cend() const noexcept
+    {
+        return end();
+    }
+
+    [[nodiscard]] const_reference operator[](size_type index) const noexcept
+    {
+        hi_axiom(index < size());
+        auto const [leaf, leaf_first] = find_leaf(index);
+        return leaf->elements[index - leaf_first];
+    }
+
+    [[nodiscard]] const_reference front() const noexcept
+    {
+        return (*this)[0];
+    }
+
+    [[nodiscard]] const_reference back() const noexcept
+    {
+        return (*this)[size() - 1];
+    }
+
+    void clear() noexcept
+    {
+        _root = nullptr;
+    }
+
+    /** Get a part of the rope.
+     *
+     * The returned rope shares its nodes with this rope.
+     */
+    [[nodiscard]] rope substr(size_type index, size_type count = std::numeric_limits<size_type>::max()) const
+    {
+        hi_axiom(index <= size());
+        count = std::min(count, size() - index);
+
+        auto [left, rest] = split(_root, index);
+        auto [middle, right] = split(rest, count);
+        return rope(std::move(middle));
+    }
+
+    /** Replace a range of elements with other elements.
+     *
+     * @param index The index of the first element to replace.
+     * @param count The number of elements to replace.
+     * @param replacement The elements to insert.
+     */
+    rope& replace(size_type index, size_type count, rope const& replacement)
+    {
+        hi_axiom(index <= size());
+        count = std::min(count, size() - index);
+
+        auto [left, rest] = split(_root, index);
+        auto [middle, right] = split(rest, count);
+        _root = join(join(left, replacement._root), right);
+        return *this;
+    }
+
+    rope& insert(size_type index, rope const& other)
+    {
+        return replace(index, 0, other);
+    }
+
+    rope& insert(size_type index, value_type const& value)
+    {
+        return replace(index, 0, rope(std::initializer_list<value_type>{value}));
+    }
+
+    template<std::input_iterator It, std::sentinel_for<It> ItEnd>
+    rope& insert(size_type index, It first, ItEnd last)
+    {
+        return replace(index, 0, rope(first, last));
+    }
+
+    rope& erase(size_type index, size_type count = std::numeric_limits<size_type>::max())
+    {
+        return replace(index, count, rope{});
+    }
+
+    rope& append(rope const& other)
+    {
+        _root = join(_root, other._root);
+        return *this;
+    }
+
+    void push_back(value_type const& value)
+    {
+        append(rope(std::initializer_list<value_type>{value}));
+    }
+
+    rope& operator+=(rope const& rhs)
+    {
+        return append(rhs);
+    }
+
+    [[nodiscard]] friend rope operator+(rope lhs, rope const& rhs)
+    {
+        return lhs += rhs;
+    }
+
+    [[nodiscard]] friend bool operator==(rope const& lhs, rope const& rhs) noexcept
+    {
+        if (lhs._root == rhs._root) {
+            return true;
+        }
+        return std::ranges::equal(lhs, rhs);
+    }
+
+    /** Call a function for each contiguous chunk of elements.
+     *
+     * @param func A function with the signature `void(std::span<value_type const>)`.
+     */
+    template<typename Func>
+    void for_each_chunk(Func&& func) const
+    {
+        for_each_chunk(_root.get(), func);
+    }
+
+    /** The height of the tree, used for testing the balance.
+     */
+    [[nodiscard]] size_type height() const noexcept
+    {
+        return _root ? _root->height : 0;
+    }
+
+private:
+    node_ptr _root;
+
+    explicit rope(node_ptr root) noexcept : _root(std::move(root)) {}
+
+    [[nodiscard]] static int height(node_ptr const& node) noexcept
+    {
+        return node ? node->height : -1;
+    }
+
+    [[nodiscard]] static node_ptr make_leaf(std::vector<value_type> elements)
+    {
+        if (elements.empty()) {
+            return nullptr;
+        }
+        auto const size = elements.size();
+        return std::make_shared<node_type const>(size, uint8_t{0}, nullptr, nullptr, std::move(elements));
+    }
+
+    [[nodiscard]] static node_ptr make_branch(node_ptr left, node_ptr right)
+    {
+        hi_axiom(left and right);
+        auto const size = left->size + right->size;
+        auto const height = narrow_cast<uint8_t>(std::max(left->height, right->height) + 1);
+        return std::make_shared<node_type const>(size, height, std::move(left), std::move(right), std::vector<value_type>{});
+    }
+
+    /** Make a branch of two nodes whose heights differ at most by two.
+     */
+    [[nodiscard]] static node_ptr balance(node_ptr left, node_ptr right)
+    {
+        auto const left_height = height(left);
+        auto const right_height = height(right);
+
+        if (left_height > right_height + 1) {
+            if (height(left->left) >= height(left->right)) {
+                return make_branch(left->left, make_branch(left->right, std::move(right)));
+            } else {
+                auto const& middle = left->right;
+                return make_branch(make_branch(left->left, middle->left), make_branch(middle->right, std::move(right)));
+            }
+
+        } else if (right_height > left_height + 1) {
+            if (height(right->right) >= height(right->left)) {
+                return make_branch(make_branch(std::move(left), right->left), right->right);
+            } else {
+                auto const& middle = right->left;
+                return make_branch(make_branch(std::move(left), middle->left), make_branch(middle->right, right->right));
+            }
+
+        } else {
+            return make_branch(std::move(left), std::move(right));
+        }
+    }
+
+    /** Concatenate two trees.
+     *
+     * Small adjacent leaves are merged.
+     */
+    [[nodiscard]] static node_ptr join(node_ptr const& left, node_ptr const& right)
+    {
+        if (not left) {
+            return right;
+        } else if (not right) {
+            return left;
+        }
+
+        auto const left_height = height(left);
+        auto const right_height = height(right);
+
+        if (left_height == 0 and right_height == 0 and left->size + right->size <= leaf_size) {
+            auto elements = std::vector<value_type>{};
+            elements.reserve(left->size + right->size);
+            elements.insert(elements.end(), left->elements.begin(), left->elements.end());
+            elements.insert(elements.end(), right->elements.begin(), right->elements.end());
+            return make_leaf(std::move(elements));
+
+        } else if (left_height > right_height + 1) {
+            return balance(left->left, join(left->right, right));
+
+        } else if (right_height > left_height + 1) {
+            return balance(join(left, right->left), right->right);
+
+        } else {
+            return make_branch(left, right);
+        }
+    }
+
+    /** Split a tree in two.
+     *
+     * @return The tree with the elements before @a index, and the tree with
+     *         the rest of the elements.
+     */
+    [[nodiscard]] static std::pair<node_ptr, node_ptr> split(node_ptr const& node, size_type index)
+    {
+        if (index == 0) {
+            return {nullptr, node};
+        } else if (index == node->size) {
+            return {node, nullptr};
+        }
+
+        if (node->is_leaf()) {
+            auto const split_it = node->elements.begin() + index;
+            return {
+                make_leaf(std::vector<value_type>{node->elements.begin(), split_it}),
+                make_leaf(std::vector<value_type>{split_it, node->elements.end()})};
+        }
+
+        auto const left_size = node->left->size;
+        if (index < left_size) {
+            auto [left, right] = split(node->left, index);
+            return {std::move(left), join(right, node->right)};
+        } else {
+            auto [left, right] = split(node->right, index - left_size);
+            return {join(node->left, left), std::move(right)};
+        }
+    }
+
+    template<std::input_iterator It, std::sentinel_for<It> ItEnd>
+    [[nodiscard]] static node_ptr make_tree(It first, ItEnd last)
+    {
+        auto nodes = std::vector<node_ptr>{};
+
+        auto elements = std::vector<value_type>{};
+        for (auto it = first; it != last; ++it) {
+            if (elements.size() == leaf_size) {
+                nodes.push_back(make_leaf(std::exchange(elements, {})));
+            }
+            elements.push_back(*it);
+        }
+        if (not elements.empty()) {
+            nodes.push_back(make_leaf(std::move(elements)));
+        }
+
+        // Build a perfectly balanced tree bottom-up.
+        while (nodes.size() > 1) {
+            auto parents = std::vector<node_ptr>{};
+            parents.reserve((nodes.size() + 1) / 2);
+            for (auto i = 0_uz; i + 1 < nodes.size(); i += 2) {
+                parents.push_back(make_branch(nodes[i], nodes[i + 1]));
+            }
+            if (nodes.size() % 2 == 1) {
+                // Joining the odd node keeps the tree balanced.
+                parents.back() = join(parents.back(), nodes.back());
+            }
+            nodes = std::move(parents);
+        }
+
+        return nodes.empty() ? nullptr : std::move(nodes.front());
+    }
+
+    /** Find the leaf containing an element.
+     *
+     * @return The leaf, and the index of the first element of the leaf.
+     */
+    [[nodiscard]] std::pair<node_type const *, size_type> find_leaf(size_type index) const noexcept
+    {
+        hi_axiom(index < size());
+
+        auto node = _root.get();
+        auto first = 0_uz;
+        while (not node->is_leaf()) {
+            auto const left_size = node->left->size;
+            if (index < first + left_size) {
+                node = node->left.get();
+            } else {
+                first += left_size;
+                node = node->right.get();
+            }
+        }
+        return {node, first};
+    }
+
+    template<typename Func>
+    static void for_each_chunk(node_type const *node, Func& func)
+    {
+        if (node == nullptr) {
+            return;
+        } else if (node->is_leaf()) {
+            func(std::span<value_type const>{node->elements});
+        } else {
+            for_each_chunk(node->left.get(), func);
+            for_each_chunk(node->right.get(), func);
+        }
+    }
+};
+
+} // namespace hi::inline v1
@@ -0,0 +1,136 @@
+// Copyright Take Vos 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include "rope.hpp"
+#include <hikotest/hikotest.hpp>
+#include <vector>
+#include <random>
+#include <cmath>
+#include <algorithm>
+#include <iterator>
+
+TEST_SUITE(rope) {
+
+using rope_type = hi::rope<int, 4>;
+
+[[nodiscard]] static std::vector<int> to_vector(rope_type const& r)
+{
+    return std::vector<int>(r.begin(), r.end());
+}
+
+[[nodiscard]] static bool is_balanced(rope_type const& r)
+{
+    // A height-balanced tree with n leaves has a height of at most 1.44 * log2(n + 2).
+    auto const nr_leaves = static_cast<double>(r.size()) / 2.0 + 1.0;
+    return static_cast<double>(r.height()) <= 1.45 * std::log2(nr_leaves + 2.0) + 1.0;
+}
+
+static_assert(std::random_access_iterator<rope_type::const_iterator>);
+static_assert(std::ranges::random_access_range<rope_type>);
+
+TEST_CASE(construct)
+{
+    auto const empty = rope_type{};
+    REQUIRE(empty.empty());
+    REQUIRE(empty.size() == std::size_t{0});
+    REQUIRE(empty.begin() == empty.end());
+
+    auto const r = rope_type{1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
+    REQUIRE(r.size() == std::size_t{10});
+    REQUIRE(to_vector(r) == std::vector<int>{1, 2, 3, 4, 5, 6, 7, 8, 9, 10});
+    REQUIRE(r[0] == 1);
+    REQUIRE(r[9] == 10);
+    REQUIRE(r.end() - r.begin() == 10);
+    REQUIRE(r.begin()[5] == 6);
+}
+
+TEST_CASE(insert_erase)
+{
+    auto r = rope_type{1, 2, 3, 4, 5, 6};
+    r.insert(3, rope_type{10, 11});
+    REQUIRE(to_vector(r) == std::vector<int>{1, 2, 3, 10, 11, 4, 5, 6});
+
+    r.insert(0, 0);
+    r.insert(r.size(), 7);
+    REQUIRE(to_vector(r) == std::vector<int>{0, 1, 2, 3, 10, 11, 4, 5, 6, 7});
+
+    r.erase(4, 2);
+    REQUIRE(to_vector(r) == std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7});
+
+    r.replace(1, 6, rope_type{9});
+    REQUIRE(to_vector(r) == std::vector<int>{0, 9, 7});
+
+    r.erase(0);
+    REQUIRE(r.empty());
+}
+
+TEST_CASE(substr)
+{
+    auto const r = rope_type{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    REQUIRE(to_vector(r.substr(2, 5)) == std::vector<int>{2, 3, 4, 5, 6});
+    REQUIRE(to_vector(r.substr(7)) == std::vector<int>{7, 8, 9});
+    REQUIRE(r.substr(3, 0).empty());
+}
+
+TEST_CASE(snapshot)
+{
+    auto r = rope_type{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    auto const snapshot = r;
+
+    r.erase(2, 3);
+    r.push_back(10);
+    REQUIRE(to_vector(r) == std::vector<int>{0, 1, 5, 6, 7, 8, 9, 10});
+    REQUIRE(to_vector(snapshot) == std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+    REQUIRE(r != snapshot);
+    REQUIRE(snapshot == rope_type{0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+}
+
+TEST_CASE(algorithms)
+{
+    auto const r = rope_type{5, 3, 8, 1, 9, 2, 7};
+    REQUIRE(*std::ranges::max_element(r) == 9);
+    REQUIRE(std::distance(r.begin(), std::ranges::find(r, 1)) == 3);
+
+    auto reversed = std::vector<int>(std::make_reverse_iterator(r.end()), std::make_reverse_iterator(r.begin()));
+    REQUIRE(reversed == std::vector<int>{7, 2, 9, 1, 8, 3, 5});
+
+    auto chunked = std::vector<int>{};
+    r.for_each_chunk([&](std::span<int const> chunk) {
+        chunked.insert(chunked.end(), chunk.begin(), chunk.end());
+    });
+    REQUIRE(chunked == to_vector(r));
+}
+
+TEST_CASE(random_edits)
+{
+    auto engine = std::mt19937{42};
+    auto r = rope_type{};
+    auto expected = std::vector<int>{};
+
+    for (auto i = 0; i != 5000; ++i) {
+        auto const index = std::uniform_int_distribution<std::size_t>{0, expected.size()}(engine);
+        if (std::uniform_int_distribution<int>{0, 2}(engine) != 0 or expected.empty()) {
+            auto const count = std::uniform_int_distribution<int>{1, 9}(engine);
+            auto values = std::vector<int>{};
+            for (auto j = 0; j != count; ++j) {
+                values.push_back(i * 10 + j);
+            }
+            r.insert(index, values.begin(), values.end());
+            expected.insert(expected.begin() + index, values.begin(), values.end());
+
+        } else {
+            auto const count = std::uniform_int_distribution<std::size_t>{0, 8}(engine);
+            auto const last = std::min(index + count, expected.size());
+            r.erase(index, count);
+            expected.erase(expected.begin() + index, expected.begin() + last);
+        }
+
+        REQUIRE(r.size() == expected.size());
+        REQUIRE(is_balanced(r));
+    }
+
+    REQUIRE(to_vector(r) == expected);
+}
+
+};
@@ -15,6 +15,7 @@
 #include <bit>
 #include <chrono>
 #include <format>
+#include <thread>
 
 hi_export_module(hikogui.container.wfree_fifo);
 
@@ -26,25 +27,30 @@ hi_warning_ignore_msvc(26490);
 hi_export namespace hi::inline v1 {
 
 /** A wait-free multiple-producer/single-consumer fifo designed for absolute performance.
- * Because of performance reasons the ring-buffer is 64kByte.
+ * By default the ring-buffer is 64kByte.
  * Each slot in the ring buffer consists of a pointer and a byte buffer for storage.
  *
  * The number of slots in the ring-buffer is dictated by the size of each
  * slot and the ring-buffer size.
  *
+ * Large ring-buffers should be allocated statically or on the heap, since
+ * the slots are stored inside the fifo object.
+ *
  * @tparam T Base class of the value type stored in the ring buffer.
  * @tparam SlotSize Size of each slot, must be power-of-two.
+ * @tparam FifoSize Size of the ring-buffer in bytes, must be power-of-two.
  */
-template<typename T, std::size_t SlotSize>
+template<typename T, std::size_t SlotSize, std::size_t FifoSize = 65536>
 class alignas(SlotSize) wfree_fifo {
 public:
     static_assert(std::has_single_bit(SlotSize), "Only power-of-two number of messages size allowed.");
-    static_assert(SlotSize < 65536);
+    static_assert(std::has_single_bit(FifoSize), "Only power-of-two fifo size allowed.");
+    static_assert(SlotSize < FifoSize);
 
     using value_type = T;
     using slot_type = polymorphic_optional<value_type, SlotSize, SlotSize>;
 
-    constexpr static std::size_t fifo_size = 65536;
+    constexpr static std::size_t fifo_size = FifoSize;
     constexpr static std::size_t slot_size = SlotSize;
     constexpr static std::size_t num_slots = fifo_size / slot_size;
 
@@ -60,7 +66,16 @@ public:
      */
     [[nodiscard]] bool empty() const noexcept
     {
-        return _head.load(std::memory_order::relaxed) == _tail;
+        return _head.load(std::memory_order::relaxed) == _tail.load(std::memory_order::relaxed);
+    }
+
+    /** The number of times a producer had to wait for the consumer.
+     *
+     * A producer waits, or `try_emplace()` fails, when the fifo is full.
+     */
+    [[nodiscard]] std::size_t nr_contended() const noexcept
+    {
+        return _nr_contended.load(std::memory_order::relaxed);
     }
 
     /** Take one message from the fifo slot.
@@ -73,13 +88,41 @@ public:
     template<typename Func>
     auto take_one(Func&& func) noexcept
     {
-        auto result = get_slot(_tail).invoke_and_reset(std::forward<Func>(func));
+        auto const tail = _tail.load(std::memory_order::relaxed);
+        auto result = get_slot(tail).invoke_and_reset(std::forward<Func>(func));
         if (result) {
-            _tail += slot_size;
+            _tail.store(tail + slot_size, std::memory_order::release);
         }
         return result;
     }
 
+    /** Take up to n messages from the fifo.
+     *
+     * This is faster than calling `take_one()` repeatedly, since the tail
+     * is only published to the producers once for the whole batch.
+     *
+     * @param func A `void(value_type &)` which is called for each message.
+     * @param n The maximum number of messages to take.
+     * @return The number of messages taken.
+     */
+    template<typename Func>
+    std::size_t take_n(Func&& func, std::size_t n) noexcept
+    {
+        auto const first = _tail.load(std::memory_order::relaxed);
+        auto tail = first;
+        for (auto i = 0_uz; i != n; ++i) {
+            if (not get_slot(tail).invoke_and_reset(func)) {
+                break;
+            }
+            tail += slot_size;
+        }
+
+        if (tail != first) {
+            _tail.store(tail, std::memory_order::release);
+        }
+        return (tail - first) / slot_size;
+    }
+
     /** Take all message from the queue.
      * Reads each message from the ring buffer and passes it to a call of operation.
      * If no message are available this function returns without calling operation.
@@ -103,16 +146,50 @@ public:
     hi_force_inline auto emplace_and_invoke(Func&& func, Args&&...args) noexcept
     {
         // We need a new offset.
-        // - The offset is a byte index into 64kByte of memory.
-        // - Increment offset by the slot_size and the _head will overflow naturally
-        //   at the end of the fifo.
+        // - The offset is a byte index, which is wrapped to the fifo in get_slot().
         // - We don't care about memory ordering with other writer threads. as
         //   each slot has an atomic for handling read/writer contention.
-        // - We don't have to check full/empty, this is done on the slot itself.
+        // - When the fifo is full we wait for the consumer to pass the
+        //   previous lap of this slot, an empty slot alone is not enough
+        //   since its previous-lap producer may not have written it yet.
         auto const offset = _head.fetch_add(slot_size, std::memory_order::relaxed);
+        if (offset - _tail.load(std::memory_order::acquire) >= fifo_size) [[unlikely]] {
+            wait_for_consumer(offset);
+        }
         return get_slot(offset).template wait_emplace_and_invoke<Message>(std::forward<Func>(func), std::forward<Args>(args)...);
     }
 
+    /** Create a message in-place on the fifo, unless the fifo is full.
+     *
+     * Unlike `emplace()` this function will never wait for the consumer.
+     *
+     * @tparam Message The message type derived from value_type to be stored in a free slot.
+     * @param args The arguments passed to the constructor of Message.
+     * @return true if the message was emplaced, false if the fifo was full.
+     */
+    template<typename Message, typename... Args>
+    hi_force_inline bool try_emplace(Args&&...args) noexcept
+    {
+        auto offset = _head.load(std::memory_order::relaxed);
+        do {
+            // The slot is free when the consumer has taken the message that
+            // was written into it during the previous lap.
+            if (offset - _tail.load(std::memory_order::acquire) >= fifo_size) [[unlikely]] {
+                _nr_contended.fetch_add(1, std::memory_order::relaxed);
+                return false;
+            }
+        } while (not _head.compare_exchange_weak(offset, offset + slot_size, std::memory_order::relaxed));
+
+        get_slot(offset).template wait_emplace_and_invoke<Message>([](Message&) -> void {}, std::forward<Args>(args)...);
+        return true;
+    }
+
+    template<typename Object>
+    hi_force_inline bool try_insert(Object&& object) noexcept
+    {
+        return try_emplace<std::decay_t<Object>>(std::forward<Object>(object));
+    }
+
     template<typename Func, typename Object>
     hi_force_inline auto insert_and_invoke(Func&& func, Object&& object) noexcept
     {
@@ -132,23 +209,33 @@ public:
     }
 
 private:
-#if defined(__cpp_lib_hardware_interference_size)
-    constexpr static size_t destructive_interference_size = std::hardware_destructive_interference_size;
-#else
-    constexpr static size_t destructive_interference_size = 128;
-#endif
-
     std::array<slot_type, num_slots> _slots = {}; // must be at offset 0
-    std::atomic<uint16_t> _head = 0;
+    std::atomic<std::size_t> _head = 0;
+    std::atomic<std::size_t> _nr_contended = 0;
     std::array<std::byte, destructive_interference_size> _dummy = {};
-    uint16_t _tail = 0;
+
+    /** The offset of the next message to take.
+     * Only written by the consumer; read by producers in `try_emplace()`.
+     */
+    std::atomic<std::size_t> _tail = 0;
+
+    /** Wait until the consumer has taken the previous lap of the slot at offset.
+     */
+    hi_no_inline void wait_for_consumer(std::size_t offset) noexcept
+    {
+        _nr_contended.fetch_add(1, std::memory_order::relaxed);
+        do {
+            std::this_thread::yield();
+        } while (offset - _tail.load(std::memory_order::acquire) >= fifo_size);
+    }
 
     /** Get the slot that either the _head or _tail are pointing at.
      */
-    hi_force_inline slot_type& get_slot(uint16_t offset) noexcept
+    hi_force_inline slot_type& get_slot(std::size_t offset) noexcept
     {
         hi_axiom(offset % slot_size == 0);
-        // The head and tail are 16 bit offsets within the _slots, which are
+        // The head and tail are free running byte offsets, wrapped to the _slots at offset 0.
+        offset &= fifo_size - 1;
         return *std::launder(
             std::assume_aligned<slot_size>(reinterpret_cast<slot_type *>(reinterpret_cast<char *>(this) + offset)));
     }
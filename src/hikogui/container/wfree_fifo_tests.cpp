@@ -0,0 +1,102 @@
+// Copyright Take Vos 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include "wfree_fifo.hpp"
+#include <hikotest/hikotest.hpp>
+#include <array>
+#include <memory>
+#include <thread>
+#include <vector>
+
+TEST_SUITE(wfree_fifo) {
+
+struct message_base {
+    virtual ~message_base() = default;
+
+    [[nodiscard]] virtual std::size_t producer() const noexcept = 0;
+    [[nodiscard]] virtual std::size_t sequence() const noexcept = 0;
+};
+
+struct message : message_base {
+    std::size_t _producer;
+    std::size_t _sequence;
+
+    message(std::size_t producer, std::size_t sequence) noexcept : _producer(producer), _sequence(sequence) {}
+
+    [[nodiscard]] std::size_t producer() const noexcept override
+    {
+        return _producer;
+    }
+
+    [[nodiscard]] std::size_t sequence() const noexcept override
+    {
+        return _sequence;
+    }
+};
+
+TEST_CASE(try_emplace_full)
+{
+    // 1 KiB fifo with 64 byte slots.
+    auto fifo = std::make_unique<hi::wfree_fifo<message_base, 64, 1024>>();
+    static_assert(hi::wfree_fifo<message_base, 64, 1024>::num_slots == 16);
+
+    for (auto i = std::size_t{0}; i != 16; ++i) {
+        REQUIRE(fifo->try_emplace<message>(0, i));
+    }
+    REQUIRE(not fifo->try_emplace<message>(0, 16));
+    REQUIRE(fifo->nr_contended() == 1);
+
+    auto next = std::size_t{0};
+    auto const check = [&next](message_base const& m) {
+        REQUIRE(m.sequence() == next++);
+    };
+
+    REQUIRE(fifo->take_n(check, 4) == 4);
+    REQUIRE(fifo->try_emplace<message>(0, 16));
+    REQUIRE(fifo->take_n(check, 100) == 13);
+    REQUIRE(fifo->empty());
+    REQUIRE(fifo->take_n(check, 100) == 0);
+    REQUIRE(next == 17);
+}
+
+TEST_CASE(multi_producer)
+{
+    constexpr auto nr_producers = std::size_t{4};
+    constexpr auto nr_messages = std::size_t{100'000};
+
+    // A fifo larger than the default 64 KiB.
+    auto fifo = std::make_unique<hi::wfree_fifo<message_base, 64, 1024 * 1024>>();
+
+    auto producers = std::vector<std::jthread>{};
+    for (auto p = std::size_t{0}; p != nr_producers; ++p) {
+        producers.emplace_back([&fifo, p] {
+            for (auto i = std::size_t{0}; i != nr_messages; ++i) {
+                if (i % 2 == 0) {
+                    fifo->emplace<message>(p, i);
+                } else {
+                    while (not fifo->try_emplace<message>(p, i)) {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+        });
+    }
+
+    auto next = std::array<std::size_t, nr_producers>{};
+    auto total = std::size_t{0};
+    auto in_order = true;
+    while (total != nr_producers * nr_messages) {
+        total += fifo->take_n(
+            [&](message_base const& m) {
+                in_order &= m.sequence() == next[m.producer()]++;
+            },
+            256);
+    }
+
+    producers.clear();
+    REQUIRE(in_order);
+    REQUIRE(fifo->empty());
+}
+
+};
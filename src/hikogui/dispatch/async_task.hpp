@@ -8,8 +8,7 @@
 #include "progress.hpp"
 #include "task.hpp"
 #include "awaitable.hpp"
-#include "awaitable_timer_intf.hpp"
-#include <future>
+#include "thread_pool.hpp"
 
 hi_export_module(hikogui.dispatch.async_task);
 
@@ -29,7 +28,9 @@ template<typename Func, typename... Args>
 
 /** Run a function asynchronously as a co-routine task.
  *
- * @note This will check every 15ms if the function is completed.
+ * The function is executed on `thread_pool::global()`, and the co-routine
+ * is resumed on the current thread's loop as soon as the function returns.
+ *
  * @param func The function to be called.
  * @param args... The arguments forwarded to @a func.
  */
@@ -37,33 +38,11 @@ template<typename Func, typename... Args>
 [[nodiscard]] task<std::invoke_result_t<Func, Args...>> async_task(Func func, Args... args)
     requires(not is_invocable_task_v<Func, Args...>)
 {
-    using namespace std::literals;
-
-    auto future = std::async(std::launch::async, [func = std::move(func), ... args = std::move(args)] {
+    // The job is a named variable, a lambda temporary inside the co_await expression is destroyed twice by some compilers.
+    auto job = [func = std::move(func), ... args = std::move(args)] {
         return func(args...);
-    });
-
-    if (not future.valid()) {
-        throw std::future_error(std::future_errc::no_state);
-    }
-
-    while (true) {
-        switch (future.wait_for(0s)) {
-        case std::future_status::deferred:
-            // This shouldn't really happen, this will cause the GUI to block.
-            co_return future.get();
-
-        case std::future_status::ready:
-            co_return future.get();
-
-        case std::future_status::timeout:
-            co_await 15ms;
-            break;
-
-        default:
-            hi_no_default();
-        }
-    }
+    };
+    co_return co_await awaitable_thread_pool{std::move(job)};
 }
 
 /** Features of an invocable.
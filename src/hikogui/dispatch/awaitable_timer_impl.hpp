@@ -7,6 +7,8 @@
 #include "awaitable_timer_intf.hpp"
 #if HI_OPERATING_SYSTEM == HI_OS_WINDOWS
 #include "loop_win32_intf.hpp"
+#elif HI_OPERATING_SYSTEM == HI_OS_LINUX
+#include "loop_linux_intf.hpp"
 #endif
 #include "../macros.hpp"
 #include <utility>
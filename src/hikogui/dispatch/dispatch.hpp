@@ -14,12 +14,15 @@
 #include "function_timer.hpp" // export
 #if HI_OPERATING_SYSTEM == HI_OS_WINDOWS
 #include "loop_win32_intf.hpp" // export
+#elif HI_OPERATING_SYSTEM == HI_OS_LINUX
+#include "loop_linux_intf.hpp" // export
 #endif
 #include "notifier.hpp" // export
 #include "progress.hpp" // export
 #include "socket_event.hpp" // export
 #include "task_controller.hpp" // export
 #include "task.hpp" // export
+#include "thread_pool.hpp" // export
 #include "when_any.hpp" // export
 
 /** @module hikogui.dispatch
@@ -74,9 +77,10 @@
  * Async task
  * ----------
  * The `hi::async_task()` function will call a given function and run it
- * using `std::async()` and control it using a co-routine which loops
- * until the function as completed. If the function passed to `hi::async_task()`
- * is a `hi::task` co-routine, then that function is called directly.
+ * on the work-stealing `hi::thread_pool::global()`, the co-routine is resumed
+ * on the calling thread's loop when the function has completed. If the function
+ * passed to `hi::async_task()` is a `hi::task` co-routine, then that function
+ * is called directly.
  *
  * `hi::cancelable_async_task()` is simular to `hi::async_task()` but it will
  * take a `std::stop_token` and `hi::progress_token` to cancel and track progress
@@ -12,39 +12,59 @@
 #include <algorithm>
 #include <chrono>
 #include <functional>
+#include <utility>
+#include <tuple>
 
 hi_export_module(hikogui.dispatch.function_timer);
 
 hi_export namespace hi::inline v1 {
 
 /** A timer that calls functions.
+ *
+ * The timers are stored in a 4-ary min-heap ordered by deadline, so that the
+ * next deadline is found in O(1), and adding a timer is O(log n) with a shallow
+ * tree. A timer is cancelled by destroying the callback-token returned when
+ * adding it; cancelled timers are removed lazily when they reach the front
+ * of the heap, or when the heap is compacted after it has doubled in size.
+ *
+ * Timers may be given a tolerance, the wakeup time is then rounded up to a
+ * multiple of the tolerance so that timers with nearby deadlines expire
+ * together and the loop wakes up only once for all of them. Repeating timers
+ * are rescheduled from their nominal deadline, so that the rounding does not
+ * accumulate.
  */
 class function_timer {
 public:
     constexpr function_timer() noexcept = default;
 
-    [[nodiscard]] constexpr bool empty() const noexcept
+    /** Check if there are no timers left.
+     *
+     * Cancelled timers at the front of the heap are removed first.
+     */
+    [[nodiscard]] bool empty() noexcept
+    {
+        pop_cancelled();
+        return _timers.empty();
+    }
+
+    [[nodiscard]] constexpr std::size_t size() const noexcept
     {
-        return _functions.empty();
+        return _timers.size();
     }
 
     /** Add a function to be called at a certain time.
      *
      * @param time_point The time when to call the function.
-     * @param callback The function to be called.
+     * @param func The function to be called.
+     * @param tolerance The amount of time the call may be delayed to coalesce it with other timers.
      * @return token, next to call.
      */
     template<forward_of<void()> Func>
-    [[nodiscard]] std::pair<callback<void()>, bool> delay_function(utc_nanoseconds time_point, Func &&func) noexcept
+    [[nodiscard]] std::pair<callback<void()>, bool>
+    delay_function(utc_nanoseconds time_point, Func&& func, std::chrono::nanoseconds tolerance = {}) noexcept
     {
-        auto const it = std::lower_bound(_functions.begin(), _functions.end(), time_point, [](auto const& x, auto const& time_point) {
-            return x.time_point > time_point;
-        });
-
-        auto const next_to_call = it == _functions.end();
-
         auto token = callback<void()>{std::forward<Func>(func)};
-        _functions.emplace(it, time_point, std::chrono::nanoseconds::max(), token);
+        auto const next_to_call = insert(timer_type{time_point, std::chrono::nanoseconds::max(), tolerance, token});
         return {std::move(token), next_to_call};
     }
 
@@ -52,87 +72,110 @@ public:
      *
      * @param period The period between repeated calls
      * @param time_point The time when to call the function the first time.
-     * @param callback The function to be called.
+     * @param func The function to be called.
+     * @param tolerance The amount of time each call may be delayed to coalesce it with other timers.
      * @return token, next to call.
      */
     template<forward_of<void()> Func>
     [[nodiscard]] std::pair<callback<void()>, bool> repeat_function(
         std::chrono::nanoseconds period,
         utc_nanoseconds time_point,
-        Func &&func) noexcept
+        Func&& func,
+        std::chrono::nanoseconds tolerance = {}) noexcept
     {
-        auto it = std::lower_bound(_functions.begin(), _functions.end(), time_point, [](auto const& x, auto const& time_point) {
-            return x.time_point > time_point;
-        });
-
         auto token = callback<void()>{std::forward<Func>(func)};
-        it = _functions.emplace(it, time_point, period, token);
-        return {std::move(token), it + 1 == _functions.end()};
+        auto const next_to_call = insert(timer_type{time_point, period, tolerance, token});
+        return {std::move(token), next_to_call};
     }
 
     /** Add a function to be called repeatedly.
      *
      * @param period The period between repeated calls
-     * @param callback The function to be called.
+     * @param func The function to be called.
+     * @param tolerance The amount of time each call may be delayed to coalesce it with other timers.
      * @return token, next to call.
      */
     template<forward_of<void()> Func>
-    [[nodiscard]] std::pair<callback<void()>, bool> repeat_function(std::chrono::nanoseconds period, Func &&func) noexcept
+    [[nodiscard]] std::pair<callback<void()>, bool>
+    repeat_function(std::chrono::nanoseconds period, Func&& func, std::chrono::nanoseconds tolerance = {}) noexcept
     {
-        return repeat_function(period, std::chrono::utc_clock::now(), std::forward<Func>(func));
+        return repeat_function(period, std::chrono::utc_clock::now(), std::forward<Func>(func), tolerance);
     }
 
     /** Get the deadline of the next function to call.
+     *
+     * Cancelled timers at the front of the heap are removed first, so that
+     * the loop does not wake up for them.
      *
      * @return The deadline of the next function to call, or far/max into the future.
      */
-    [[nodiscard]] utc_nanoseconds current_deadline() const noexcept
+    [[nodiscard]] utc_nanoseconds current_deadline() noexcept
     {
-        if (_functions.empty()) {
+        pop_cancelled();
+        if (_timers.empty()) {
             return utc_nanoseconds::max();
         } else {
-            return _functions.back().time_point;
+            return _timers.front().wakeup;
         }
     }
 
     /** Run all the function that should have run by the current_time.
+     *
+     * All expired timers are first removed from the heap, then called in
+     * order of their deadline, after which the repeating timers are
+     * reinserted. Functions that add new timers therefor do not disturb
+     * the current batch.
      *
      * @param current_time The current time.
-     * @param args The arguments to pass to the function.
      */
-    void run_all(utc_nanoseconds current_time, auto const&...args) noexcept
+    void run_all(utc_nanoseconds current_time) noexcept
     {
+        // A function may resume the loop recursively, take ownership of the buffer for this batch.
+        auto expired = std::move(_expired);
         while (current_deadline() <= current_time) {
-            run_one(current_time, args...);
+            expired.push_back(pop());
+        }
+
+        for (auto& item : expired) {
+            if (auto cb = item.callback.lock()) {
+                cb();
+            }
+        }
+
+        for (auto& item : expired) {
+            if (item.repeats() and not item.callback.expired()) {
+                // Delay the function to be called on the next period, counted from
+                // the nominal deadline. However if the current_time already is
+                // passed the deadline, delay it even further.
+                item.time_point += item.period;
+                if (item.time_point <= current_time) {
+                    item.time_point = current_time + item.period;
+                }
+                std::ignore = insert(std::move(item));
+            }
         }
+
+        expired.clear();
+        _expired = std::move(expired);
     }
 
 private:
+    /** The number of children of each node in the heap.
+     */
+    constexpr static std::size_t arity = 4;
+
     struct timer_type {
+        /** The nominal deadline of the timer.
+         */
         utc_nanoseconds time_point;
+
         std::chrono::nanoseconds period;
+        std::chrono::nanoseconds tolerance;
         weak_callback<void()> callback;
 
-        timer_type() noexcept = default;
-        timer_type(timer_type const&) noexcept = default;
-        timer_type(timer_type&&) noexcept = default;
-        timer_type& operator=(timer_type const&) noexcept = default;
-        timer_type& operator=(timer_type&&) noexcept = default;
-
-        timer_type(utc_nanoseconds time_point, std::chrono::nanoseconds period, weak_callback<void()> callback) noexcept :
-            time_point(time_point), period(period), callback(std::move(callback))
-        {
-        }
-
-        timer_type(utc_nanoseconds time_point, weak_callback<void()> callback) noexcept :
-            timer_type(time_point, std::chrono::nanoseconds::max(), std::move(callback))
-        {
-        }
-
-        timer_type(std::chrono::nanoseconds period, weak_callback<void()> callback) noexcept :
-            timer_type(std::chrono::utc_clock::now(), period, std::move(callback))
-        {
-        }
+        /** The deadline rounded up to the tolerance, the key of the heap.
+         */
+        utc_nanoseconds wakeup = {};
 
         [[nodiscard]] constexpr bool repeats() const noexcept
         {
@@ -140,53 +183,127 @@ private:
         }
     };
 
-    void remove_or_reinsert(utc_nanoseconds current_time) noexcept
+    /** Insert a timer in the heap.
+     *
+     * @return True if the timer is the next to be called.
+     */
+    [[nodiscard]] bool insert(timer_type item) noexcept
     {
-        hi_assert(not _functions.empty());
-
-        if (_functions.back().repeats() and not _functions.back().callback.expired()) {
-            // When the function is repeating, calculate the new.
-            auto item = std::move(_functions.back());
-            _functions.pop_back();
-
-            // Delay the function to be called on the next period.
-            // However if the current_time already is passed the deadline, delay it even further.
-            item.time_point += item.period;
-            if (item.time_point > current_time) {
-                item.time_point = current_time + item.period;
+        item.wakeup = item.time_point;
+        if (item.tolerance > std::chrono::nanoseconds::zero() and item.time_point != utc_nanoseconds::max()) {
+            auto const remainder = item.time_point.time_since_epoch() % item.tolerance;
+            if (remainder != std::chrono::nanoseconds::zero()) {
+                item.wakeup += item.tolerance - remainder;
             }
+        }
 
-            // Reinsert the function in the sorted list of functions.
-            auto const it = std::lower_bound(_functions.begin(), _functions.end(), item.time_point, [](auto const& x, auto const& time_point) {
-                return x.time_point > time_point;
-            });
+        if (_timers.size() >= _compact_size) {
+            compact();
+        }
 
-            _functions.insert(it, std::move(item));
+        _timers.push_back(std::move(item));
+        return sift_up(_timers.size() - 1) == 0;
+    }
 
+    /** Remove and return the timer with the earliest deadline.
+     */
+    [[nodiscard]] timer_type pop() noexcept
+    {
+        hi_axiom(not _timers.empty());
+
+        auto r = std::move(_timers.front());
+        if (_timers.size() > 1) {
+            _timers.front() = std::move(_timers.back());
+            _timers.pop_back();
+            sift_down(0);
         } else {
-            _functions.pop_back();
+            _timers.pop_back();
         }
+        return r;
     }
 
-    /** Call the next function on the list.
-     *
-     * @note it is undefined behavior to call this function if the current_deadline() has not passed.
-     * @param current_time The current time, this is used when reinserting periodic function to handle starvation issues.
+    /** Remove cancelled timers from the front of the heap.
      */
-    void run_one(utc_nanoseconds current_time)
+    void pop_cancelled() noexcept
+    {
+        while (not _timers.empty() and _timers.front().callback.expired()) {
+            std::ignore = pop();
+        }
+    }
+
+    /** Remove cancelled timers from the heap.
+     */
+    void compact() noexcept
+    {
+        std::erase_if(_timers, [](auto const& item) {
+            return item.callback.expired();
+        });
+
+        // Rebuild the heap from the parent of the last node back to the root.
+        if (_timers.size() > 1) {
+            for (auto i = (_timers.size() - 2) / arity + 1; i != 0; --i) {
+                sift_down(i - 1);
+            }
+        }
+
+        _compact_size = std::max(min_compact_size, _timers.size() * 2);
+    }
+
+    std::size_t sift_up(std::size_t i) noexcept
     {
-        hi_assert(not _functions.empty());
+        auto item = std::move(_timers[i]);
+        while (i != 0) {
+            auto const parent = (i - 1) / arity;
+            if (not(item.wakeup < _timers[parent].wakeup)) {
+                break;
+            }
+            _timers[i] = std::move(_timers[parent]);
+            i = parent;
+        }
+        _timers[i] = std::move(item);
+        return i;
+    }
+
+    void sift_down(std::size_t i) noexcept
+    {
+        auto const size = _timers.size();
+        auto item = std::move(_timers[i]);
+        while (true) {
+            auto const first_child = i * arity + 1;
+            if (first_child >= size) {
+                break;
+            }
 
-        auto &callback = _functions.back().callback;
-        if (auto cb = callback.lock()) {
-            cb();
+            auto const last_child = std::min(first_child + arity, size);
+            auto min_child = first_child;
+            for (auto child = first_child + 1; child < last_child; ++child) {
+                if (_timers[child].wakeup < _timers[min_child].wakeup) {
+                    min_child = child;
+                }
+            }
+
+            if (not(_timers[min_child].wakeup < item.wakeup)) {
+                break;
+            }
+            _timers[i] = std::move(_timers[min_child]);
+            i = min_child;
         }
-        remove_or_reinsert(current_time);
+        _timers[i] = std::move(item);
     }
 
-    /** Functions, sorted by descending time.
+    constexpr static std::size_t min_compact_size = 64;
+
+    /** Timers, a 4-ary min-heap on the wakeup time.
+     */
+    std::vector<timer_type> _timers;
+
+    /** The timers being called by run_all(), reused between calls.
+     */
+    std::vector<timer_type> _expired;
+
+    /** The size of the heap at which cancelled timers are removed.
      */
-    std::vector<timer_type> _functions;
+    std::size_t _compact_size = min_compact_size;
 };
 
 } // namespace hi::inline v1
@@ -0,0 +1,199 @@
+// Copyright Take Vos 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include "function_timer.hpp"
+#include <hikotest/hikotest.hpp>
+#include <chrono>
+#include <vector>
+#include <random>
+#include <algorithm>
+
+TEST_SUITE(function_timer_suite) {
+
+static hi::utc_nanoseconds at(std::chrono::nanoseconds rhs)
+{
+    return hi::utc_nanoseconds{rhs};
+}
+
+TEST_CASE(order_test)
+{
+    using namespace std::chrono_literals;
+
+    auto timer = hi::function_timer{};
+    auto engine = std::mt19937{42};
+    auto dist = std::uniform_int_distribution<int>{0, 100'000};
+
+    auto deadlines = std::vector<int>{};
+    auto called = std::vector<int>{};
+    auto tokens = std::vector<hi::callback<void()>>{};
+    for (auto i = 0; i != 1000; ++i) {
+        auto const deadline = dist(engine);
+        deadlines.push_back(deadline);
+        tokens.push_back(timer.delay_function(at(deadline * 1us), [&called, deadline] {
+            called.push_back(deadline);
+        }).first);
+    }
+    REQUIRE(timer.size() == 1000);
+
+    for (auto t = 0us; t <= 100'000us; t += 1'000us) {
+        timer.run_all(at(t));
+        REQUIRE(timer.current_deadline() > at(t));
+    }
+
+    std::ranges::sort(deadlines);
+    REQUIRE(called == deadlines);
+    REQUIRE(timer.empty());
+}
+
+TEST_CASE(next_to_call_test)
+{
+    using namespace std::chrono_literals;
+
+    auto timer = hi::function_timer{};
+
+    auto [a, a_first] = timer.delay_function(at(20ms), [] {});
+    REQUIRE(a_first);
+    auto [b, b_first] = timer.delay_function(at(30ms), [] {});
+    REQUIRE(not b_first);
+    auto [c, c_first] = timer.delay_function(at(10ms), [] {});
+    REQUIRE(c_first);
+    REQUIRE(timer.current_deadline() == at(10ms));
+}
+
+TEST_CASE(cancel_test)
+{
+    using namespace std::chrono_literals;
+
+    auto timer = hi::function_timer{};
+    auto count = 0;
+
+    auto a = timer.delay_function(at(10ms), [&] {
+        ++count;
+    }).first;
+    auto b = timer.delay_function(at(10ms), [&] {
+        ++count;
+    }).first;
+
+    b = {};
+    timer.run_all(at(10ms));
+    REQUIRE(count == 1);
+
+    // A cancelled timer does not wake up the loop, and does not keep it running.
+    auto c = timer.delay_function(at(20ms), [&] {
+        ++count;
+    }).first;
+    auto d = timer.delay_function(at(30ms), [&] {
+        ++count;
+    }).first;
+    REQUIRE(timer.current_deadline() == at(20ms));
+
+    c = {};
+    REQUIRE(timer.current_deadline() == at(30ms));
+
+    d = {};
+    REQUIRE(timer.empty());
+    REQUIRE(timer.current_deadline() == hi::utc_nanoseconds::max());
+}
+
+TEST_CASE(compact_test)
+{
+    using namespace std::chrono_literals;
+
+    auto timer = hi::function_timer{};
+
+    // Cancelled timers are removed when the heap grows, instead of lingering until their deadline.
+    for (auto i = 0; i != 10'000; ++i) {
+        std::ignore = timer.delay_function(at(1h + i * 1ms), [] {});
+    }
+    REQUIRE(timer.size() < 128);
+
+    auto count = 0;
+    auto a = timer.delay_function(at(1s), [&] {
+        ++count;
+    }).first;
+    timer.run_all(at(2h));
+    REQUIRE(count == 1);
+    REQUIRE(timer.empty());
+}
+
+TEST_CASE(repeat_test)
+{
+    using namespace std::chrono_literals;
+
+    auto timer = hi::function_timer{};
+    auto count = 0;
+
+    auto a = timer.repeat_function(10ms, at(0ms), [&] {
+        ++count;
+    }).first;
+
+    timer.run_all(at(0ms));
+    REQUIRE(count == 1);
+    REQUIRE(timer.current_deadline() == at(10ms));
+
+    timer.run_all(at(10ms));
+    REQUIRE(count == 2);
+    REQUIRE(timer.current_deadline() == at(20ms));
+
+    // When the loop fell behind the function is called once, and rescheduled a period from now.
+    timer.run_all(at(55ms));
+    REQUIRE(count == 3);
+    REQUIRE(timer.current_deadline() == at(65ms));
+}
+
+TEST_CASE(tolerance_test)
+{
+    using namespace std::chrono_literals;
+
+    auto timer = hi::function_timer{};
+    auto count = 0;
+
+    auto a = timer.delay_function(at(1200us), [&] {
+        ++count;
+    }, 1ms).first;
+    auto b = timer.delay_function(at(1700us), [&] {
+        ++count;
+    }, 1ms).first;
+    auto c = timer.delay_function(at(1700us), [&] {
+        ++count;
+    }).first;
+
+    REQUIRE(timer.current_deadline() == at(1700us));
+    timer.run_all(at(1700us));
+    REQUIRE(count == 1);
+
+    REQUIRE(timer.current_deadline() == at(2ms));
+    timer.run_all(at(2ms));
+    REQUIRE(count == 3);
+
+    // A repeating timer is rounded up each period, without accumulating the rounding.
+    auto repeat_count = 0;
+    auto d = timer.repeat_function(500ms, at(10s), [&] {
+        ++repeat_count;
+    }, 16ms).first;
+
+    REQUIRE(timer.current_deadline() == at(10'000ms));
+    timer.run_all(at(10'000ms));
+    REQUIRE(repeat_count == 1);
+
+    // 10'500ms is rounded up to 10'512ms.
+    REQUIRE(timer.current_deadline() == at(10'512ms));
+    timer.run_all(at(10'512ms));
+    REQUIRE(repeat_count == 2);
+
+    // 11'000ms is rounded up to 11'008ms, not to 11'024ms.
+    REQUIRE(timer.current_deadline() == at(11'008ms));
+    timer.run_all(at(11'008ms));
+    REQUIRE(repeat_count == 3);
+
+    for (auto i = 3; i != 19; ++i) {
+        timer.run_all(timer.current_deadline());
+    }
+    REQUIRE(repeat_count == 19);
+
+    // 19'500ms is rounded up to 19'504ms.
+    REQUIRE(timer.current_deadline() == at(19'504ms));
+}
+
+}; // TEST_SUITE(function_timer_suite)
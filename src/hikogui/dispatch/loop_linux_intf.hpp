@@ -0,0 +1,742 @@
+// Copyright Take Vos 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include "function_timer.hpp"
+#include "socket_event.hpp"
+#include "notifier.hpp"
+#include "../container/container.hpp"
+#include "../telemetry/telemetry.hpp"
+#include "../concurrency/concurrency.hpp"
+#include "../concurrency/unfair_mutex.hpp" // XXX #616
+#include "../concurrency/thread.hpp" // XXX #616
+#include "../time/time.hpp"
+#include "../utility/utility.hpp"
+#include "../macros.hpp"
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <functional>
+#include <type_traits>
+#include <concepts>
+#include <vector>
+#include <array>
+#include <memory>
+#include <chrono>
+#include <thread>
+#include <stop_token>
+#include <optional>
+#include <atomic>
+#include <algorithm>
+
+hi_export_module(hikogui.dispatch : loop_intf);
+
+hi_export namespace hi::inline v1 {
+
+/** The event loop for Linux.
+ *
+ * The loop blocks on a single epoll file descriptor, which waits on:
+ *  - An eventfd, written when a function is posted from another thread.
+ *  - A timerfd, armed for the deadline of the first function_timer entry.
+ *  - A timerfd, armed periodically at the maximum frame rate while there
+ *    are render functions.
+ *  - The file descriptors added with `add_socket()`.
+ */
+class loop {
+public:
+    loop(loop const&) = delete;
+    loop(loop&&) noexcept = delete;
+    loop& operator=(loop const&) = delete;
+    loop& operator=(loop&&) noexcept = delete;
+
+    ~loop()
+    {
+        for (auto const fd : {_vsync_fd, _timer_fd, _function_fd, _epoll_fd}) {
+            if (fd != -1 and ::close(fd) != 0) {
+                hi_log_error("Could not close loop file descriptor {}. {}", fd, get_last_error_message());
+            }
+        }
+    }
+
+    loop() noexcept : _thread_id(current_thread_id())
+    {
+        _epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+        if (_epoll_fd == -1) {
+            hi_log_fatal("Could not create an epoll file descriptor. {}", get_last_error_message());
+        }
+
+        _vsync_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        if (_vsync_fd == -1) {
+            hi_log_fatal("Could not create an vsync-timer. {}", get_last_error_message());
+        }
+        epoll_add(_vsync_fd, EPOLLIN);
+
+        _function_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (_function_fd == -1) {
+            hi_log_fatal("Could not create an async-event. {}", get_last_error_message());
+        }
+        epoll_add(_function_fd, EPOLLIN);
+
+        _timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        if (_timer_fd == -1) {
+            hi_log_fatal("Could not create an function-timer. {}", get_last_error_message());
+        }
+        epoll_add(_timer_fd, EPOLLIN);
+    }
+
+    /** Get or create the thread-local loop.
+     */
+    [[nodiscard]] static loop& local() noexcept;
+
+    /** Get or create the main-loop.
+     *
+     * @note The first time main() is called must be from the main-thread.
+     *       In this case there is no race condition on the first time main() is called.
+     */
+    [[nodiscard]] hi_no_inline static loop& main() noexcept
+    {
+        if (auto ptr = _main.load(std::memory_order::acquire)) {
+            return *ptr;
+        }
+
+        hi_axiom(_timer.load(std::memory_order::relaxed) == nullptr, "loop::main() must be called before loop::timer()");
+
+        // This is the first time loop::main() is called so we must be on the main-thread
+        // So name the thread "main" so we can find it during debugging.
+        set_thread_name("main");
+
+        auto ptr = std::addressof(local());
+        _main.store(ptr, std::memory_order::release);
+        return *ptr;
+    }
+
+    /** Get or create the timer event-loop.
+     *
+     * @note The first time this is called a thread is started to handle the timer events.
+     */
+    [[nodiscard]] hi_no_inline static loop& timer() noexcept
+    {
+        // The first time timer() is called, make sure that the main-loop exists,
+        // or even create the main-loop on the current thread.
+        [[maybe_unused]] auto const &tmp = loop::main();
+
+        return *start_subsystem_or_terminate(_timer, nullptr, timer_init, timer_deinit);
+    }
+
+    /** Set maximum frame rate.
+     *
+     * There is no vertical-sync source on Linux, render functions are called
+     * periodically at this frame rate.
+     *
+     * @param frame_rate The maximum frame rate that a window will be updated.
+     */
+    void set_maximum_frame_rate(double frame_rate) noexcept
+    {
+        hi_axiom(on_thread());
+        hi_axiom(frame_rate > 0.0);
+
+        _maximum_frame_rate = frame_rate;
+        _minimum_frame_time = std::chrono::nanoseconds(narrow_cast<std::chrono::nanoseconds::rep>(1'000'000'000.0 / frame_rate));
+        if (_vsync_running) {
+            vsync_start();
+        }
+    }
+
+    /** Set the monitor id for vertical sync.
+     */
+    void set_vsync_monitor_id(uintptr_t id) noexcept
+    {
+        _selected_monitor_id.store(id, std::memory_order::relaxed);
+    }
+
+    /** Wait-free post a function to be called from the loop.
+     *
+     * @note It is safe to call this function from another thread.
+     * @note The event loop is not directly notified that a new function exists
+     *       and will be delayed until after the loop has woken for other work.
+     * @note The post is only wait-free if the function fifo is not full,
+     *       and the function is small enough to fit in a slot on the fifo.
+     * @param func The function to call from the loop. The function must not take any arguments and return void.
+     */
+    template<forward_of<void()> Func>
+    void wfree_post_function(Func&& func) noexcept
+    {
+        _function_fifo.add_function(std::forward<Func>(func));
+    }
+
+    /** Post a function to be called from the loop.
+     *
+     * @note It is safe to call this function from another thread.
+     * @param func The function to call from the loop. The function must not take any arguments and return void.
+     */
+    template<forward_of<void()> Func>
+    void post_function(Func&& func) noexcept
+    {
+        _function_fifo.add_function(std::forward<Func>(func));
+        notify_has_send();
+    }
+
+    /** Call a function from the loop.
+     *
+     * @note It is safe to call this function from another thread.
+     * @param func The function to call from the loop. The function must not take any argument,
+     *             but may return a value.
+     * @return A `std::future` for the return value.
+     */
+    template<typename Func>
+    [[nodiscard]] auto async_function(Func&& func) noexcept
+    {
+        auto future = _function_fifo.add_async_function(std::forward<Func>(func));
+        notify_has_send();
+        return future;
+    }
+
+    /** Call a function at a certain time.
+     *
+     * @param time_point The time at which to call the function.
+     * @param func The function to be called.
+     * @param tolerance The amount of time the call may be delayed to coalesce it with other timers.
+     */
+    template<forward_of<void()> Func>
+    [[nodiscard]] callback<void()>
+    delay_function(utc_nanoseconds time_point, Func&& func, std::chrono::nanoseconds tolerance = {}) noexcept
+    {
+        auto [callback, first_to_call] = _function_timer.delay_function(time_point, std::forward<Func>(func), tolerance);
+        if (first_to_call) {
+            // Notify if the added function is the next function to call.
+            notify_has_send();
+        }
+        return std::move(callback);
+    }
+
+    /** Call a function repeatedly.
+     *
+     * @param period The period between calls to the function.
+     * @param time_point The time at which to call the function.
+     * @param func The function to be called.
+     * @param tolerance The amount of time each call may be delayed to coalesce it with other timers.
+     */
+    template<forward_of<void()> Func>
+    [[nodiscard]] callback<void()> repeat_function(
+        std::chrono::nanoseconds period,
+        utc_nanoseconds time_point,
+        Func&& func,
+        std::chrono::nanoseconds tolerance = {}) noexcept
+    {
+        auto [callback, first_to_call] = _function_timer.repeat_function(period, time_point, std::forward<Func>(func), tolerance);
+        if (first_to_call) {
+            // Notify if the added function is the next function to call.
+            notify_has_send();
+        }
+        return callback;
+    }
+
+    /** Call a function repeatedly.
+     *
+     * @param period The period between calls to the function.
+     * @param func The function to be called.
+     * @param tolerance The amount of time each call may be delayed to coalesce it with other timers.
+     */
+    template<forward_of<void()> Func>
+    [[nodiscard]] callback<void()>
+    repeat_function(std::chrono::nanoseconds period, Func&& func, std::chrono::nanoseconds tolerance = {}) noexcept
+    {
+        auto [callback, first_to_call] = _function_timer.repeat_function(period, std::forward<Func>(func), tolerance);
+        if (first_to_call) {
+            // Notify if the added function is the next function to call.
+            notify_has_send();
+        }
+        return std::move(callback);
+    }
+
+    void subscribe_render(weak_callback<void(utc_nanoseconds)> callback) noexcept
+    {
+        hi_axiom(on_thread());
+
+        _render_functions.push_back(std::move(callback));
+        if (not _vsync_running) {
+            vsync_start();
+        }
+    }
+
+    /** Subscribe a render function to be called on vsync.
+     *
+     * @param f A function to be called when vsync occurs.
+     */
+    template<forward_of<void(utc_nanoseconds)> Func>
+    callback<void(utc_nanoseconds)> subscribe_render(Func &&func) noexcept
+    {
+        hi_axiom(on_thread());
+
+        auto cb = callback<void(utc_nanoseconds)>{std::forward<Func>(func)};
+
+        _render_functions.push_back(cb);
+
+        // Start the frame timer once there is a window.
+        if (not _vsync_running) {
+            vsync_start();
+        }
+
+        return cb;
+    }
+
+    /** Add a callback that reacts on a socket.
+     *
+     * In most cases @a mode is set to one of the following values:
+     * - error | read: Unblock when there is data available for read.
+     * - error | write: Unblock when there is buffer space available for write.
+     * - error | read | write: Unblock when there is data available for read of when there is buffer space available for write.
+     *
+     * The socket is level-triggered; the callback is called on each iteration of the loop
+     * for as long as the socket is ready.
+     *
+     * @note Only one callback can be associated with a socket.
+     * @param fd File descriptor of the socket.
+     * @param event_mask The socket events to wait for.
+     * @param f The callback to call when the file descriptor unblocks.
+     */
+    void add_socket(int fd, socket_event event_mask, std::function<void(int, socket_events const&)> f)
+    {
+        hi_axiom(on_thread());
+        hi_assert(std::ranges::find(_sockets, fd, &socket_type::fd) == _sockets.end());
+
+        epoll_add(fd, socket_event_to_epoll(event_mask));
+        _sockets.emplace_back(fd, event_mask, std::move(f));
+    }
+
+    /** Remove the callback associated with a socket.
+     *
+     * @param fd The file descriptor of the socket.
+     */
+    void remove_socket(int fd)
+    {
+        hi_axiom(on_thread());
+
+        auto const it = std::ranges::find(_sockets, fd, &socket_type::fd);
+        if (it == _sockets.end()) {
+            return;
+        }
+
+        // The file descriptor may already be closed, in which case it was removed from epoll.
+        if (epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, fd, nullptr) != 0 and errno != EBADF and errno != ENOENT) {
+            hi_log_error("Could not remove socket {} from epoll. {}", fd, get_last_error_message());
+        }
+        _sockets.erase(it);
+    }
+
+    /** Keep the loop running while an asynchronous operation is in flight.
+     *
+     * A co-routine that waits on work executed on another thread is not
+     * otherwise visible to the loop, so `resume()` without a stop token
+     * would exit before the co-routine is resumed.
+     *
+     * Each call must be paired with a call to `remove_pending()`.
+     * This function may be called from any thread.
+     */
+    void add_pending() noexcept
+    {
+        _num_pending.fetch_add(1, std::memory_order::relaxed);
+    }
+
+    /** The asynchronous operation that was added with `add_pending()` has completed.
+     */
+    void remove_pending() noexcept
+    {
+        hi_axiom(_num_pending.load(std::memory_order::relaxed) != 0);
+        _num_pending.fetch_sub(1, std::memory_order::relaxed);
+    }
+
+    /** Resume the loop on the current thread.
+     *
+     * @param stop_token The thread's stop token to use to determine when to stop.
+     *                   If not stop token is given, then resume will automatically stop when there
+     *                   are no more windows, sockets, functions or timers.
+     * @return Exit code when the loop is exited.
+     */
+    int resume(std::stop_token stop_token = {}) noexcept
+    {
+        // Wake up the loop when stop is requested from another thread.
+        auto const stop_callback = std::stop_callback(stop_token, [this] {
+            notify_has_send();
+        });
+
+        _exit_code = {};
+        while (not _exit_code) {
+            resume_once(true);
+
+            if (stop_token.stop_possible()) {
+                if (stop_token.stop_requested()) {
+                    // Stop immediately when stop is requested.
+                    _exit_code = 0;
+                }
+            } else {
+                if (_render_functions.empty() and _function_fifo.empty() and _function_timer.empty() and _sockets.empty() and
+                    _num_pending.load(std::memory_order::relaxed) == 0) {
+                    // If there is not stop token, then exit when there are no more resources to wait on.
+                    _exit_code = 0;
+                }
+            }
+        }
+
+        return *_exit_code;
+    }
+
+    /** Resume for a single iteration.
+     *
+     * It should be called often, as it will be used to process network messages and
+     * latency of network processing will be increased based on the amount of times
+     * this function is called.
+     *
+     * @note This function must be called from the same thread as `resume()`.
+     * @param block Allow processing to block, this is normally done only inside `resume()`.
+     */
+    void resume_once(bool block = false) noexcept
+    {
+        hi_axiom(on_thread());
+
+        update_timer_fd();
+
+        // Functions posted with wfree_post_function() do not wake up the loop,
+        // so also wake up periodically, like the win32 loop.
+        constexpr int max_timeout_ms = 100;
+        auto const timeout_ms = block ? max_timeout_ms : 0;
+
+        auto events = std::array<epoll_event, 64>{};
+        auto const num_events = epoll_wait(_epoll_fd, events.data(), narrow_cast<int>(events.size()), timeout_ms);
+        if (num_events == -1 and errno != EINTR) {
+            hi_log_fatal("Failed on epoll_wait(), {}", get_last_error_message());
+        }
+
+        for (auto i = 0; i < num_events; ++i) {
+            auto const& event = events[i];
+
+            if (event.data.fd == _vsync_fd) {
+                if (read_counter(_vsync_fd) != 0) {
+                    handle_vsync();
+                }
+
+            } else if (event.data.fd == _function_fd) {
+                read_counter(_function_fd);
+                // Posts from now on must write to the eventfd again. The exchange
+                // synchronizes with the post that set the flag, so handle_functions()
+                // below sees its function.
+                _function_notified.exchange(false, std::memory_order::acq_rel);
+
+            } else if (event.data.fd == _timer_fd) {
+                read_counter(_timer_fd);
+                // The timer is one-shot, it is re-armed by update_timer_fd().
+                _timer_fd_deadline = utc_nanoseconds::max();
+
+            } else {
+                handle_socket(event.data.fd, event.events);
+            }
+        }
+
+        // Make sure timers are handled first, possibly they are time critical.
+        handle_timers();
+
+        // When functions are added wait-free, the function-event is never triggered.
+        // So handle messages after any kind of wake up.
+        handle_functions();
+    }
+
+    /** Check if the current thread is the same as the loop's thread.
+     *
+     * The loop's thread is the thread that calls resume().
+     */
+    [[nodiscard]] bool on_thread() const noexcept
+    {
+        return current_thread_id() == _thread_id;
+    }
+
+private:
+    /** Pointer to the main-loop.
+     */
+    inline static std::atomic<loop *> _main;
+
+    /** Pointer to the timer-loop.
+     */
+    inline static std::atomic<loop *> _timer;
+
+    inline static std::jthread _timer_thread;
+
+    function_fifo<> _function_fifo;
+    function_timer _function_timer;
+
+    std::optional<int> _exit_code = {};
+
+    /** The number of asynchronous operations in flight, see `add_pending()`.
+     */
+    std::atomic<std::size_t> _num_pending = 0;
+    double _maximum_frame_rate = 30.0;
+    std::chrono::nanoseconds _minimum_frame_time = std::chrono::nanoseconds(33'333'333);
+    thread_id _thread_id;
+    std::vector<weak_callback<void(utc_nanoseconds)>> _render_functions;
+
+    struct socket_type {
+        int fd;
+        socket_event mode;
+        std::function<void(int, socket_events const&)> callback;
+    };
+
+    std::vector<socket_type> _sockets;
+
+    int _epoll_fd = -1;
+
+    /** eventfd that is written to when a function is posted.
+     */
+    int _function_fd = -1;
+
+    /** A function was posted and the eventfd was written to.
+     *
+     * This coalesces the notifications of many posts into a single write.
+     */
+    std::atomic<bool> _function_notified = false;
+
+    /** timerfd for the first deadline of the function timer.
+     */
+    int _timer_fd = -1;
+
+    /** The deadline that the timerfd is armed with.
+     */
+    utc_nanoseconds _timer_fd_deadline = utc_nanoseconds::max();
+
+    /** timerfd that periodically calls the render functions.
+     */
+    int _vsync_fd = -1;
+
+    bool _vsync_running = false;
+
+    /** Time when the last frame was started.
+     */
+    std::atomic<utc_nanoseconds> _vsync_time;
+
+    /** The monitor id that is selected for vsync.
+     */
+    std::atomic<std::uintptr_t> _selected_monitor_id = 0;
+
+    static loop *timer_init() noexcept
+    {
+        hi_assert(not _timer_thread.joinable());
+
+        _timer_thread = std::jthread{[](std::stop_token stop_token) {
+            _timer.store(std::addressof(loop::local()), std::memory_order::release);
+
+            set_thread_name("timer");
+            loop::local().resume(stop_token);
+        }};
+
+        while (true) {
+            if (auto ptr = _timer.load(std::memory_order::relaxed)) {
+                return ptr;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+    }
+
+    static void timer_deinit() noexcept
+    {
+        if (auto const *const ptr = _timer.exchange(nullptr, std::memory_order::acquire)) {
+            hi_assert(_timer_thread.joinable());
+            _timer_thread.request_stop();
+            _timer_thread.join();
+        }
+    }
+
+    void epoll_add(int fd, uint32_t events) noexcept
+    {
+        auto event = epoll_event{};
+        event.events = events;
+        event.data.fd = fd;
+        if (epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0) {
+            hi_log_fatal("Could not add file descriptor {} to epoll. {}", fd, get_last_error_message());
+        }
+    }
+
+    /** Read and reset the counter of an eventfd or timerfd.
+     *
+     * @return The value of the counter, or zero if the counter was not set.
+     */
+    uint64_t read_counter(int fd) noexcept
+    {
+        uint64_t counter = 0;
+        if (::read(fd, &counter, sizeof(counter)) != sizeof(counter)) {
+            // EAGAIN: A spurious wake-up, or the timer was re-armed.
+            if (errno != EAGAIN) {
+                hi_log_error("Could not read from file descriptor {}. {}", fd, get_last_error_message());
+            }
+            return 0;
+        }
+        return counter;
+    }
+
+    /** Notify the event loop that a function was added to the _function_fifo.
+     */
+    void notify_has_send() noexcept
+    {
+        // Only the first post after the loop woke up needs to write to the eventfd.
+        if (not _function_notified.exchange(true, std::memory_order::acq_rel)) {
+            uint64_t const one = 1;
+            if (::write(_function_fd, &one, sizeof(one)) != sizeof(one)) {
+                hi_log_error("Could not trigger async-event. {}", get_last_error_message());
+            }
+        }
+    }
+
+    /** Arm the timerfd with the deadline of the first function on the function timer.
+     *
+     * @note The timerfd is only re-armed when the deadline changes.
+     */
+    void update_timer_fd() noexcept
+    {
+        auto const deadline = _function_timer.current_deadline();
+        if (deadline == _timer_fd_deadline) {
+            return;
+        }
+        _timer_fd_deadline = deadline;
+
+        auto spec = itimerspec{};
+        if (deadline != utc_nanoseconds::max()) {
+            // An it_value of zero disarms the timer, so expire at least a nanosecond from now.
+            auto const timeout = std::max(deadline - std::chrono::utc_clock::now(), std::chrono::nanoseconds{1});
+            spec.it_value = to_timespec(timeout);
+        }
+
+        if (timerfd_settime(_timer_fd, 0, &spec, nullptr) != 0) {
+            hi_log_error("Could not arm the function-timer. {}", get_last_error_message());
+        }
+    }
+
+    [[nodiscard]] static timespec to_timespec(std::chrono::nanoseconds rhs) noexcept
+    {
+        auto r = timespec{};
+        r.tv_sec = narrow_cast<time_t>(rhs.count() / 1'000'000'000);
+        r.tv_nsec = narrow_cast<long>(rhs.count() % 1'000'000'000);
+        return r;
+    }
+
+    /** Start or restart the periodic frame timer.
+     */
+    void vsync_start() noexcept
+    {
+        auto spec = itimerspec{};
+        spec.it_interval = to_timespec(_minimum_frame_time);
+        spec.it_value = spec.it_interval;
+        if (timerfd_settime(_vsync_fd, 0, &spec, nullptr) != 0) {
+            hi_log_error("Could not start the vsync-timer. {}", get_last_error_message());
+        }
+        _vsync_running = true;
+    }
+
+    void vsync_stop() noexcept
+    {
+        auto const spec = itimerspec{};
+        if (timerfd_settime(_vsync_fd, 0, &spec, nullptr) != 0) {
+            hi_log_error("Could not stop the vsync-timer. {}", get_last_error_message());
+        }
+        _vsync_running = false;
+    }
+
+    /** Call the render functions.
+     */
+    void handle_vsync() noexcept
+    {
+        _vsync_time.store(std::chrono::utc_clock::now(), std::memory_order::relaxed);
+        ++global_counter<"vsync:frame">;
+
+        auto const display_time = _vsync_time.load(std::memory_order::relaxed) + std::chrono::milliseconds(30);
+
+        for (auto& render_function : _render_functions) {
+            if (auto rf = render_function.lock()) {
+                rf(display_time);
+            }
+        }
+
+        std::erase_if(_render_functions, [](auto& render_function) {
+            return render_function.expired();
+        });
+
+        if (_render_functions.empty()) {
+            // Stop the frame timer when there are no more windows.
+            vsync_stop();
+        }
+    }
+
+    /** Handle all function calls.
+     *
+     * @param deadline The deadline before all calls must be executed before moving on.
+     */
+    void handle_functions() noexcept
+    {
+        _function_fifo.run_all();
+    }
+
+    void handle_timers() noexcept
+    {
+        _function_timer.run_all(std::chrono::utc_clock::now());
+    }
+
+    /** Call the callback of a socket that became ready.
+     */
+    void handle_socket(int fd, uint32_t events) noexcept
+    {
+        // The socket may have been removed by a callback earlier in this iteration.
+        auto const it = std::ranges::find(_sockets, fd, &socket_type::fd);
+        if (it == _sockets.end()) {
+            return;
+        }
+
+        auto error = 0;
+        if (events & EPOLLERR) {
+            auto error_size = narrow_cast<socklen_t>(sizeof(error));
+            if (getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &error_size) != 0) {
+                error = errno;
+            }
+        }
+
+        // Copy the callback, the callback may remove its own socket.
+        auto const callback = it->callback;
+        callback(fd, socket_events_from_epoll(events, it->mode, error));
+    }
+};
+
+namespace detail {
+inline thread_local std::unique_ptr<loop> thread_local_loop;
+}
+
+/** Get or create the thread-local loop.
+ */
+[[nodiscard]] hi_no_inline inline loop& loop::local() noexcept
+{
+    if (not detail::thread_local_loop) {
+        detail::thread_local_loop = std::make_unique<loop>();
+    }
+    return *detail::thread_local_loop;
+}
+
+template<typename R, typename... Args>
+template<forward_of<void()> Func>
+void notifier<R(Args...)>::loop_local_post_function(Func&& func) const noexcept
+{
+    return loop::local().post_function(std::forward<Func>(func));
+}
+
+template<typename R, typename... Args>
+template<forward_of<void()> Func>
+void notifier<R(Args...)>::loop_main_post_function(Func&& func) const noexcept
+{
+    return loop::main().post_function(std::forward<Func>(func));
+}
+
+template<typename R, typename... Args>
+template<forward_of<void()> Func>
+void notifier<R(Args...)>::loop_timer_post_function(Func&& func) const noexcept
+{
+    return loop::timer().post_function(std::forward<Func>(func));
+}
+
+} // namespace hi::inline v1
@@ -0,0 +1,94 @@
+// Copyright Take Vos 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include "dispatch.hpp"
+#include <hikotest/hikotest.hpp>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#if HI_OPERATING_SYSTEM == HI_OS_LINUX
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+TEST_SUITE(loop_suite) {
+
+TEST_CASE(post_function_from_other_thread)
+{
+    using namespace std::chrono_literals;
+
+    auto loop_ptr = std::atomic<hi::loop *>{nullptr};
+    auto thread = std::jthread{[&](std::stop_token stop_token) {
+        loop_ptr.store(std::addressof(hi::loop::local()));
+        hi::loop::local().resume(stop_token);
+    }};
+
+    while (loop_ptr.load() == nullptr) {
+        std::this_thread::yield();
+    }
+
+    // Posting must wake up the blocked loop, well before it would wake up by itself.
+    auto const start = std::chrono::steady_clock::now();
+    auto done = std::atomic<bool>{false};
+    loop_ptr.load()->post_function([&] {
+        done.store(true);
+    });
+
+    while (not done.load()) {
+        std::this_thread::yield();
+    }
+    REQUIRE(std::chrono::steady_clock::now() - start < 50ms);
+
+    thread.request_stop();
+    thread.join();
+}
+
+TEST_CASE(delay_function)
+{
+    using namespace std::chrono_literals;
+
+    auto called = false;
+    auto const cbt = hi::loop::local().delay_function(std::chrono::utc_clock::now() + 10ms, [&] {
+        called = true;
+    });
+
+    hi::loop::local().resume_once();
+    REQUIRE(not called);
+
+    while (not called) {
+        hi::loop::local().resume_once(true);
+    }
+}
+
+#if HI_OPERATING_SYSTEM == HI_OS_LINUX
+TEST_CASE(socket_read_close)
+{
+    int fds[2];
+    REQUIRE(socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds) == 0);
+
+    auto events = hi::socket_event::none;
+    hi::loop::local().add_socket(fds[0], hi::socket_event::read | hi::socket_event::close, [&](int fd, hi::socket_events const& e) {
+        char buffer[16];
+        while (::read(fd, buffer, sizeof(buffer)) > 0) {}
+
+        events |= e.events;
+        if (to_bool(e.events & hi::socket_event::close)) {
+            hi::loop::local().remove_socket(fd);
+        }
+    });
+
+    REQUIRE(::write(fds[1], "x", 1) == 1);
+    while (not to_bool(events & hi::socket_event::read)) {
+        hi::loop::local().resume_once(true);
+    }
+
+    ::close(fds[1]);
+    while (not to_bool(events & hi::socket_event::close)) {
+        hi::loop::local().resume_once(true);
+    }
+    ::close(fds[0]);
+}
+#endif
+
+}; // TEST_SUITE(loop_suite)
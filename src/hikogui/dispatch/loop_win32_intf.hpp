@@ -24,6 +24,7 @@
 #include <memory>
 #include <chrono>
 #include <thread>
+#include <atomic>
 
 hi_export_module(hikogui.dispatch : loop_intf);
 
@@ -195,11 +196,13 @@ public:
      *
      * @param time_point The time at which to call the function.
      * @param func The function to be called.
+     * @param tolerance The amount of time the call may be delayed to coalesce it with other timers.
      */
     template<forward_of<void()> Func>
-    [[nodiscard]] callback<void()> delay_function(utc_nanoseconds time_point, Func&& func) noexcept
+    [[nodiscard]] callback<void()>
+    delay_function(utc_nanoseconds time_point, Func&& func, std::chrono::nanoseconds tolerance = {}) noexcept
     {
-        auto [callback, first_to_call] = _function_timer.delay_function(time_point, std::forward<Func>(func));
+        auto [callback, first_to_call] = _function_timer.delay_function(time_point, std::forward<Func>(func), tolerance);
         if (first_to_call) {
             // Notify if the added function is the next function to call.
             notify_has_send();
@@ -212,12 +215,16 @@ public:
      * @param period The period between calls to the function.
      * @param time_point The time at which to call the function.
      * @param func The function to be called.
+     * @param tolerance The amount of time each call may be delayed to coalesce it with other timers.
      */
     template<forward_of<void()> Func>
-    [[nodiscard]] callback<void()>
-    repeat_function(std::chrono::nanoseconds period, utc_nanoseconds time_point, Func&& func) noexcept
+    [[nodiscard]] callback<void()> repeat_function(
+        std::chrono::nanoseconds period,
+        utc_nanoseconds time_point,
+        Func&& func,
+        std::chrono::nanoseconds tolerance = {}) noexcept
     {
-        auto [callback, first_to_call] = _function_timer.repeat_function(period, time_point, std::forward<Func>(func));
+        auto [callback, first_to_call] = _function_timer.repeat_function(period, time_point, std::forward<Func>(func), tolerance);
         if (first_to_call) {
             // Notify if the added function is the next function to call.
             notify_has_send();
@@ -229,11 +236,13 @@ public:
      *
      * @param period The period between calls to the function.
      * @param func The function to be called.
+     * @param tolerance The amount of time each call may be delayed to coalesce it with other timers.
      */
     template<forward_of<void()> Func>
-    [[nodiscard]] callback<void()> repeat_function(std::chrono::nanoseconds period, Func&& func) noexcept
+    [[nodiscard]] callback<void()>
+    repeat_function(std::chrono::nanoseconds period, Func&& func, std::chrono::nanoseconds tolerance = {}) noexcept
     {
-        auto [callback, first_to_call] = _function_timer.repeat_function(period, std::forward<Func>(func));
+        auto [callback, first_to_call] = _function_timer.repeat_function(period, std::forward<Func>(func), tolerance);
         if (first_to_call) {
             // Notify if the added function is the next function to call.
             notify_has_send();
@@ -296,6 +305,28 @@ public:
         hi_not_implemented();
     }
 
+    /** Keep the loop running while an asynchronous operation is in flight.
+     *
+     * A co-routine that waits on work executed on another thread is not
+     * otherwise visible to the loop, so `resume()` without a stop token
+     * would exit before the co-routine is resumed.
+     *
+     * Each call must be paired with a call to `remove_pending()`.
+     * This function may be called from any thread.
+     */
+    void add_pending() noexcept
+    {
+        _num_pending.fetch_add(1, std::memory_order::relaxed);
+    }
+
+    /** The asynchronous operation that was added with `add_pending()` has completed.
+     */
+    void remove_pending() noexcept
+    {
+        hi_axiom(_num_pending.load(std::memory_order::relaxed) != 0);
+        _num_pending.fetch_sub(1, std::memory_order::relaxed);
+    }
+
     /** Resume the loop on the current thread.
      *
      * @param stop_token The thread's stop token to use to determine when to stop.
@@ -333,7 +364,7 @@ public:
                 }
             } else {
                 if (_render_functions.empty() and _function_fifo.empty() and _function_timer.empty() and
-                    _handles.size() <= _socket_handle_idx) {
+                    _handles.size() <= _socket_handle_idx and _num_pending.load(std::memory_order::relaxed) == 0) {
                     // If there is not stop token, then exit when there are no more resources to wait on.
                     _exit_code = 0;
                 }
@@ -491,6 +522,10 @@ private:
     function_timer _function_timer;
 
     std::optional<int> _exit_code = {};
+
+    /** The number of asynchronous operations in flight, see `add_pending()`.
+     */
+    std::atomic<std::size_t> _num_pending = 0;
     double _maximum_frame_rate = 30.0;
     std::chrono::nanoseconds _minimum_frame_time = std::chrono::nanoseconds(33'333'333);
     thread_id _thread_id;
@@ -12,6 +12,8 @@
 #include <functional>
 #include <coroutine>
 #include <mutex>
+#include <memory>
+#include <atomic>
 
 hi_export_module(hikogui.dispatch : notifier);
 
@@ -148,8 +150,12 @@ public:
     [[nodiscard]] callback_type subscribe(Func&& func, callback_flags flags = callback_flags::synchronous) noexcept
     {
         auto callback = callback_type{std::forward<Func>(func)};
+        auto called = is_once(flags) ? std::make_shared<std::atomic<bool>>(false) : nullptr;
+
         auto const lock = std::scoped_lock(_mutex);
-        _callbacks.emplace_back(callback, flags);
+        auto new_callbacks = clean_copy();
+        new_callbacks.emplace_back(callback, flags, std::move(called));
+        _callbacks.emplace(std::move(new_callbacks));
         return callback;
     }
 
@@ -162,14 +168,29 @@ public:
 
     /** Call the subscribed callbacks with the given arguments.
      *
-     * @note This function is not reentrant.
+     * The list of callbacks is read through RCU, so this function is
+     * wait-free with respect to `subscribe()` and other threads calling
+     * the notifier, and it may be called from within a callback.
+     *
      * @param args The arguments to pass with the invocation of the callback
      */
     void operator()(Args... args) const noexcept
     {
-        auto const lock = std::scoped_lock(_mutex);
+        auto const lock = std::scoped_lock(_callbacks);
+
+        auto const *callbacks = _callbacks.get();
+        if (callbacks == nullptr) {
+            return;
+        }
+
+        for (auto const& [callback, flags, called] : *callbacks) {
+            // If the callback should only be triggered once, like inside an awaitable,
+            // then only the first thread that gets here calls it. The entry is
+            // removed on the next `subscribe()`.
+            if (called and called->exchange(true, std::memory_order::relaxed)) {
+                continue;
+            }
 
-        for (auto& [callback, flags] : _callbacks) {
             if (is_synchronous(flags)) {
                 if (auto cb = callback.lock()) {
                     cb(std::forward<Args>(args)...);
@@ -211,33 +232,49 @@ public:
             } else {
                 hi_no_default();
             }
-
-            // If the callback should only be triggered once, like inside an awaitable.
-            // Then reset the weak_ptr in _callbacks so that it will be cleaned up.
-            // In the lambda above the weak_ptr is copied first so that it callback will get executed
-            // as long as the shared_ptr's use count does not go to zero.
-            if (is_once(flags)) {
-                callback.reset();
-            }
         }
-        clean_up();
     }
 
 private:
+    struct callback_entry_type {
+        weak_callback_type callback;
+        callback_flags flags;
+
+        /** Set when a callback with the `once` flag has been called.
+         *
+         * This is shared between the copies of the list, so that it
+         * survives a `subscribe()` while the notifier is being called.
+         */
+        std::shared_ptr<std::atomic<bool>> called;
+    };
+
+    using callbacks_type = std::vector<callback_entry_type>;
+
+    /** Serializes the writers of `_callbacks`.
+     */
     mutable unfair_mutex _mutex;
 
     /** A list of callbacks and it's associated token.
      */
-    mutable std::vector<std::pair<weak_callback_type, callback_flags>> _callbacks;
+    rcu<callbacks_type> _callbacks;
 
-    void clean_up() const noexcept
+    /** Copy the list of callbacks, without the callbacks that have expired or were called once.
+     */
+    [[nodiscard]] callbacks_type clean_copy() const noexcept
     {
         hi_axiom(_mutex.is_locked());
 
-        // Cleanup all callbacks that have expired, or when they may only be triggered once.
-        std::erase_if(_callbacks, [](auto const& item) {
-            return item.first.expired();
-        });
+        auto r = callbacks_type{};
+        // Only writers replace the list, so it can be read without the rcu lock.
+        if (auto const *callbacks = _callbacks.get()) {
+            r.reserve(callbacks->size() + 1);
+            for (auto const& item : *callbacks) {
+                if (not item.callback.expired() and not(item.called and item.called->load(std::memory_order::relaxed))) {
+                    r.push_back(item);
+                }
+            }
+        }
+        return r;
     }
 
 #ifndef NDEBUG
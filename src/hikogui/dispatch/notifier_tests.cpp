@@ -6,9 +6,14 @@
 #include "task.hpp"
 #if HI_OPERATING_SYSTEM == HI_OS_WINDOWS
 #include "loop_win32_intf.hpp"
+#elif HI_OPERATING_SYSTEM == HI_OS_LINUX
+#include "loop_linux_intf.hpp"
 #endif
 #include <hikotest/hikotest.hpp>
 #include <coroutine>
+#include <thread>
+#include <atomic>
+#include <vector>
 
 TEST_SUITE(notifier) {
 
@@ -112,4 +117,91 @@ TEST_CASE(local_coroutine)
     REQUIRE(cr.done());
 }
 
+TEST_CASE(synchronous_once)
+{
+    auto a = 0;
+    auto b = 0;
+
+    auto n = hi::notifier{};
+
+    auto a_cbt = n.subscribe(
+        [&] {
+            ++a;
+        },
+        hi::callback_flags::synchronous | hi::callback_flags::once);
+
+    n();
+    n();
+    REQUIRE(a == 1);
+
+    // Subscribing removes the callback that was already called.
+    auto b_cbt = n.subscribe([&] {
+        ++b;
+    });
+    n();
+    REQUIRE(a == 1);
+    REQUIRE(b == 1);
+}
+
+TEST_CASE(subscribe_from_callback)
+{
+    auto a = 0;
+    auto b = 0;
+
+    auto n = hi::notifier{};
+
+    auto b_cbt = hi::callback<void()>{};
+    auto a_cbt = n.subscribe([&] {
+        ++a;
+        if (not b_cbt) {
+            b_cbt = n.subscribe([&] {
+                ++b;
+            });
+        }
+    });
+
+    // A callback added while notifying is called on the next notification.
+    n();
+    REQUIRE(a == 1);
+    REQUIRE(b == 0);
+
+    n();
+    REQUIRE(a == 2);
+    REQUIRE(b == 1);
+}
+
+TEST_CASE(synchronous_concurrent)
+{
+    auto n = hi::notifier{};
+
+    auto count = std::atomic<int>{0};
+    auto a_cbt = n.subscribe([&] {
+        count.fetch_add(1, std::memory_order::relaxed);
+    });
+
+    auto stop = std::atomic<bool>{false};
+    auto threads = std::vector<std::thread>{};
+    for (auto i = 0; i != 4; ++i) {
+        threads.emplace_back([&] {
+            while (not stop.load(std::memory_order::relaxed)) {
+                n();
+            }
+        });
+    }
+
+    // Subscribe and unsubscribe while the other threads are notifying.
+    for (auto i = 0; i != 1000; ++i) {
+        auto b_cbt = n.subscribe([] {});
+    }
+
+    stop.store(true, std::memory_order::relaxed);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    auto const num_calls = count.load();
+    n();
+    REQUIRE(count.load() == num_calls + 1);
+}
+
 };
@@ -0,0 +1,85 @@
+// Copyright Take Vos 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include "socket_event_intf.hpp"
+#include "../utility/utility.hpp"
+#include "../macros.hpp"
+#include <sys/epoll.h>
+#include <cerrno>
+#include <cstdint>
+
+hi_export_module(hikogui.dispatch.socket_event : impl);
+
+hi_export namespace hi::inline v1 {
+
+/** Convert a socket_event mask to the events to wait for with epoll.
+ *
+ * epoll reports readiness instead of state changes; `accept` is reported
+ * as a socket being ready for read and `connect` as a socket being ready
+ * for write.
+ */
+[[nodiscard]] constexpr uint32_t socket_event_to_epoll(socket_event rhs) noexcept
+{
+    uint32_t r = 0;
+
+    r |= to_bool(rhs & (socket_event::read | socket_event::accept)) ? EPOLLIN : 0;
+    r |= to_bool(rhs & (socket_event::write | socket_event::connect)) ? EPOLLOUT : 0;
+    r |= to_bool(rhs & socket_event::close) ? EPOLLRDHUP : 0;
+    r |= to_bool(rhs & socket_event::out_of_band) ? EPOLLPRI : 0;
+
+    return r;
+}
+
+[[nodiscard]] constexpr socket_error socket_error_from_errno(int rhs) noexcept
+{
+    switch (rhs) {
+    case 0: return socket_error::success;
+    case EAFNOSUPPORT: return socket_error::af_not_supported;
+    case ECONNREFUSED: return socket_error::connection_refused;
+    case ENETUNREACH: return socket_error::network_unreachable;
+    case EHOSTUNREACH: return socket_error::network_unreachable;
+    case ENOBUFS: return socket_error::no_buffers;
+    case ETIMEDOUT: return socket_error::timeout;
+    case ENETDOWN: return socket_error::network_down;
+    case ECONNRESET: return socket_error::connection_reset;
+    case EPIPE: return socket_error::connection_reset;
+    // Unlike WSAEnumNetworkEvents(), SO_ERROR may return any errno value.
+    default: return socket_error::connection_aborted;
+    }
+}
+
+/** Convert the events returned by epoll to socket_events.
+ *
+ * @param rhs The events returned by epoll_wait().
+ * @param event_mask The events that where requested with add_socket().
+ * @param error The error retrieved with SO_ERROR when epoll returned EPOLLERR.
+ */
+[[nodiscard]] constexpr socket_events socket_events_from_epoll(uint32_t rhs, socket_event event_mask, int error) noexcept
+{
+    auto r = socket_events{};
+
+    auto events = socket_event::none;
+    events |= (rhs & EPOLLIN) ? socket_event::read | socket_event::accept : socket_event::none;
+    events |= (rhs & EPOLLOUT) ? socket_event::write | socket_event::connect : socket_event::none;
+    events |= (rhs & EPOLLPRI) ? socket_event::out_of_band : socket_event::none;
+    r.events = events & event_mask;
+
+    // A hang-up is always reported, so that the callback can remove the socket.
+    r.events |= (rhs & (EPOLLRDHUP | EPOLLHUP | EPOLLERR)) ? socket_event::close : socket_event::none;
+
+    if (rhs & EPOLLERR) {
+        auto const error_ = socket_error_from_errno(error);
+        for (auto i = 0_uz; i != socket_event_max; ++i) {
+            if (to_bool(r.events & static_cast<socket_event>(1 << i))) {
+                r.errors[i] = error_;
+            }
+        }
+    }
+
+    return r;
+}
+
+} // namespace hi::inline v1
@@ -0,0 +1,279 @@
+// Copyright Take Vos 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include "awaitable.hpp"
+#if HI_OPERATING_SYSTEM == HI_OS_WINDOWS
+#include "loop_win32_intf.hpp"
+#elif HI_OPERATING_SYSTEM == HI_OS_LINUX
+#include "loop_linux_intf.hpp"
+#endif
+#include "../concurrency/concurrency.hpp"
+#include "../concurrency/unfair_mutex.hpp" // XXX #616
+#include "../concurrency/thread.hpp" // XXX #616
+#include "../utility/utility.hpp"
+#include "../macros.hpp"
+#include <coroutine>
+#include <functional>
+#include <type_traits>
+#include <exception>
+#include <optional>
+#include <variant>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <deque>
+#include <vector>
+#include <mutex>
+#include <format>
+
+hi_export_module(hikogui.dispatch.thread_pool);
+
+hi_export namespace hi::inline v1 {
+
+/** A fixed-size work-stealing thread pool.
+ *
+ * Each worker thread owns a deque of jobs. A worker takes jobs from the
+ * back of its own deque, and when that is empty steals jobs from the front
+ * of the deques of the other workers. Jobs submitted by a worker are
+ * added to its own deque; jobs submitted by other threads are distributed
+ * round-robin over the workers.
+ *
+ * Idle workers sleep on the number of queued jobs, so that an idle pool
+ * does not use any CPU time.
+ *
+ * @note Jobs that block for a long time reduce the capacity of the pool.
+ */
+class thread_pool {
+public:
+    using job_type = std::function<void()>;
+
+    thread_pool(thread_pool const&) = delete;
+    thread_pool(thread_pool&&) = delete;
+    thread_pool& operator=(thread_pool const&) = delete;
+    thread_pool& operator=(thread_pool&&) = delete;
+
+    /** Create a thread pool.
+     *
+     * @param num_workers The number of worker threads.
+     */
+    explicit thread_pool(std::size_t num_workers) : _num_workers(num_workers), _workers(std::make_unique<worker_type[]>(num_workers))
+    {
+        hi_assert(num_workers != 0);
+
+        _threads.reserve(num_workers);
+        for (auto i = 0_uz; i != num_workers; ++i) {
+            _threads.emplace_back([this, i] {
+                set_thread_name(std::format("pool {}", i));
+                run(i);
+            });
+        }
+    }
+
+    /** Create a thread pool with a worker for each CPU.
+     */
+    thread_pool() : thread_pool(std::max(std::thread::hardware_concurrency(), 2U)) {}
+
+    /** Stop the thread pool.
+     *
+     * Jobs that are still queued are executed before the worker threads exit.
+     */
+    ~thread_pool()
+    {
+        _stop.store(true, std::memory_order::relaxed);
+        _num_jobs.fetch_add(1, std::memory_order::release);
+        _num_jobs.notify_all();
+
+        for (auto& thread : _threads) {
+            thread.join();
+        }
+    }
+
+    /** The thread pool used by `async_task()`.
+     */
+    [[nodiscard]] static thread_pool& global() noexcept;
+
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return _num_workers;
+    }
+
+    /** Submit a job to be executed on one of the worker threads.
+     *
+     * @param job The job to execute, it must not throw.
+     */
+    void submit(job_type job) noexcept
+    {
+        auto const index = _current == this ? _current_index : _next_worker.fetch_add(1, std::memory_order::relaxed) % _num_workers;
+
+        // Count the job before it is published, so that a worker that takes
+        // it can not decrement the count below zero.
+        _num_jobs.fetch_add(1, std::memory_order::relaxed);
+
+        auto& worker = _workers[index];
+        {
+            auto const lock = std::scoped_lock(worker.mutex);
+            worker.jobs.push_back(std::move(job));
+        }
+
+        _num_jobs.notify_one();
+    }
+
+private:
+    struct worker_type {
+        unfair_mutex mutex;
+        std::deque<job_type> jobs;
+    };
+
+    std::size_t _num_workers;
+    std::unique_ptr<worker_type[]> _workers;
+    std::vector<std::thread> _threads;
+
+    /** The number of jobs in all the deques, the idle workers wait on this value.
+     */
+    std::atomic<std::size_t> _num_jobs = 0;
+
+    std::atomic<std::size_t> _next_worker = 0;
+    std::atomic<bool> _stop = false;
+
+    /** The pool that owns the current thread, if any.
+     */
+    inline static thread_local thread_pool *_current = nullptr;
+
+    /** The index of the worker of the current thread.
+     */
+    inline static thread_local std::size_t _current_index = 0;
+
+    [[nodiscard]] std::optional<job_type> pop(std::size_t index) noexcept
+    {
+        {
+            auto& worker = _workers[index];
+            auto const lock = std::scoped_lock(worker.mutex);
+            if (not worker.jobs.empty()) {
+                auto r = std::move(worker.jobs.back());
+                worker.jobs.pop_back();
+                return r;
+            }
+        }
+
+        for (auto i = 1_uz; i != _num_workers; ++i) {
+            auto& victim = _workers[(index + i) % _num_workers];
+            auto const lock = std::scoped_lock(victim.mutex);
+            if (not victim.jobs.empty()) {
+                auto r = std::move(victim.jobs.front());
+                victim.jobs.pop_front();
+                return r;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    void run(std::size_t index) noexcept
+    {
+        _current = this;
+        _current_index = index;
+
+        while (true) {
+            if (auto job = pop(index)) {
+                _num_jobs.fetch_sub(1, std::memory_order::relaxed);
+                (*job)();
+
+            } else if (_stop.load(std::memory_order::relaxed)) {
+                return;
+
+            } else if (_num_jobs.load(std::memory_order::acquire) == 0) {
+                _num_jobs.wait(0, std::memory_order::acquire);
+
+            } else {
+                // A job was counted but not yet found, it is being added or was just taken.
+                std::this_thread::yield();
+            }
+        }
+    }
+};
+
+namespace detail {
+inline std::unique_ptr<thread_pool> thread_pool_global = nullptr;
+}
+
+inline thread_pool& thread_pool::global() noexcept
+{
+    if (not detail::thread_pool_global) {
+        detail::thread_pool_global = std::make_unique<thread_pool>();
+    }
+    return *detail::thread_pool_global;
+}
+
+/** Awaitable that executes a function on the thread pool.
+ *
+ * The co-routine is resumed on the loop of the thread on which it was
+ * suspended, directly when the function completes.
+ *
+ * @tparam Func The type of the function to execute.
+ */
+template<std::invocable Func>
+class awaitable_thread_pool {
+public:
+    using result_type = std::invoke_result_t<Func>;
+
+    awaitable_thread_pool(awaitable_thread_pool const&) = delete;
+    awaitable_thread_pool(awaitable_thread_pool&&) = delete;
+    awaitable_thread_pool& operator=(awaitable_thread_pool const&) = delete;
+    awaitable_thread_pool& operator=(awaitable_thread_pool&&) = delete;
+
+    awaitable_thread_pool(Func func, thread_pool& pool = thread_pool::global()) noexcept : _function(std::move(func)), _pool(pool)
+    {
+    }
+
+    [[nodiscard]] bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) noexcept
+    {
+        auto const loop_ptr = std::addressof(loop::local());
+        loop_ptr->add_pending();
+
+        _pool.submit([this, handle, loop_ptr] {
+            try {
+                if constexpr (std::is_void_v<result_type>) {
+                    std::invoke(_function);
+                    _result.template emplace<1>();
+                } else {
+                    _result.template emplace<1>(std::invoke(_function));
+                }
+            } catch (...) {
+                _result.template emplace<2>(std::current_exception());
+            }
+
+            loop_ptr->post_function([handle, loop_ptr] {
+                loop_ptr->remove_pending();
+                handle.resume();
+            });
+        });
+    }
+
+    result_type await_resume()
+    {
+        if (_result.index() == 2) {
+            std::rethrow_exception(std::get<2>(_result));
+        }
+
+        if constexpr (not std::is_void_v<result_type>) {
+            return std::move(std::get<1>(_result));
+        }
+    }
+
+private:
+    using value_type = std::conditional_t<std::is_void_v<result_type>, std::monostate, result_type>;
+
+    Func _function;
+    thread_pool& _pool;
+    std::variant<std::monostate, value_type, std::exception_ptr> _result;
+};
+
+} // namespace hi::inline v1
@@ -0,0 +1,90 @@
+// Copyright Take Vos 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include "dispatch.hpp"
+#include <hikotest/hikotest.hpp>
+#include <atomic>
+#include <thread>
+#include <stdexcept>
+
+TEST_SUITE(thread_pool_suite) {
+
+TEST_CASE(submit_test)
+{
+    auto pool = hi::thread_pool{4};
+
+    auto count = std::atomic<int>{0};
+    for (auto i = 0; i != 10'000; ++i) {
+        pool.submit([&] {
+            count.fetch_add(1, std::memory_order::relaxed);
+        });
+    }
+
+    while (count.load() != 10'000) {
+        std::this_thread::yield();
+    }
+}
+
+TEST_CASE(submit_from_worker_test)
+{
+    auto pool = hi::thread_pool{4};
+
+    // A single job spawns all other jobs on its own worker, the other workers must steal them.
+    auto count = std::atomic<int>{0};
+    pool.submit([&] {
+        for (auto i = 0; i != 1'000; ++i) {
+            pool.submit([&] {
+                std::this_thread::sleep_for(std::chrono::microseconds(10));
+                count.fetch_add(1, std::memory_order::relaxed);
+            });
+        }
+    });
+
+    while (count.load() != 1'000) {
+        std::this_thread::yield();
+    }
+}
+
+static hi::task<hi::thread_id> resume_thread_task(hi::thread_id *worker_id)
+{
+    auto job = [worker_id] {
+        *worker_id = hi::current_thread_id();
+    };
+    co_await hi::awaitable_thread_pool{std::move(job)};
+    co_return hi::current_thread_id();
+}
+
+TEST_CASE(resume_on_loop_test)
+{
+    auto worker_id = hi::thread_id{};
+    auto t = resume_thread_task(&worker_id);
+
+    while (not t.done()) {
+        hi::loop::local().resume_once(true);
+    }
+
+    REQUIRE(worker_id != hi::current_thread_id());
+    REQUIRE(t.value() == hi::current_thread_id());
+}
+
+static hi::task<int> throw_task()
+{
+    auto job = []() -> int {
+        throw std::runtime_error("thread_pool");
+    };
+    co_return co_await hi::awaitable_thread_pool{std::move(job)};
+}
+
+TEST_CASE(exception_test)
+{
+    auto t = throw_task();
+
+    while (not t.done()) {
+        hi::loop::local().resume_once(true);
+    }
+
+    REQUIRE_THROWS(t.value(), std::runtime_error);
+}
+
+}; // TEST_SUITE(thread_pool_suite)
@@ -0,0 +1,11 @@
+// Copyright Take Vos 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+hi_export_module(hikogui.file.async_file);
+
+#if HI_OPERATING_SYSTEM == HI_OS_LINUX
+#include "async_file_linux_intf.hpp" // export
+#endif
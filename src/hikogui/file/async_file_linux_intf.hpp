@@ -0,0 +1,820 @@
+// Copyright Take Vos 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+/** @file file/async_file_linux_intf.hpp Asynchronous file I/O for co-routines.
+ * @ingroup file
+ */
+
+#pragma once
+
+#include "access_mode.hpp"
+#include "../dispatch/dispatch.hpp"
+#include "../container/container.hpp"
+#include "../telemetry/telemetry.hpp"
+#include "../concurrency/concurrency.hpp"
+#include "../concurrency/thread.hpp" // XXX #616
+#include "../utility/utility.hpp"
+#include "../macros.hpp"
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <coroutine>
+#include <filesystem>
+#include <condition_variable>
+#include <stop_token>
+#include <thread>
+#include <mutex>
+#include <deque>
+#include <vector>
+#include <string>
+#include <span>
+#include <memory>
+#include <atomic>
+#include <algorithm>
+#include <format>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+
+hi_export_module(hikogui.file.async_file : intf);
+
+hi_export namespace hi::inline v1 {
+namespace detail {
+
+enum class async_file_op : uint8_t { nop, open, read, write, fsync, close };
+
+/** A group of requests which resumes a co-routine when all are completed.
+ */
+struct async_file_batch {
+    std::atomic<std::size_t> remaining = 0;
+    loop *loop_ptr = nullptr;
+    std::coroutine_handle<> handle = {};
+
+    /** Called by the I/O service after each completed request.
+     *
+     * The co-routine is resumed on the loop of the thread that suspended it,
+     * and the pending operation that was added to that loop is removed.
+     */
+    void complete_one() noexcept
+    {
+        if (remaining.fetch_sub(1, std::memory_order::acq_rel) == 1) {
+            loop_ptr->post_function([handle = handle, loop_ptr = loop_ptr] {
+                loop_ptr->remove_pending();
+                handle.resume();
+            });
+        }
+    }
+};
+
+struct async_file_request {
+    async_file_op op = async_file_op::nop;
+    int fd = -1;
+    int flags = 0;
+    mode_t mode = 0;
+
+    /** The path for `open`; must stay valid until completion.
+     */
+    char const *path = nullptr;
+
+    void *data = nullptr;
+    uint32_t size = 0;
+    uint64_t offset = 0;
+
+    /** The result, on success a positive value; on failure `-errno`.
+     */
+    int64_t result = 0;
+
+    async_file_batch *batch = nullptr;
+
+    [[nodiscard]] std::string error_message() const
+    {
+        return get_last_error_message(narrow_cast<uint32_t>(-result));
+    }
+};
+
+[[nodiscard]] constexpr int access_mode_to_open_flags(access_mode rhs) noexcept
+{
+    auto r = O_CLOEXEC;
+
+    if (to_bool(rhs & access_mode::read) and to_bool(rhs & access_mode::write)) {
+        r |= O_RDWR;
+    } else if (to_bool(rhs & access_mode::write)) {
+        r |= O_WRONLY;
+    } else {
+        r |= O_RDONLY;
+    }
+
+    if (to_bool(rhs & access_mode::create)) {
+        r |= to_bool(rhs & access_mode::open) ? O_CREAT : O_CREAT | O_EXCL;
+    }
+    if (to_bool(rhs & access_mode::truncate)) {
+        r |= O_TRUNC;
+    }
+    if (to_bool(rhs & access_mode::write_through)) {
+        r |= O_DSYNC;
+    }
+
+    return r;
+}
+
+} // namespace detail
+
+/** The service that executes asynchronous file requests.
+ * @ingroup file
+ *
+ * Requests are submitted to the kernel through io_uring, so that a whole
+ * batch of requests is submitted with a single system call. A dedicated
+ * thread reaps completions and hands the co-routine back to its loop.
+ *
+ * When io_uring is not available (old kernel, disabled by
+ * `kernel.io_uring_disabled` or a seccomp filter) the requests are executed
+ * as blocking system calls on a small pool of threads.
+ */
+class async_file_service {
+public:
+    async_file_service(async_file_service const&) = delete;
+    async_file_service(async_file_service&&) = delete;
+    async_file_service& operator=(async_file_service const&) = delete;
+    async_file_service& operator=(async_file_service&&) = delete;
+
+    /** Create the service.
+     *
+     * @param allow_io_uring When false always use the thread-pool.
+     */
+    explicit async_file_service(bool allow_io_uring = true)
+    {
+        if (not allow_io_uring or not io_uring_init()) {
+            pool_init();
+        }
+    }
+
+    ~async_file_service()
+    {
+        if (_ring_fd != -1) {
+            _stop.store(true, std::memory_order::relaxed);
+
+            // Wake up the completion thread with a no-op with a null user_data.
+            auto request = detail::async_file_request{};
+            io_uring_submit(std::span{&request, 1});
+            _completion_thread.join();
+
+            ::munmap(_sqes, _sqes_size);
+            ::munmap(_ring_ptr, _ring_size);
+            ::close(_ring_fd);
+
+        } else {
+            for (auto& thread : _pool_threads) {
+                thread.request_stop();
+            }
+            _pool_cv.notify_all();
+        }
+    }
+
+    [[nodiscard]] static async_file_service& global() noexcept;
+
+    [[nodiscard]] bool uses_io_uring() const noexcept
+    {
+        return _ring_fd != -1;
+    }
+
+    /** Submit requests.
+     *
+     * `batch.complete_one()` is called for each request when it completes,
+     * possibly from a different thread.
+     *
+     * @param requests The requests, which must stay alive until completed.
+     * @param batch The batch to notify for each completed request.
+     */
+    void submit(std::span<detail::async_file_request> requests, detail::async_file_batch& batch) noexcept
+    {
+        for (auto& request : requests) {
+            request.batch = std::addressof(batch);
+        }
+
+        if (_ring_fd != -1) {
+            io_uring_submit(requests);
+
+        } else {
+            {
+                auto const lock = std::scoped_lock(_pool_mutex);
+                for (auto& request : requests) {
+                    _pool_queue.push_back(std::addressof(request));
+                }
+            }
+            _pool_cv.notify_all();
+        }
+    }
+
+private:
+    constexpr static uint32_t ring_entries = 256;
+
+    int _ring_fd = -1;
+    void *_ring_ptr = nullptr;
+    io_uring_sqe *_sqes = nullptr;
+    std::size_t _ring_size = 0;
+    std::size_t _sqes_size = 0;
+
+    uint32_t *_sq_head = nullptr;
+    uint32_t *_sq_tail = nullptr;
+    uint32_t *_sq_array = nullptr;
+    uint32_t _sq_mask = 0;
+    uint32_t _sq_entries = 0;
+
+    uint32_t *_cq_head = nullptr;
+    uint32_t *_cq_tail = nullptr;
+    io_uring_cqe *_cqes = nullptr;
+    uint32_t _cq_mask = 0;
+
+    /** Serializes writes to the submission queue.
+     */
+    unfair_mutex _sq_mutex;
+
+    std::thread _completion_thread;
+    std::atomic<bool> _stop = false;
+
+    std::mutex _pool_mutex;
+    std::condition_variable_any _pool_cv;
+    std::deque<detail::async_file_request *> _pool_queue;
+    std::vector<std::jthread> _pool_threads;
+
+    static int io_uring_setup(uint32_t entries, io_uring_params *params) noexcept
+    {
+        return narrow_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+    }
+
+    static int io_uring_enter(int fd, uint32_t to_submit, uint32_t min_complete, uint32_t flags) noexcept
+    {
+        return narrow_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+    }
+
+    [[nodiscard]] bool io_uring_init() noexcept
+    {
+        auto params = io_uring_params{};
+        params.flags = IORING_SETUP_CQSIZE;
+        params.cq_entries = ring_entries * 4;
+
+        auto const fd = io_uring_setup(ring_entries, &params);
+        if (fd == -1) {
+            hi_log_info("io_uring is not available, using a thread-pool for async file I/O. {}", get_last_error_message());
+            return false;
+        }
+
+        // IORING_FEAT_RW_CUR_POS was introduced together with the openat, close and read operations.
+        constexpr auto required_features = IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP | IORING_FEAT_RW_CUR_POS;
+        if ((params.features & required_features) != required_features) {
+            hi_log_info("io_uring is missing features, using a thread-pool for async file I/O.");
+            ::close(fd);
+            return false;
+        }
+
+        // With IORING_FEAT_SINGLE_MMAP the submission and completion rings share a single mapping.
+        _ring_size = std::max(
+            params.sq_off.array + params.sq_entries * sizeof(uint32_t),
+            params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+        _sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+
+        _ring_ptr = ::mmap(nullptr, _ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+        if (_ring_ptr == MAP_FAILED) {
+            hi_log_error("Could not map the io_uring rings. {}", get_last_error_message());
+            ::close(fd);
+            return false;
+        }
+
+        auto const sqes = ::mmap(nullptr, _sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+        if (sqes == MAP_FAILED) {
+            hi_log_error("Could not map the io_uring submission entries. {}", get_last_error_message());
+            ::munmap(_ring_ptr, _ring_size);
+            ::close(fd);
+            return false;
+        }
+        _sqes = static_cast<io_uring_sqe *>(sqes);
+
+        auto const ring = static_cast<char *>(_ring_ptr);
+        _sq_head = reinterpret_cast<uint32_t *>(ring + params.sq_off.head);
+        _sq_tail = reinterpret_cast<uint32_t *>(ring + params.sq_off.tail);
+        _sq_array = reinterpret_cast<uint32_t *>(ring + params.sq_off.array);
+        _sq_mask = *reinterpret_cast<uint32_t *>(ring + params.sq_off.ring_mask);
+        _sq_entries = *reinterpret_cast<uint32_t *>(ring + params.sq_off.ring_entries);
+
+        _cq_head = reinterpret_cast<uint32_t *>(ring + params.cq_off.head);
+        _cq_tail = reinterpret_cast<uint32_t *>(ring + params.cq_off.tail);
+        _cqes = reinterpret_cast<io_uring_cqe *>(ring + params.cq_off.cqes);
+        _cq_mask = *reinterpret_cast<uint32_t *>(ring + params.cq_off.ring_mask);
+
+        _ring_fd = fd;
+        _completion_thread = std::thread{[this] {
+            set_thread_name("async_file");
+            io_uring_complete();
+        }};
+        return true;
+    }
+
+    static void io_uring_prepare(io_uring_sqe& sqe, detail::async_file_request& request) noexcept
+    {
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.user_data = std::bit_cast<uint64_t>(std::addressof(request));
+
+        switch (request.op) {
+        case detail::async_file_op::nop:
+            sqe.opcode = IORING_OP_NOP;
+            sqe.user_data = 0;
+            break;
+        case detail::async_file_op::open:
+            sqe.opcode = IORING_OP_OPENAT;
+            sqe.fd = AT_FDCWD;
+            sqe.addr = std::bit_cast<uint64_t>(request.path);
+            sqe.len = request.mode;
+            sqe.open_flags = narrow_cast<uint32_t>(request.flags);
+            break;
+        case detail::async_file_op::read:
+            sqe.opcode = IORING_OP_READ;
+            sqe.fd = request.fd;
+            sqe.addr = std::bit_cast<uint64_t>(request.data);
+            sqe.len = request.size;
+            sqe.off = request.offset;
+            break;
+        case detail::async_file_op::write:
+            sqe.opcode = IORING_OP_WRITE;
+            sqe.fd = request.fd;
+            sqe.addr = std::bit_cast<uint64_t>(request.data);
+            sqe.len = request.size;
+            sqe.off = request.offset;
+            break;
+        case detail::async_file_op::fsync:
+            sqe.opcode = IORING_OP_FSYNC;
+            sqe.fd = request.fd;
+            break;
+        case detail::async_file_op::close:
+            sqe.opcode = IORING_OP_CLOSE;
+            sqe.fd = request.fd;
+            break;
+        default:
+            hi_no_default();
+        }
+    }
+
+    /** Enter the kernel to submit entries from the submission queue.
+     */
+    void io_uring_flush(uint32_t to_submit) noexcept
+    {
+        while (to_submit != 0) {
+            auto const r = io_uring_enter(_ring_fd, to_submit, 0, 0);
+            if (r >= 0) {
+                to_submit -= narrow_cast<uint32_t>(r);
+
+            } else if (errno == EAGAIN or errno == EBUSY) {
+                // The completion queue has overflowed, wait for the completion thread to reap.
+                std::this_thread::yield();
+
+            } else if (errno != EINTR) {
+                hi_log_fatal("Could not submit to io_uring. {}", get_last_error_message());
+            }
+        }
+    }
+
+    void io_uring_submit(std::span<detail::async_file_request> requests) noexcept
+    {
+        auto const lock = std::scoped_lock(_sq_mutex);
+
+        auto tail = *_sq_tail;
+        auto to_submit = 0_uz;
+        for (auto& request : requests) {
+            if (tail - std::atomic_ref(*_sq_head).load(std::memory_order::acquire) == _sq_entries) {
+                // The submission queue is full, the kernel copies the entries while entering.
+                io_uring_flush(narrow_cast<uint32_t>(std::exchange(to_submit, 0)));
+            }
+
+            auto const index = tail & _sq_mask;
+            io_uring_prepare(_sqes[index], request);
+            _sq_array[index] = index;
+            std::atomic_ref(*_sq_tail).store(++tail, std::memory_order::release);
+            ++to_submit;
+        }
+
+        io_uring_flush(narrow_cast<uint32_t>(to_submit));
+    }
+
+    void io_uring_complete() noexcept
+    {
+        while (true) {
+            auto head = *_cq_head;
+            auto const tail = std::atomic_ref(*_cq_tail).load(std::memory_order::acquire);
+
+            if (head == tail) {
+                if (io_uring_enter(_ring_fd, 0, 1, IORING_ENTER_GETEVENTS) == -1 and errno != EINTR) {
+                    hi_log_fatal("Could not wait for io_uring completions. {}", get_last_error_message());
+                }
+                continue;
+            }
+
+            auto stop = false;
+            for (; head != tail; ++head) {
+                auto const& cqe = _cqes[head & _cq_mask];
+                if (cqe.user_data == 0) {
+                    stop = _stop.load(std::memory_order::relaxed);
+                    continue;
+                }
+
+                auto& request = *std::bit_cast<detail::async_file_request *>(cqe.user_data);
+                request.result = cqe.res;
+                request.batch->complete_one();
+            }
+            std::atomic_ref(*_cq_head).store(head, std::memory_order::release);
+
+            if (stop) {
+                return;
+            }
+        }
+    }
+
+    void pool_init()
+    {
+        auto const num_threads = std::clamp(std::thread::hardware_concurrency(), 2U, 8U);
+        for (auto i = 0U; i != num_threads; ++i) {
+            _pool_threads.emplace_back([this](std::stop_token stop_token) {
+                set_thread_name("async_file");
+                pool_work(stop_token);
+            });
+        }
+    }
+
+    static void pool_execute(detail::async_file_request& request) noexcept
+    {
+        auto r = int64_t{0};
+
+        switch (request.op) {
+        case detail::async_file_op::nop:
+            break;
+        case detail::async_file_op::open:
+            r = ::open(request.path, request.flags, request.mode);
+            break;
+        case detail::async_file_op::read:
+            r = ::pread(request.fd, request.data, request.size, narrow_cast<off_t>(request.offset));
+            break;
+        case detail::async_file_op::write:
+            r = ::pwrite(request.fd, request.data, request.size, narrow_cast<off_t>(request.offset));
+            break;
+        case detail::async_file_op::fsync:
+            r = ::fsync(request.fd);
+            break;
+        case detail::async_file_op::close:
+            r = ::close(request.fd);
+            break;
+        default:
+            hi_no_default();
+        }
+
+        request.result = r == -1 ? -int64_t{errno} : r;
+    }
+
+    void pool_work(std::stop_token stop_token) noexcept
+    {
+        while (true) {
+            auto lock = std::unique_lock(_pool_mutex);
+            if (not _pool_cv.wait(lock, stop_token, [this] {
+                    return not _pool_queue.empty();
+                })) {
+                return;
+            }
+
+            auto request = _pool_queue.front();
+            _pool_queue.pop_front();
+            lock.unlock();
+
+            pool_execute(*request);
+            request->batch->complete_one();
+        }
+    }
+};
+
+namespace detail {
+inline std::unique_ptr<async_file_service> async_file_service_global = nullptr;
+}
+
+inline async_file_service& async_file_service::global() noexcept
+{
+    if (not detail::async_file_service_global) {
+        detail::async_file_service_global = std::make_unique<async_file_service>();
+    }
+    return *detail::async_file_service_global;
+}
+
+namespace detail {
+
+/** Submit requests and suspend until all of them are completed.
+ */
+class async_file_batch_awaitable {
+public:
+    async_file_batch_awaitable(std::span<async_file_request> requests, async_file_service& service) noexcept :
+        _requests(requests), _service(service)
+    {
+    }
+
+    [[nodiscard]] bool await_ready() const noexcept
+    {
+        return _requests.empty();
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) noexcept
+    {
+        _batch.remaining.store(_requests.size(), std::memory_order::relaxed);
+        _batch.loop_ptr = std::addressof(loop::local());
+        _batch.loop_ptr->add_pending();
+        _batch.handle = handle;
+        _service.submit(_requests, _batch);
+    }
+
+    void await_resume() const noexcept {}
+
+private:
+    std::span<async_file_request> _requests;
+    async_file_service& _service;
+    async_file_batch _batch;
+};
+
+} // namespace detail
+
+/** Awaitable for a single asynchronous file operation.
+ * @ingroup file
+ *
+ * The co-routine is resumed on the loop of the thread on which it was suspended.
+ * Create these awaitables with the `async_open()`, `async_read()`, `async_write()`,
+ * `async_fsync()` and `async_close()` functions.
+ */
+template<detail::async_file_op Op>
+class async_file_awaitable {
+public:
+    async_file_awaitable(async_file_awaitable const&) = delete;
+    async_file_awaitable(async_file_awaitable&&) = delete;
+    async_file_awaitable& operator=(async_file_awaitable const&) = delete;
+    async_file_awaitable& operator=(async_file_awaitable&&) = delete;
+
+    async_file_awaitable(detail::async_file_request request, async_file_service& service, std::string path = {}) noexcept :
+        _request(request), _service(service), _path(std::move(path))
+    {
+        _request.op = Op;
+        _request.path = _path.c_str();
+    }
+
+    [[nodiscard]] bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) noexcept
+    {
+        _batch.remaining.store(1, std::memory_order::relaxed);
+        _batch.loop_ptr = std::addressof(loop::local());
+        _batch.loop_ptr->add_pending();
+        _batch.handle = handle;
+        _service.submit(std::span{&_request, 1}, _batch);
+    }
+
+    /** Get the result of the operation.
+     *
+     * @return `open`: the file descriptor; `read`, `write`: the number of bytes transferred.
+     * @throws io_error When the operation failed.
+     */
+    auto await_resume() const
+    {
+        if (_request.result < 0) {
+            throw io_error(std::format("{}: Could not {} file. '{}'", _path, op_name(), _request.error_message()));
+        }
+
+        if constexpr (Op == detail::async_file_op::open) {
+            return narrow_cast<int>(_request.result);
+        } else if constexpr (Op == detail::async_file_op::read or Op == detail::async_file_op::write) {
+            return narrow_cast<std::size_t>(_request.result);
+        } else {
+            return;
+        }
+    }
+
+private:
+    detail::async_file_request _request;
+    async_file_service& _service;
+    detail::async_file_batch _batch;
+    std::string _path;
+
+    [[nodiscard]] constexpr static char const *op_name() noexcept
+    {
+        switch (Op) {
+        case detail::async_file_op::open: return "open";
+        case detail::async_file_op::read: return "read";
+        case detail::async_file_op::write: return "write";
+        case detail::async_file_op::fsync: return "fsync";
+        case detail::async_file_op::close: return "close";
+        default: return "access";
+        }
+    }
+};
+
+/** Asynchronously open a file.
+ * @ingroup file
+ *
+ * @note `access_mode::create_directories` and the lock flags are not supported.
+ * @param path The path to the file to open.
+ * @param mode The access-mode to open the file with.
+ * @param service The service that executes the request.
+ * @return An awaitable which returns the file descriptor.
+ */
+[[nodiscard]] inline auto async_open(
+    std::filesystem::path const& path,
+    access_mode mode = access_mode::open_for_read,
+    async_file_service& service = async_file_service::global())
+{
+    auto request = detail::async_file_request{};
+    request.flags = detail::access_mode_to_open_flags(mode);
+    request.mode = 0666;
+    return async_file_awaitable<detail::async_file_op::open>{request, service, path.string()};
+}
+
+/** Asynchronously read from a file at an offset.
+ * @ingroup file
+ *
+ * @param fd The file descriptor returned by `async_open()`.
+ * @param buffer The buffer to read into, must stay valid until the operation completes.
+ * @param offset The offset in the file to read from.
+ * @param service The service that executes the request.
+ * @return An awaitable which returns the number of bytes read, zero at end-of-file.
+ */
+[[nodiscard]] inline auto
+async_read(int fd, std::span<std::byte> buffer, uint64_t offset, async_file_service& service = async_file_service::global())
+{
+    auto request = detail::async_file_request{};
+    request.fd = fd;
+    request.data = buffer.data();
+    request.size = narrow_cast<uint32_t>(std::min(buffer.size(), std::size_t{0x4000'0000}));
+    request.offset = offset;
+    return async_file_awaitable<detail::async_file_op::read>{request, service};
+}
+
+/** Asynchronously write to a file at an offset.
+ * @ingroup file
+ *
+ * @param fd The file descriptor returned by `async_open()`.
+ * @param buffer The data to write, must stay valid until the operation completes.
+ * @param offset The offset in the file to write to.
+ * @param service The service that executes the request.
+ * @return An awaitable which returns the number of bytes written.
+ */
+[[nodiscard]] inline auto async_write(
+    int fd,
+    std::span<std::byte const> buffer,
+    uint64_t offset,
+    async_file_service& service = async_file_service::global())
+{
+    auto request = detail::async_file_request{};
+    request.fd = fd;
+    request.data = const_cast<std::byte *>(buffer.data());
+    request.size = narrow_cast<uint32_t>(std::min(buffer.size(), std::size_t{0x4000'0000}));
+    request.offset = offset;
+    return async_file_awaitable<detail::async_file_op::write>{request, service};
+}
+
+/** Asynchronously flush a file to disk.
+ * @ingroup file
+ *
+ * @param fd The file descriptor returned by `async_open()`.
+ * @param service The service that executes the request.
+ */
+[[nodiscard]] inline auto async_fsync(int fd, async_file_service& service = async_file_service::global())
+{
+    auto request = detail::async_file_request{};
+    request.fd = fd;
+    return async_file_awaitable<detail::async_file_op::fsync>{request, service};
+}
+
+/** Asynchronously close a file.
+ * @ingroup file
+ *
+ * @param fd The file descriptor returned by `async_open()`.
+ * @param service The service that executes the request.
+ */
+[[nodiscard]] inline auto async_close(int fd, async_file_service& service = async_file_service::global())
+{
+    auto request = detail::async_file_request{};
+    request.fd = fd;
+    return async_file_awaitable<detail::async_file_op::close>{request, service};
+}
+
+/** Asynchronously read a set of files completely.
+ * @ingroup file
+ *
+ * The files are opened, read and closed as batches; all opens are submitted
+ * with a single system call, followed by all reads and all closes.
+ * Files larger than 1 GiB are read in multiple rounds.
+ *
+ * @param paths The paths of the files to read.
+ * @param max_size The maximum number of bytes to read from each file.
+ * @param service The service that executes the requests, must outlive the task.
+ * @return The contents of each file, in the same order as @a paths.
+ * @throws io_error When any of the files could not be read.
+ */
+[[nodiscard]] inline task<std::vector<bstring>>
+async_read_files(
+    std::vector<std::filesystem::path> paths,
+    std::size_t max_size = 10'000'000,
+    async_file_service& service = async_file_service::global())
+{
+    auto const num_files = paths.size();
+    auto path_strings = std::vector<std::string>{};
+    path_strings.reserve(num_files);
+    for (auto const& path : paths) {
+        path_strings.push_back(path.string());
+    }
+
+    // Open all files.
+    auto requests = std::vector<detail::async_file_request>(num_files);
+    for (auto i = 0_uz; i != num_files; ++i) {
+        requests[i].op = detail::async_file_op::open;
+        requests[i].path = path_strings[i].c_str();
+        requests[i].flags = O_RDONLY | O_CLOEXEC;
+    }
+    co_await detail::async_file_batch_awaitable{requests, service};
+
+    // The size is retrieved with fstat() instead of a statx request; io_uring always
+    // executes statx on a kernel worker thread, while fstat() on an open file
+    // does not block on I/O.
+    auto error = std::string{};
+    auto fds = std::vector<int>(num_files, -1);
+    auto r = std::vector<bstring>(num_files);
+    for (auto i = 0_uz; i != num_files; ++i) {
+        if (requests[i].result < 0) {
+            if (error.empty()) {
+                error = std::format("{}: Could not open file. '{}'", path_strings[i], requests[i].error_message());
+            }
+            continue;
+        }
+
+        fds[i] = narrow_cast<int>(requests[i].result);
+
+        struct stat stat_buffer;
+        if (::fstat(fds[i], &stat_buffer) == -1) {
+            if (error.empty()) {
+                error = std::format("{}: Could not get file size. '{}'", path_strings[i], get_last_error_message());
+            }
+            continue;
+        }
+
+        r[i].resize(std::min(narrow_cast<std::size_t>(stat_buffer.st_size), max_size));
+    }
+
+    // Read all files, short reads are continued in the next round.
+    auto offsets = std::vector<std::size_t>(num_files, 0);
+    auto pending = std::vector<std::size_t>{};
+    while (error.empty()) {
+        pending.clear();
+        requests.clear();
+        for (auto i = 0_uz; i != num_files; ++i) {
+            if (offsets[i] != r[i].size()) {
+                auto& request = requests.emplace_back();
+                request.op = detail::async_file_op::read;
+                request.fd = fds[i];
+                request.data = r[i].data() + offsets[i];
+                request.size = narrow_cast<uint32_t>(std::min(r[i].size() - offsets[i], std::size_t{0x4000'0000}));
+                request.offset = offsets[i];
+                pending.push_back(i);
+            }
+        }
+
+        if (requests.empty()) {
+            break;
+        }
+        co_await detail::async_file_batch_awaitable{requests, service};
+
+        for (auto j = 0_uz; j != requests.size(); ++j) {
+            auto const i = pending[j];
+            if (requests[j].result > 0) {
+                offsets[i] += narrow_cast<std::size_t>(requests[j].result);
+            } else if (requests[j].result == 0) {
+                // The file was truncated after its size was determined.
+                r[i].resize(offsets[i]);
+            } else if (error.empty()) {
+                error = std::format("{}: Could not read file. '{}'", path_strings[i], requests[j].error_message());
+            }
+        }
+    }
+
+    // Close all files that were opened, also when an error has occurred.
+    requests.clear();
+    for (auto const fd : fds) {
+        if (fd != -1) {
+            auto& request = requests.emplace_back();
+            request.op = detail::async_file_op::close;
+            request.fd = fd;
+        }
+    }
+    co_await detail::async_file_batch_awaitable{requests, service};
+
+    if (not error.empty()) {
+        throw io_error(error);
+    }
+    co_return r;
+}
+
+} // namespace hi::inline v1
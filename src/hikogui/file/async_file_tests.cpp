@@ -0,0 +1,96 @@
+// Copyright Take Vos 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include "file.hpp"
+#include "../path/path.hpp"
+#include <hikotest/hikotest.hpp>
+#include <filesystem>
+#include <string>
+
+#if HI_OPERATING_SYSTEM == HI_OS_LINUX
+TEST_SUITE(async_file_suite) {
+
+static hi::task<std::string> write_and_read(std::filesystem::path path, std::string text, hi::async_file_service& service)
+{
+    auto fd = co_await hi::async_open(path, hi::access_mode::truncate_or_create_for_write | hi::access_mode::read, service);
+    auto const written = co_await hi::async_write(fd, std::as_bytes(std::span{text}), 0, service);
+    co_await hi::async_fsync(fd, service);
+
+    auto r = std::string(written, '\0');
+    auto const read = co_await hi::async_read(fd, std::as_writable_bytes(std::span{r}), 0, service);
+    r.resize(read);
+
+    co_await hi::async_close(fd, service);
+    co_return r;
+}
+
+template<typename T>
+static T const& wait_for(hi::task<T> const& t)
+{
+    while (not t.done()) {
+        hi::loop::local().resume_once(true);
+    }
+    return t.value();
+}
+
+TEST_CASE(write_and_read_test)
+{
+    auto const path = std::filesystem::temp_directory_path() / "hikogui_async_file_test.txt";
+
+    // Run with io_uring, when available, and with the thread-pool fallback.
+    for (auto const allow_io_uring : {true, false}) {
+        auto service = hi::async_file_service{allow_io_uring};
+
+        auto t = write_and_read(path, "The quick brown fox jumps over the lazy dog.", service);
+        REQUIRE(wait_for(t) == "The quick brown fox jumps over the lazy dog.");
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE(read_files_test)
+{
+    auto const path = hi::library_test_data_dir() / "file_view.txt";
+
+    for (auto const allow_io_uring : {true, false}) {
+        auto service = hi::async_file_service{allow_io_uring};
+
+        auto t = hi::async_read_files({path, path, path}, 10'000'000, service);
+        auto const& files = wait_for(t);
+        REQUIRE(files.size() == 3);
+        for (auto const& data : files) {
+            REQUIRE(data == hi::to_bstring("The quick brown fox jumps over the lazy dog."));
+        }
+    }
+}
+
+TEST_CASE(read_files_missing_test)
+{
+    auto const path = hi::library_test_data_dir() / "file_view.txt";
+
+    for (auto const allow_io_uring : {true, false}) {
+        auto service = hi::async_file_service{allow_io_uring};
+
+        auto t = hi::async_read_files({path, hi::library_test_data_dir() / "does_not_exist.txt"}, 10'000'000, service);
+        REQUIRE_THROWS(wait_for(t), hi::io_error);
+    }
+}
+
+TEST_CASE(resume_test)
+{
+    // A request in flight keeps loop::resume() without a stop token running.
+    auto const path = hi::library_test_data_dir() / "file_view.txt";
+
+    for (auto const allow_io_uring : {true, false}) {
+        auto service = hi::async_file_service{allow_io_uring};
+
+        auto t = hi::async_read_files({path}, 10'000'000, service);
+        hi::loop::local().resume();
+        REQUIRE(t.done());
+        REQUIRE(t.value().size() == 1);
+    }
+}
+
+}; // TEST_SUITE(async_file_suite)
+#endif
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "access_mode.hpp" // export
+#include "async_file.hpp" // export
 #include "file_intf.hpp" // export
 #include "file_view.hpp" // export
 #include "resource_view.hpp" // export
@@ -35,6 +36,17 @@ A `file_view` is a RAII object holding a memory-mapping of the file.
 This object allows easy and fast access to the data in a file, as-if
 the file was a `std::span<>` or `std::string_view`.
 
+Asynchronous file I/O
+---------------------
+`async_open()`, `async_read()`, `async_write()`, `async_fsync()` and
+`async_close()` return awaitables which can be used from a `hi::task<>`
+co-routine; the co-routine is resumed on the loop of the thread that
+awaited. `async_read_files()` reads many files with a single submission
+for each of the open, read and close phases.
+
+On Linux these are implemented with io_uring, falling back to a
+thread-pool when io_uring is not available.
+
 */
 
 }}
@@ -68,6 +68,7 @@ public:
 
         auto const font_family_id = register_family(font.family_name);
         _font_variants[*font_family_id][font.font_variant()] = font_id;
+        _generation.fetch_add(1, std::memory_order::release);
 
         if (post_process) {
             this->post_process();
@@ -149,6 +150,19 @@ public:
 
             font->fallback_chain = std::move(fallback_chain);
         }
+
+        _generation.fetch_add(1, std::memory_order::release);
+    }
+
+    /** The generation of the font book.
+     *
+     * This is incremented each time a font is registered or the fallback
+     * chains are recalculated, so that caches of shaped text can find out
+     * that the glyphs they hold may have changed.
+     */
+    [[nodiscard]] std::size_t generation() const noexcept
+    {
+        return _generation.load(std::memory_order::acquire);
     }
 
     /** Find font family id.
@@ -252,6 +266,7 @@ private:
 
     std::vector<std::unique_ptr<font>> _fonts;
     std::vector<hi::font_id> _fallback_chain;
+    std::atomic<std::size_t> _generation = 0;
 
     [[nodiscard]] std::vector<hi::font_id> make_fallback_chain(font_weight weight, font_style style) noexcept
     {
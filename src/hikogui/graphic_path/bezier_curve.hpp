@@ -145,6 +145,10 @@ hi_export struct bezier_curve {
     }
 
     struct sdf_distance_result {
+        /** Difference in square distance below which two curves are considered equally near.
+         */
+        constexpr static float tie_tolerance = 0.01f;
+
         /** The vector between P and N.
          */
         vector2 PN;
@@ -200,7 +204,7 @@ hi_export struct bezier_curve {
 
         [[nodiscard]] hi_force_inline constexpr bool operator<(sdf_distance_result const& rhs) const noexcept
         {
-            if (abs(sq_distance - rhs.sq_distance) < 0.01f) {
+            if (abs(sq_distance - rhs.sq_distance) < tie_tolerance) {
                 // The point is very close to both curves, meaning they
                 // are close the end/corner of both curve-segments.
                 // Here we create a line through the corner where both curves
@@ -379,6 +383,34 @@ hi_export struct bezier_curve {
         }
     }
 
+    /** The bounding rectangle of the end- and control-points of the curve.
+     *
+     * The curve lies completely inside its control-polygon, so this rectangle
+     * also bounds every point on the curve.
+     */
+    [[nodiscard]] friend aarectangle bounding_rectangle(bezier_curve const& rhs) noexcept
+    {
+        // Don't use `aarectangle::operator|()` here, it treats a rectangle
+        // of a single point as empty and would drop that point.
+        auto p0 = min(rhs.P1, rhs.P2);
+        auto p3 = max(rhs.P1, rhs.P2);
+        switch (rhs.type) {
+        case Type::Linear:
+            break;
+        case Type::Quadratic:
+            p0 = min(p0, rhs.C1);
+            p3 = max(p3, rhs.C1);
+            break;
+        case Type::Cubic:
+            p0 = min(min(p0, rhs.C1), rhs.C2);
+            p3 = max(max(p3, rhs.C1), rhs.C2);
+            break;
+        default:
+            hi_no_default();
+        }
+        return aarectangle{p0, p3};
+    }
+
     [[nodiscard]] friend bezier_curve operator*(transformer2 auto const& lhs, bezier_curve const& rhs) noexcept
     {
         return {rhs.type, lhs * rhs.P1, lhs * rhs.C1, lhs * rhs.C2, lhs * rhs.P2};
@@ -542,6 +574,129 @@ constexpr void fillRow(std::span<uint8_t> row, std::size_t rowY, std::vector<bez
     return nearest.signed_distance();
 }
 
+/** The width and height in pixels of a cell of the SDF acceleration grid.
+ */
+constexpr std::size_t sdf_cell_size = 8;
+
+/** The smallest square distance between two rectangles.
+ *
+ * @param lhs A rectangle as (left, bottom, right, top).
+ * @param rhs A rectangle as (left, bottom, right, top); a point is passed as (x, y, x, y).
+ * @return The square distance between the nearest points of both rectangles.
+ */
+[[nodiscard]] hi_force_inline float sdf_squared_distance_lower_bound(f32x4 lhs, f32x4 rhs) noexcept
+{
+    // (lhs.left - rhs.right, lhs.bottom - rhs.top, rhs.left - lhs.right, rhs.bottom - lhs.top)
+    // At most one of each horizontal and vertical pair is positive.
+    auto const gaps = max((lhs - rhs.zwxy()) * f32x4{1.0f, 1.0f, -1.0f, -1.0f}, f32x4{});
+    auto const gap = gaps + gaps.zwxy();
+    return dot<0b0011>(gap, gap).x();
+}
+
+/** The largest square distance between a point in a rectangle and a given point.
+ *
+ * @param lhs A rectangle as (left, bottom, right, top).
+ * @param rhs A point.
+ * @return The square distance from @a rhs to the farthest corner of @a lhs.
+ */
+[[nodiscard]] hi_force_inline float sdf_squared_distance_upper_bound(f32x4 lhs, point2 rhs) noexcept
+{
+    auto const d = abs(lhs - static_cast<f32x4>(rhs).xyxy());
+    auto const farthest = max(d, d.zwxy());
+    return dot<0b0011>(farthest, farthest).x();
+}
+
+/** Fill a signed distance field by checking every pixel against every curve.
+ *
+ * This is the reference implementation for `fill(pixmap_span<sdf_r8>, std::vector<bezier_curve> const&)`.
+ */
+inline void fill_sdf_r8_brute_force(pixmap_span<sdf_r8> image, std::vector<bezier_curve> const& curves) noexcept
+{
+    for (auto row_nr = 0_uz; row_nr != image.height(); ++row_nr) {
+        auto const row = image[row_nr];
+        auto const y = static_cast<float>(row_nr);
+        for (auto column_nr = 0_uz; column_nr != image.width(); ++column_nr) {
+            auto const x = static_cast<float>(column_nr);
+            row[column_nr] = generate_sdf_r8_pixel(point2(x, y), curves);
+        }
+    }
+}
+
+/** Fill a single cell of the SDF acceleration grid.
+ *
+ * @param image The signed distance field.
+ * @param cell The pixel-centres of the cell as (left, bottom, right, top).
+ * @param curves All curves of the path.
+ * @param curve_bounds The bounding rectangle of each curve, as (left, bottom, right, top).
+ * @param[out] candidates Scratch buffer for the indices of curves that may be nearest to a pixel in the cell.
+ */
+inline void fill_sdf_r8_cell(
+    pixmap_span<sdf_r8> image,
+    f32x4 cell,
+    std::vector<bezier_curve> const& curves,
+    std::vector<f32x4> const& curve_bounds,
+    std::vector<std::size_t>& candidates) noexcept
+{
+    hi_axiom(not curves.empty());
+    hi_axiom(curves.size() == curve_bounds.size());
+
+    // The end-points of a curve lie on the curve, so the distance to the
+    // farthest corner of the cell is an upper bound of the distance of any
+    // pixel in the cell to that curve.
+    auto max_sq_distance = std::numeric_limits<float>::max();
+    for (auto const& curve : curves) {
+        max_sq_distance = std::min(max_sq_distance, sdf_squared_distance_upper_bound(cell, curve.P1));
+        max_sq_distance = std::min(max_sq_distance, sdf_squared_distance_upper_bound(cell, curve.P2));
+    }
+
+    // Curves whose bounding rectangle is farther away than the upper bound
+    // can never be the nearest curve for any pixel in this cell. The
+    // remaining candidates keep the original order of the curves, so that the
+    // tie-breaking in `sdf_distance_result::operator<()` is not affected.
+    auto const max_candidate_sq_distance = max_sq_distance + bezier_curve::sdf_distance_result::tie_tolerance;
+    candidates.clear();
+    for (auto i = 0_uz; i != curves.size(); ++i) {
+        if (sdf_squared_distance_lower_bound(curve_bounds[i], cell) <= max_candidate_sq_distance) {
+            candidates.push_back(i);
+        }
+    }
+    hi_axiom(not candidates.empty());
+
+    auto const first_column = static_cast<std::size_t>(cell.x());
+    auto const last_column = static_cast<std::size_t>(cell.z());
+    auto const first_row = static_cast<std::size_t>(cell.y());
+    auto const last_row = static_cast<std::size_t>(cell.w());
+
+    for (auto row_nr = first_row; row_nr <= last_row; ++row_nr) {
+        auto const row = image[row_nr];
+        auto const y = static_cast<float>(row_nr);
+        for (auto column_nr = first_column; column_nr <= last_column; ++column_nr) {
+            auto const x = static_cast<float>(column_nr);
+            auto const point = point2{x, y};
+            auto const point_ = f32x4{x, y, x, y};
+
+            auto it = candidates.cbegin();
+            auto nearest = curves[*it++].sdf_distance(point);
+
+            for (; it != candidates.cend(); ++it) {
+                // Skip the expensive distance calculation when the curve
+                // can not come near enough to replace the current nearest.
+                if (sdf_squared_distance_lower_bound(curve_bounds[*it], point_) >
+                    nearest.sq_distance + bezier_curve::sdf_distance_result::tie_tolerance) {
+                    continue;
+                }
+
+                auto const distance = curves[*it].sdf_distance(point);
+                if (distance < nearest) {
+                    nearest = distance;
+                }
+            }
+
+            row[column_nr] = nearest.signed_distance();
+        }
+    }
+}
+
 } // namespace detail
 
 /** Make a contour of Bezier curves from a list of points.
@@ -703,17 +858,42 @@ constexpr void fill(pixmap_span<uint8_t> image, std::vector<bezier_curve> const&
 }
 
 /** Fill a signed distance field image from the given contour.
+ *
+ * The image is divided in a grid of cells, for each cell only the curves
+ * that may be nearest to one of its pixels are checked. The result is the
+ * same as checking every curve for every pixel, except for pixels that are
+ * at an equal distance (within `sdf_distance_result::tie_tolerance`) to
+ * multiple curves.
+ *
  * @param image An signed-distance-field which show distance toward the closest curve
  * @param curves All curves of path, in no particular order.
  */
-constexpr void fill(pixmap_span<sdf_r8> image, std::vector<bezier_curve> const& curves) noexcept
+inline void fill(pixmap_span<sdf_r8> image, std::vector<bezier_curve> const& curves) noexcept
 {
-    for (auto row_nr = 0_uz; row_nr != image.height(); ++row_nr) {
-        auto const row = image[row_nr];
-        auto const y = static_cast<float>(row_nr);
-        for (auto column_nr = 0_uz; column_nr != image.width(); ++column_nr) {
-            auto const x = static_cast<float>(column_nr);
-            row[column_nr] = detail::generate_sdf_r8_pixel(point2(x, y), curves);
+    if (curves.empty()) {
+        detail::fill_sdf_r8_brute_force(image, curves);
+        return;
+    }
+
+    auto curve_bounds = std::vector<f32x4>{};
+    curve_bounds.reserve(curves.size());
+    for (auto const& curve : curves) {
+        curve_bounds.push_back(static_cast<f32x4>(bounding_rectangle(curve)));
+    }
+
+    auto candidates = std::vector<std::size_t>{};
+    candidates.reserve(curves.size());
+
+    for (auto row_nr = 0_uz; row_nr < image.height(); row_nr += detail::sdf_cell_size) {
+        auto const last_row = std::min(row_nr + detail::sdf_cell_size, image.height()) - 1;
+        for (auto column_nr = 0_uz; column_nr < image.width(); column_nr += detail::sdf_cell_size) {
+            auto const last_column = std::min(column_nr + detail::sdf_cell_size, image.width()) - 1;
+            auto const cell = f32x4{
+                static_cast<float>(column_nr),
+                static_cast<float>(row_nr),
+                static_cast<float>(last_column),
+                static_cast<float>(last_row)};
+            detail::fill_sdf_r8_cell(image, cell, curves, curve_bounds, candidates);
         }
     }
 }
@@ -4,6 +4,7 @@
 
 #include "bezier_curve.hpp"
 #include <hikotest/hikotest.hpp>
+#include <vector>
 
 TEST_SUITE(bezier_curve) {
 
@@ -15,4 +16,46 @@ TEST_CASE(solve_x_by_y)
     REQUIRE(hi::bezier_curve(hi::point2(1.0f, 2.0f), hi::point2(1.0f, 1.5f), hi::point2(1.0f, 1.0f)).solveXByY(1.5f) == hi::make_lean_vector<double>(1.0f), 0.000001);
 }
 
+static void check_sdf_same_as_brute_force(std::vector<hi::bezier_curve> const& curves, std::size_t width, std::size_t height)
+{
+    auto expected_data = std::vector<hi::sdf_r8>(width * height);
+    auto expected = hi::pixmap_span<hi::sdf_r8>{expected_data.data(), width, height};
+    hi::detail::fill_sdf_r8_brute_force(expected, curves);
+
+    auto result_data = std::vector<hi::sdf_r8>(width * height);
+    auto result = hi::pixmap_span<hi::sdf_r8>{result_data.data(), width, height};
+    hi::fill(result, curves);
+
+    // Pixels at equal distance to two curves may select either curve,
+    // allow for a single step of the 8-bit quantization.
+    for (auto y = std::size_t{0}; y != height; ++y) {
+        for (auto x = std::size_t{0}; x != width; ++x) {
+            REQUIRE(static_cast<float>(result(x, y)) == static_cast<float>(expected(x, y)), 0.03);
+        }
+    }
+}
+
+TEST_CASE(fill_sdf_rectangle)
+{
+    auto curves = std::vector<hi::bezier_curve>{};
+    curves.emplace_back(hi::point2(5.5f, 4.5f), hi::point2(30.5f, 4.5f));
+    curves.emplace_back(hi::point2(30.5f, 4.5f), hi::point2(30.5f, 20.5f));
+    curves.emplace_back(hi::point2(30.5f, 20.5f), hi::point2(5.5f, 20.5f));
+    curves.emplace_back(hi::point2(5.5f, 20.5f), hi::point2(5.5f, 4.5f));
+
+    // A size that is not a multiple of the cell size.
+    check_sdf_same_as_brute_force(curves, 37, 27);
+}
+
+TEST_CASE(fill_sdf_quadratic)
+{
+    auto curves = std::vector<hi::bezier_curve>{};
+    curves.emplace_back(hi::point2(20.0f, 4.0f), hi::point2(36.0f, 4.0f), hi::point2(36.0f, 20.0f));
+    curves.emplace_back(hi::point2(36.0f, 20.0f), hi::point2(36.0f, 36.0f), hi::point2(20.0f, 36.0f));
+    curves.emplace_back(hi::point2(20.0f, 36.0f), hi::point2(4.0f, 36.0f), hi::point2(4.0f, 20.0f));
+    curves.emplace_back(hi::point2(4.0f, 20.0f), hi::point2(4.0f, 4.0f), hi::point2(20.0f, 4.0f));
+
+    check_sdf_same_as_brute_force(curves, 40, 40);
+}
+
 };
@@ -123,6 +123,11 @@ private:
             owner->_ptr = replacement;
             owner->_ptr->_enable_group_ptr_add_owner(owner);
         }
+
+        // Let the derived class move its own per-owner state to the replacement.
+        if constexpr (requires(T& self, T& other) { self._enable_group_ptr_reseated(other); }) {
+            static_cast<T *>(this)->_enable_group_ptr_reseated(*static_cast<T *>(replacement.get()));
+        }
         hi_axiom(_enable_group_ptr_holds_invariant());
     }
 
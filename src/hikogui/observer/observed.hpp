@@ -5,31 +5,88 @@
 #pragma once
 
 #include "group_ptr.hpp"
+#include "../concurrency/concurrency.hpp"
+#include "../concurrency/unfair_mutex.hpp" // XXX #616
+#include "../telemetry/telemetry.hpp"
 #include "../macros.hpp"
 #include <memory>
 #include <vector>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <algorithm>
+#include <mutex>
+#include <cstdint>
 
 hi_export_module(hikogui.observer : observed);
 
 hi_export namespace hi { inline namespace v1 {
 
-struct observable_msg {
-    /** The type of the path used for notifying observers.
+namespace detail {
+inline unfair_mutex observable_path_mutex;
+inline std::unordered_map<std::string, uint32_t> observable_path_elements;
+} // namespace detail
+
+/** Get the interned id of a path element of an observer.
+ *
+ * @param name The name of a member, or an index formatted as "[index]".
+ * @return An id that is unique for each name.
+ */
+[[nodiscard]] inline uint32_t intern_observable_path_element(std::string_view name) noexcept
+{
+    auto const lock = std::scoped_lock(detail::observable_path_mutex);
+    auto const [it, inserted] = detail::observable_path_elements.try_emplace(
+        std::string{name}, narrow_cast<uint32_t>(detail::observable_path_elements.size()));
+    return it->second;
+}
+
+/** The interface through which an observed object notifies an observer.
+ */
+class observed_subscriber {
+public:
+    /** Called when the observed value was modified.
+     *
+     * @param ptr A pointer to the whole observed value.
      */
-    using path_type = std::vector<std::string>;
+    virtual void notify_observed(void const *ptr) noexcept = 0;
 
-    void const * const ptr;
-    path_type const& path;
+protected:
+    ~observed_subscriber() = default;
 };
 
 /** An abstract observed object.
  *
  * This type is referenced by `observer`s
+ *
+ * Observers subscribe with the path to the sub-object they observe. The
+ * subscriptions are kept in a trie of path elements so that a modification
+ * only reaches the observers of the modified sub-object, of the objects that
+ * contain it and of the sub-objects that it contains.
+ *
+ * Notifications may be batched: between `start_batch()` and `finish_batch()`
+ * the modified paths are recorded, and at the end of the outermost batch
+ * each affected observer is notified once. Notifications that were merged
+ * this way are counted in the global counter "observer:notify:coalesced".
  */
-class observed_base : public enable_group_ptr<observed_base, void(observable_msg)> {
+class observed_base : public enable_group_ptr<observed_base> {
 public:
-    virtual ~observed_base() = default;
+    /** The type of the path to a sub-object, used for notifying observers.
+     *
+     * Each element is an id from `intern_observable_path_element()`.
+     */
+    using path_type = std::vector<uint32_t>;
+
+    /** Destroy the observed object.
+     *
+     * Batches keep the observed object alive, except a deferred batch whose
+     * function was dropped by the main-loop without being called; its
+     * notifications are dropped as well, since nothing observes this object anymore.
+     */
+    virtual ~observed_base()
+    {
+        hi_assert(_batch_depth == 0 or _batch_deferred);
+    }
+
     observed_base(observed_base const&) = delete;
     observed_base(observed_base&&) = delete;
     observed_base& operator=(observed_base const&) = delete;
@@ -47,13 +104,287 @@ public:
      * @return A pointer to the value. The `observer` should cast this to a pointer to the value-type.
      */
     [[nodiscard]] virtual void *get() noexcept = 0;
+
+    /** Subscribe an observer of a sub-object.
+     *
+     * @param subscriber The observer to notify.
+     * @param path The path to the sub-object that is observed.
+     */
+    void subscribe(observed_subscriber *subscriber, path_type const& path) noexcept
+    {
+        hi_assert_not_null(subscriber);
+        auto const lock = std::scoped_lock(_subscriptions_mutex);
+        _subscriptions.insert(path.begin(), path.end(), subscriber);
+    }
+
+    /** Unsubscribe an observer.
+     *
+     * @param subscriber The observer to remove.
+     * @param path The same path that was used to subscribe.
+     */
+    void unsubscribe(observed_subscriber *subscriber, path_type const& path) noexcept
+    {
+        auto const lock = std::scoped_lock(_subscriptions_mutex);
+        _subscriptions.erase(path.begin(), path.end(), subscriber);
+    }
+
+    /** Notify the observers of a modified sub-object.
+     *
+     * @param path The path to the sub-object that was modified.
+     */
+    void notify(path_type const& path) noexcept
+    {
+        auto subscribers = std::vector<observed_subscriber *>{};
+        {
+            auto const lock = std::scoped_lock(_subscriptions_mutex);
+            if (_batch_depth != 0) {
+                add_pending(path);
+                return;
+            }
+            _subscriptions.find(path.begin(), path.end(), subscribers);
+        }
+
+        notify_subscribers(subscribers);
+    }
+
+    /** Start a batch of modifications.
+     *
+     * Until the matching `finish_batch()` notifications are deferred, from
+     * any thread. Batches may be nested.
+     */
+    void start_batch() noexcept
+    {
+        auto const lock = std::scoped_lock(_subscriptions_mutex);
+        ++_batch_depth;
+    }
+
+    /** Finish a batch of modifications.
+     *
+     * When the outermost batch is finished, the observers of all the paths
+     * that were modified are notified; each observer at most once.
+     */
+    void finish_batch() noexcept
+    {
+        auto subscribers = std::vector<observed_subscriber *>{};
+        {
+            auto const lock = std::scoped_lock(_subscriptions_mutex);
+            hi_assert(_batch_depth != 0);
+            if (--_batch_depth != 0) {
+                return;
+            }
+
+            for (auto const& path : _pending_paths) {
+                _subscriptions.find(path.begin(), path.end(), subscribers);
+            }
+            _pending_paths.clear();
+        }
+
+        auto const num_found = subscribers.size();
+        std::sort(subscribers.begin(), subscribers.end());
+        subscribers.erase(std::unique(subscribers.begin(), subscribers.end()), subscribers.end());
+        global_counter<"observer:notify:coalesced"> += num_found - subscribers.size();
+
+        notify_subscribers(subscribers);
+    }
+
+    /** Finish a batch, deferring the notifications to a later time.
+     *
+     * The first deferred batch keeps the batch open, the caller should
+     * arrange for `finish_deferred_batch()` to be called later. Subsequent
+     * deferred batches are merged into the open batch until then.
+     *
+     * @retval true The caller must call `finish_deferred_batch()` later.
+     * @retval false The batch was merged into a batch that is already deferred.
+     */
+    [[nodiscard]] bool defer_finish_batch() noexcept
+    {
+        auto const lock = std::scoped_lock(_subscriptions_mutex);
+        hi_assert(_batch_depth != 0);
+        if (_batch_deferred) {
+            --_batch_depth;
+            return false;
+        } else {
+            _batch_deferred = true;
+            return true;
+        }
+    }
+
+    /** Finish the batch that was deferred by `defer_finish_batch()`.
+     */
+    void finish_deferred_batch() noexcept
+    {
+        {
+            auto const lock = std::scoped_lock(_subscriptions_mutex);
+            hi_assert(_batch_deferred);
+            _batch_deferred = false;
+        }
+        finish_batch();
+    }
+
+private:
+    /** A node in the subscription trie.
+     */
+    struct subscription_node {
+        uint32_t element = 0;
+        std::vector<observed_subscriber *> subscribers;
+
+        /** Children sorted by element.
+         */
+        std::vector<std::unique_ptr<subscription_node>> children;
+
+        [[nodiscard]] bool empty() const noexcept
+        {
+            return subscribers.empty() and children.empty();
+        }
+
+        [[nodiscard]] auto child_it(uint32_t child_element) noexcept
+        {
+            return std::lower_bound(children.begin(), children.end(), child_element, [](auto const& item, uint32_t value) {
+                return item->element < value;
+            });
+        }
+
+        void insert(path_type::const_iterator first, path_type::const_iterator last, observed_subscriber *subscriber) noexcept
+        {
+            if (first == last) {
+                subscribers.push_back(subscriber);
+                return;
+            }
+
+            auto it = child_it(*first);
+            if (it == children.end() or (*it)->element != *first) {
+                it = children.insert(it, std::make_unique<subscription_node>(*first));
+            }
+            (*it)->insert(first + 1, last, subscriber);
+        }
+
+        void erase(path_type::const_iterator first, path_type::const_iterator last, observed_subscriber *subscriber) noexcept
+        {
+            if (first == last) {
+                if (auto const it = std::find(subscribers.begin(), subscribers.end(), subscriber); it != subscribers.end()) {
+                    subscribers.erase(it);
+                }
+                return;
+            }
+
+            auto const it = child_it(*first);
+            if (it != children.end() and (*it)->element == *first) {
+                (*it)->erase(first + 1, last, subscriber);
+                if ((*it)->empty()) {
+                    children.erase(it);
+                }
+            }
+        }
+
+        /** Find the subscribers whose path is a prefix of the given path, or the given path is a prefix of theirs.
+         */
+        void find(path_type::const_iterator first, path_type::const_iterator last, std::vector<observed_subscriber *>& r) noexcept
+        {
+            if (first == last) {
+                find_all(r);
+                return;
+            }
+
+            r.insert(r.end(), subscribers.begin(), subscribers.end());
+            auto const it = child_it(*first);
+            if (it != children.end() and (*it)->element == *first) {
+                (*it)->find(first + 1, last, r);
+            }
+        }
+
+        void find_all(std::vector<observed_subscriber *>& r) const noexcept
+        {
+            r.insert(r.end(), subscribers.begin(), subscribers.end());
+            for (auto const& child : children) {
+                child->find_all(r);
+            }
+        }
+
+        /** Move all subscriptions into another trie.
+         */
+        void move_to(subscription_node& other, path_type& path) noexcept
+        {
+            for (auto *subscriber : subscribers) {
+                other.insert(path.cbegin(), path.cend(), subscriber);
+            }
+            subscribers.clear();
+
+            for (auto const& child : children) {
+                path.push_back(child->element);
+                child->move_to(other, path);
+                path.pop_back();
+            }
+            children.clear();
+        }
+    };
+
+    mutable unfair_mutex _subscriptions_mutex;
+    subscription_node _subscriptions;
+
+    std::size_t _batch_depth = 0;
+    bool _batch_deferred = false;
+
+    /** The paths modified during a batch.
+     *
+     * No path in this list is a prefix of another path in this list.
+     */
+    std::vector<path_type> _pending_paths;
+
+    /** Record a path that was modified during a batch.
+     *
+     * Notifying a path also notifies everything that notifying a longer path
+     * with the same prefix would, so only the shortest paths are kept.
+     */
+    void add_pending(path_type const& path) noexcept
+    {
+        hi_axiom(_subscriptions_mutex.is_locked());
+
+        auto const is_prefix = [](path_type const& prefix, path_type const& other) {
+            return prefix.size() <= other.size() and std::equal(prefix.begin(), prefix.end(), other.begin());
+        };
+
+        for (auto const& pending : _pending_paths) {
+            if (is_prefix(pending, path)) {
+                ++global_counter<"observer:notify:coalesced">;
+                return;
+            }
+        }
+
+        auto const num_removed = std::erase_if(_pending_paths, [&](auto const& pending) {
+            return is_prefix(path, pending);
+        });
+        global_counter<"observer:notify:coalesced"> += num_removed;
+        _pending_paths.push_back(path);
+    }
+
+    void notify_subscribers(std::vector<observed_subscriber *> const& subscribers) noexcept
+    {
+        // The callbacks are called without holding the lock so they are able to (un)subscribe.
+        auto const *ptr = get();
+        for (auto *subscriber : subscribers) {
+            subscriber->notify_observed(ptr);
+        }
+    }
+
+    /** Called when the `group_ptr`s of this object were reseated to @a replacement.
+     *
+     * The observers now belong to @a replacement, so their subscriptions are moved.
+     */
+    void _enable_group_ptr_reseated(observed_base& replacement) noexcept
+    {
+        auto const lock = std::scoped_lock(_subscriptions_mutex, replacement._subscriptions_mutex);
+        auto path = path_type{};
+        _subscriptions.move_to(replacement._subscriptions, path);
+    }
+
+    friend class enable_group_ptr<observed_base, void()>;
 };
 
 template<std::equality_comparable T>
 class observed final : public observed_base {
 public:
     using value_type = T;
-    using path_type = observable_msg::path_type;
+    using path_type = observed_base::path_type;
 
     ~observed() = default;
 
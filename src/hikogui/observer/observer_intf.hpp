@@ -29,13 +29,13 @@ hi_export namespace hi { inline namespace v1 {
  * @tparam T The type of observer.
  */
 template<typename T>
-class observer {
+class observer : private observed_subscriber {
 public:
     using value_type = T;
     using notifier_type = notifier<void(value_type)>;
     using callback_type = notifier_type::callback_type;
     using awaiter_type = notifier_type::awaiter_type;
-    using path_type = observable_msg::path_type;
+    using path_type = observed_base::path_type;
 
     /** A proxy object of the observer.
      *
@@ -332,7 +332,10 @@ public:
     using pointer = proxy_type;
     using const_pointer = value_type const *;
 
-    constexpr ~observer() = default;
+    ~observer()
+    {
+        unsubscribe_state();
+    }
 
     /** Create an observer from an observed_base.
      *
@@ -375,6 +378,8 @@ public:
     constexpr observer(observer&& other) noexcept :
         observer(std::move(other._observed), std::move(other._path), std::move(other._convert))
     {
+        // The other observer was subscribed to the same observed object with the same path.
+        _observed->unsubscribe(std::addressof(other), _path);
         other.reset();
     }
 
@@ -386,13 +391,16 @@ public:
      */
     constexpr observer& operator=(observer const& other) noexcept
     {
+        hi_return_on_self_assignment(other);
+
+        unsubscribe_state();
         _observed = other._observed;
         _path = other._path;
         _convert = other._convert;
 
         // Rewire the callback subscriptions and notify listeners to this observer.
         update_state_callback();
-        _observed->notify_group_ptr(observable_msg{_observed->get(), _path});
+        notify();
         return *this;
     }
 
@@ -405,6 +413,10 @@ public:
      */
     constexpr observer& operator=(observer&& other) noexcept
     {
+        hi_return_on_self_assignment(other);
+
+        unsubscribe_state();
+        other.unsubscribe_state();
         _observed = std::move(other._observed);
         _path = std::move(other._path);
         _convert = std::move(other._convert);
@@ -412,7 +424,7 @@ public:
 
         // Rewire the callback subscriptions and notify listeners to this observer.
         update_state_callback();
-        _observed->notify_group_ptr(observable_msg{_observed->get(), _path});
+        notify();
         return *this;
     }
 
@@ -422,6 +434,7 @@ public:
      */
     void reset() noexcept
     {
+        unsubscribe_state();
         _observed = std::make_shared<observed<value_type>>();
         _path = {};
         _convert = [](void *base) {
@@ -476,7 +489,7 @@ public:
         using result_type = std::decay_t<decltype(std::declval<value_type>()[index])>;
 
         auto new_path = _path;
-        new_path.push_back(std::format("[{}]", index));
+        new_path.push_back(intern_observable_path_element(std::format("[{}]", index)));
         return observer<result_type>{
             _observed, std::move(new_path), [convert_copy = this->_convert, index](void *base) -> void * {
                 return std::addressof((*std::launder(static_cast<value_type *>(convert_copy(base))))[index]);
@@ -495,7 +508,7 @@ public:
         using result_type = std::decay_t<decltype(selector<value_type>{}.template get<Name>(std::declval<value_type&>()))>;
 
         auto new_path = _path;
-        new_path.push_back(std::string{Name});
+        new_path.push_back(intern_observable_path_element(static_cast<std::string_view>(Name)));
         // clang-format off
         return observer<result_type>(
             _observed,
@@ -681,7 +694,7 @@ private:
 
     void notify() const noexcept
     {
-        _observed->notify_group_ptr(observable_msg{_observed->get(), _path});
+        _observed->notify(_path);
     }
 
     value_type *convert(void *base) const noexcept
@@ -694,25 +707,32 @@ private:
         return std::launder(static_cast<value_type const *>(_convert(const_cast<void *>(base))));
     }
 
-    void update_state_callback() noexcept
+    /** Called by the observed object when this' path, or a sub- or super-path, was modified.
+     */
+    void notify_observed(void const *ptr) noexcept override
     {
-        _observed.subscribe([this](observable_msg const& msg) {
-            auto const [msg_it, this_it] = std::mismatch(msg.path.cbegin(), msg.path.cend(), _path.cbegin(), _path.cend());
-            // If the message's path is fully within the this' path, then this is a sub-path.
-            // If this' path is fully within the message's path, then this is along the path.
-            if (msg_it == msg.path.cend() or this_it == _path.cend()) {
 #ifndef NDEBUG
-                _debug_value = *convert(msg.ptr);
+        _debug_value = *convert(ptr);
 #endif
-                _notifier(*convert(msg.ptr));
-            }
-        });
+        _notifier(*convert(ptr));
+    }
+
+    void update_state_callback() noexcept
+    {
+        _observed->subscribe(this, _path);
 
 #ifndef NDEBUG
         _debug_value = *convert(_observed->get());
 #endif
     }
 
+    void unsubscribe_state() noexcept
+    {
+        if (_observed) {
+            _observed->unsubscribe(this, _path);
+        }
+    }
+
     // It is possible to make sub-observables.
     template<typename>
     friend class observer;
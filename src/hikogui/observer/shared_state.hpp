@@ -8,8 +8,10 @@
 #include "observer_intf.hpp"
 #include "../utility/utility.hpp"
 #include "../concurrency/thread.hpp" // XXX #616
+#include "../dispatch/dispatch.hpp"
 #include "../macros.hpp"
 #include <memory>
+#include <utility>
 
 hi_export_module(hikogui.observer : shared_state);
 
@@ -35,6 +37,10 @@ hi_export namespace hi::inline v1 {
  * - Although `observer` are created from another `observer` they internally do not
  *   refer to each other so their lifetime are not connected.
  *
+ * A burst of modifications can be wrapped in a `batch()`, so that each
+ * observer is notified once at the end of the batch, instead of once for
+ * each modification.
+ *
  * @tparam T type used as the shared state.
  */
 template<typename T>
@@ -88,6 +94,87 @@ public:
         return observer().template sub<Name>();
     }
 
+    /** A RAII object which batches the notifications of a shared state.
+     *
+     * While a batch exists the notifications for modifications of the
+     * shared state are recorded; the observers are notified when the
+     * last batch is destroyed.
+     */
+    class batch_type {
+    public:
+        batch_type(batch_type const&) = delete;
+        batch_type& operator=(batch_type const&) = delete;
+
+        ~batch_type()
+        {
+            if (not _pimpl) {
+                return;
+            }
+
+            if (not _deferred) {
+                _pimpl->finish_batch();
+                return;
+            }
+
+            // The posted function keeps the shared state alive until the batch is finished.
+            if (_pimpl->defer_finish_batch()) {
+                loop::main().post_function([pimpl = _pimpl] {
+                    pimpl->finish_deferred_batch();
+                });
+            }
+        }
+
+        batch_type(batch_type&& other) noexcept : _pimpl(std::move(other._pimpl)), _deferred(other._deferred) {}
+
+        batch_type& operator=(batch_type&& other) noexcept
+        {
+            hi_return_on_self_assignment(other);
+            std::swap(_pimpl, other._pimpl);
+            std::swap(_deferred, other._deferred);
+            return *this;
+        }
+
+        batch_type(std::shared_ptr<observed<value_type>> pimpl, bool deferred) noexcept :
+            _pimpl(std::move(pimpl)), _deferred(deferred)
+        {
+            hi_assert_not_null(_pimpl);
+            _pimpl->start_batch();
+        }
+
+    private:
+        std::shared_ptr<observed<value_type>> _pimpl;
+        bool _deferred;
+    };
+
+    /** Start a batch of modifications.
+     *
+     * Until the returned object is destroyed, notifications are recorded
+     * per path; afterwards each observer of a modified path is notified
+     * once. Batches may be nested, and may be started from any thread.
+     *
+     * @return A RAII object which finishes the batch when destroyed.
+     */
+    [[nodiscard]] batch_type batch() const noexcept
+    {
+        return batch_type{_pimpl, false};
+    }
+
+    /** Start a batch of modifications which is delivered from the main-loop.
+     *
+     * When the returned object is destroyed the notifications are posted to
+     * the main-loop; all deferred batches that are finished before the
+     * main-loop gets to it are delivered together, once per iteration.
+     *
+     * If the main-loop is destroyed before it delivers the notifications,
+     * they are dropped together with the shared state.
+     *
+     * @return A RAII object which finishes the batch when destroyed.
+     */
+    [[nodiscard]] batch_type deferred_batch() const noexcept
+    {
+        return batch_type{_pimpl, true};
+    }
+
 private:
     std::shared_ptr<observed<value_type>> _pimpl;
 };
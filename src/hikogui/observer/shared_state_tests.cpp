@@ -6,6 +6,8 @@
 #include "observer_intf.hpp"
 #include "../dispatch/dispatch.hpp"
 #include <hikotest/hikotest.hpp>
+#include <vector>
+#include <algorithm>
 
 namespace shared_state_suite_ns {
 
@@ -218,6 +220,160 @@ TEST_CASE(notify)
     }
 }
 
+TEST_CASE(notify_many)
+{
+    constexpr auto num_observers = 10000;
+
+    auto state = hi::shared_state<std::vector<int>>{std::vector<int>(num_observers, 0)};
+
+    // The observers are not moved after subscribing, as callback subscriptions are not moved.
+    auto observers = std::vector<hi::observer<int>>{};
+    observers.reserve(num_observers);
+    auto cbts = std::vector<hi::callback<void(int)>>{};
+    auto counts = std::vector<int>(num_observers, 0);
+    for (auto i = 0; i != num_observers; ++i) {
+        observers.push_back(state.sub(i));
+        cbts.push_back(observers.back().subscribe([&counts, i](int) {
+            ++counts[i];
+        }));
+    }
+
+    auto all = state.observer();
+    auto all_count = 0;
+    auto all_cbt = all.subscribe([&all_count](auto...) {
+        ++all_count;
+    });
+
+    // A write to an element only reaches the observers of that element and of the whole vector.
+    observers[1234] = 42;
+    REQUIRE(all->at(1234) == 42);
+    REQUIRE(all_count == 1);
+    REQUIRE(counts[1234] == 1);
+    REQUIRE(std::count(counts.begin(), counts.end(), 0) == num_observers - 1);
+
+    // A write to the whole vector reaches all observers.
+    all_count = 0;
+    std::fill(counts.begin(), counts.end(), 0);
+    all->at(5) = 1;
+    REQUIRE(all_count == 1);
+    REQUIRE(std::count(counts.begin(), counts.end(), 1) == num_observers);
+
+    // Destroyed observers are no longer notified.
+    all_count = 0;
+    std::fill(counts.begin(), counts.end(), 0);
+    cbts.clear();
+    observers.clear();
+    all->at(6) = 1;
+    REQUIRE(all_count == 1);
+}
+
+TEST_CASE(batch)
+{
+    using namespace shared_state_suite_ns;
+
+    auto state = hi::shared_state<A>{B{"hello world", 42}, std::vector<int>{5, 15}};
+
+    auto a_count = 0;
+    auto a_cursor = state.observer();
+    auto a_cbt = a_cursor.subscribe([&a_count](auto...) {
+        ++a_count;
+    });
+
+    auto bar_count = 0;
+    auto bar_cursor = state.sub<"b">().sub<"bar">();
+    auto bar_cbt = bar_cursor.subscribe([&bar_count](auto...) {
+        ++bar_count;
+    });
+
+    auto baz0_count = 0;
+    auto baz0_cursor = state.sub<"baz">().sub(0);
+    auto baz0_cbt = baz0_cursor.subscribe([&baz0_count](auto...) {
+        ++baz0_count;
+    });
+
+    {
+        auto const batch = state.batch();
+        for (auto i = 0; i != 10; ++i) {
+            bar_cursor = i;
+        }
+        REQUIRE(a_count == 0);
+        REQUIRE(bar_count == 0);
+
+        {
+            auto const nested_batch = state.batch();
+            state.sub<"b">().sub<"foo">() = "foo";
+        }
+        REQUIRE(a_count == 0);
+        REQUIRE(*bar_cursor == 9);
+    }
+    REQUIRE(a_count == 1);
+    REQUIRE(bar_count == 1);
+    REQUIRE(baz0_count == 0);
+
+    // A modification of a parent includes the modifications of its children.
+    a_count = 0;
+    bar_count = 0;
+    {
+        auto const batch = state.batch();
+        bar_cursor = 1;
+        baz0_cursor = 1;
+        a_cursor->baz.push_back(2);
+    }
+    REQUIRE(a_count == 1);
+    REQUIRE(bar_count == 1);
+    REQUIRE(baz0_count == 1);
+}
+
+TEST_CASE(deferred_batch)
+{
+    using namespace shared_state_suite_ns;
+
+    auto state = hi::shared_state<A>{B{"hello world", 42}, std::vector<int>{5, 15}};
+
+    auto a_count = 0;
+    auto a_cursor = state.observer();
+    auto a_cbt = a_cursor.subscribe([&a_count](auto...) {
+        ++a_count;
+    });
+
+    auto bar_count = 0;
+    auto bar_cursor = state.sub<"b">().sub<"bar">();
+    auto bar_cbt = bar_cursor.subscribe([&bar_count](auto...) {
+        ++bar_count;
+    });
+
+    auto const coalesced = static_cast<uint64_t>(hi::global_counter<"observer:notify:coalesced">);
+
+    // Both batches are delivered together by the main-loop.
+    {
+        auto const batch = state.deferred_batch();
+        bar_cursor = 1;
+    }
+    {
+        auto const batch = state.deferred_batch();
+        bar_cursor = 2;
+    }
+    REQUIRE(a_count == 0);
+    REQUIRE(bar_count == 0);
+
+    hi::loop::main().resume_once();
+    REQUIRE(a_count == 1);
+    REQUIRE(bar_count == 1);
+    REQUIRE(*bar_cursor == 2);
+
+    // The second modification of "b.bar" was merged into the first.
+    REQUIRE(hi::global_counter<"observer:notify:coalesced"> == coalesced + 1);
+
+    // After delivery a new deferred batch is posted again.
+    {
+        auto const batch = state.deferred_batch();
+        bar_cursor = 3;
+    }
+    REQUIRE(bar_count == 1);
+    hi::loop::main().resume_once();
+    REQUIRE(bar_count == 2);
+}
+
 TEST_CASE(value)
 {
     using namespace shared_state_suite_ns;
@@ -17,20 +17,63 @@
 #include <string>
 #include <atomic>
 #include <map>
+#include <optional>
 #include <memory>
 #include <mutex>
 #include <chrono>
 #include <limits>
 #include <concepts>
+#include <array>
+#include <algorithm>
+#include <bit>
 
 hi_export_module(hikogui.telemetry : counters);
 
 
 hi_export namespace hi::inline v1 {
+/** A snapshot of a counter, merged from all shards.
+ */
+struct counter_snapshot {
+    /** The total count, including the number of durations.
+     */
+    uint64_t count = 0;
+
+    /** The number of durations in this snapshot.
+     */
+    uint64_t duration_count = 0;
+
+    std::chrono::nanoseconds duration_min = {};
+    std::chrono::nanoseconds duration_max = {};
+    std::chrono::nanoseconds duration_mean = {};
+    std::chrono::nanoseconds duration_p50 = {};
+    std::chrono::nanoseconds duration_p90 = {};
+    std::chrono::nanoseconds duration_p99 = {};
+    std::chrono::nanoseconds duration_p999 = {};
+};
+
 namespace detail {
 
+/** A counter with optional duration statistics.
+ *
+ * To reduce cache-line bouncing between cores on hot paths, a counter is
+ * split into shards, each on its own cache-lines. A thread always updates
+ * the same shard; the shards are merged when the counter is read.
+ *
+ * Durations are recorded in a log-linear histogram, with 4 linear
+ * sub-buckets per power of two. This gives percentiles with a relative
+ * error of less than 12.5%. The histogram of a shard is allocated when the
+ * first duration is added to it, so that plain counters stay small.
+ */
 class counter {
 public:
+    /** The number of shards, must be a power of two.
+     */
+    constexpr static std::size_t nr_shards = 8;
+
+    /** The number of histogram buckets, enough for any 64 bit duration.
+     */
+    constexpr static std::size_t nr_buckets = 252;
+
     /** Get the named counter.
      *
      * @pre main() must have been started.
@@ -57,9 +100,20 @@ public:
 
     constexpr counter() noexcept {}
 
+    ~counter()
+    {
+        for (auto& shard : _shards) {
+            delete shard.histogram.load(std::memory_order::relaxed);
+        }
+    }
+
     operator uint64_t() const noexcept
     {
-        return _total_count.load(std::memory_order::relaxed);
+        auto r = uint64_t{0};
+        for (auto const& shard : _shards) {
+            r += shard.count.load(std::memory_order::relaxed);
+        }
+        return r;
     }
 
     static void log() noexcept
@@ -75,93 +129,235 @@ public:
     static void log_header() noexcept
     {
         hi_log_statistics("");
-        hi_log_statistics("{:>18} {:>9} {:>10} {:>10} {:>10}", "total", "delta", "min", "max", "mean");
-        hi_log_statistics("------------------ --------- ---------- ---------- ----------");
+        hi_log_statistics(
+            "{:>18} {:>9} {:>10} {:>10} {:>10} {:>10} {:>10} {:>10} {:>10}",
+            "total",
+            "delta",
+            "min",
+            "max",
+            "mean",
+            "p50",
+            "p90",
+            "p99",
+            "p999");
+        hi_log_statistics(
+            "------------------ --------- ---------- ---------- ---------- ---------- ---------- ---------- ----------");
     }
 
     /** Log the counter.
-     */
-    /** Log the counter.
+     *
+     * The duration statistics are reset after logging, so that each log
+     * shows the durations since the previous log.
      */
     void log(std::string const& tag) noexcept
     {
-        auto const total_count = _total_count.load(std::memory_order::relaxed);
-        auto const prev_count = _prev_count.exchange(_total_count, std::memory_order::relaxed);
-        auto const delta_count = total_count - prev_count;
+        auto const snapshot = this->snapshot(true);
+        auto const prev_count = _prev_count.exchange(snapshot.count, std::memory_order::relaxed);
+        auto const delta_count = snapshot.count - prev_count;
         if (delta_count != 0) {
-            auto const duration_max = time_stamp_count::duration_from_count(_duration_max.exchange(0, std::memory_order::relaxed));
-            auto const duration_min = time_stamp_count::duration_from_count(
-                _duration_min.exchange(std::numeric_limits<uint64_t>::max(), std::memory_order::relaxed));
-
-            auto const duration_avg = _duration_avg.exchange(0, std::memory_order::relaxed);
-            if (duration_avg == 0) {
-                hi_log_statistics("{:>18} {:>+9} {:10} {:10} {:10} {}", total_count, delta_count, "", "", "", tag);
+            if (snapshot.duration_count == 0) {
+                hi_log_statistics(
+                    "{:>18} {:>+9} {:10} {:10} {:10} {:10} {:10} {:10} {:10} {}",
+                    snapshot.count,
+                    delta_count,
+                    "",
+                    "",
+                    "",
+                    "",
+                    "",
+                    "",
+                    "",
+                    tag);
 
             } else {
-                auto const avg_count = duration_avg & 0xffff;
-                auto const avg_sum = duration_avg >> 16;
-                auto const average = time_stamp_count::duration_from_count(avg_sum / avg_count);
-
                 hi_log_statistics(
-                    "{:18d} {:+9d} {:>10} {:>10} {:>10} {}",
-                    total_count,
+                    "{:18d} {:+9d} {:>10} {:>10} {:>10} {:>10} {:>10} {:>10} {:>10} {}",
+                    snapshot.count,
                     delta_count,
-                    format_engineering(duration_min),
-                    format_engineering(duration_max),
-                    format_engineering(average),
+                    format_engineering(snapshot.duration_min),
+                    format_engineering(snapshot.duration_max),
+                    format_engineering(snapshot.duration_mean),
+                    format_engineering(snapshot.duration_p50),
+                    format_engineering(snapshot.duration_p90),
+                    format_engineering(snapshot.duration_p99),
+                    format_engineering(snapshot.duration_p999),
                     tag);
             }
         }
     }
 
-    /** Rest the counter.
-     * 
-     * @return Old value of the 
+    /** Take a snapshot of the counter.
+     *
+     * @param reset_durations Reset the duration statistics while taking
+     *                        the snapshot. The count is never reset.
+     * @return The count and duration statistics merged from all shards.
+     */
+    [[nodiscard]] counter_snapshot snapshot(bool reset_durations = false) noexcept
+    {
+        auto const take = [reset_durations](std::atomic<uint64_t>& x, uint64_t reset_value) {
+            if (reset_durations) {
+                return x.exchange(reset_value, std::memory_order::relaxed);
+            } else {
+                return x.load(std::memory_order::relaxed);
+            }
+        };
+
+        auto r = counter_snapshot{};
+        auto histogram = std::array<uint64_t, nr_buckets>{};
+        auto duration_sum = uint64_t{0};
+        auto duration_min = std::numeric_limits<uint64_t>::max();
+        auto duration_max = uint64_t{0};
+
+        for (auto& shard : _shards) {
+            r.count += shard.count.load(std::memory_order::relaxed);
+            duration_sum += take(shard.duration_sum, 0);
+            duration_min = std::min(duration_min, take(shard.duration_min, std::numeric_limits<uint64_t>::max()));
+            duration_max = std::max(duration_max, take(shard.duration_max, 0));
+            if (auto const shard_histogram = shard.histogram.load(std::memory_order::acquire)) {
+                for (auto i = 0_uz; i != nr_buckets; ++i) {
+                    histogram[i] += take((*shard_histogram)[i], 0);
+                }
+            }
+        }
+
+        for (auto const n : histogram) {
+            r.duration_count += n;
+        }
+        if (r.duration_count == 0) {
+            return r;
+        }
+
+        auto const percentile = [&](uint64_t permille) {
+            // The rank of the sample, rounded up.
+            auto const rank = std::max(uint64_t{1}, (r.duration_count * permille + 999) / 1000);
+            auto seen = uint64_t{0};
+            for (auto i = 0_uz; i != nr_buckets; ++i) {
+                seen += histogram[i];
+                if (seen >= rank) {
+                    return time_stamp_count::duration_from_count(std::clamp(bucket_mid(i), duration_min, duration_max));
+                }
+            }
+            return time_stamp_count::duration_from_count(duration_max);
+        };
+
+        r.duration_min = time_stamp_count::duration_from_count(duration_min);
+        r.duration_max = time_stamp_count::duration_from_count(duration_max);
+        r.duration_mean = time_stamp_count::duration_from_count(duration_sum / r.duration_count);
+        r.duration_p50 = percentile(500);
+        r.duration_p90 = percentile(900);
+        r.duration_p99 = percentile(990);
+        r.duration_p999 = percentile(999);
+        return r;
+    }
+
+    /** Reset the counter.
+     *
+     * After a reset `increment_is_first()` returns true again for the next increment.
      */
     counter &operator=(std::integral auto count) noexcept
     {
         hi_axiom(count >= 0);
-        _total_count.store(count, std::memory_order::relaxed);
+        _shards[0].count.store(count, std::memory_order::relaxed);
+        for (auto i = 1_uz; i != nr_shards; ++i) {
+            _shards[i].count.store(0, std::memory_order::relaxed);
+        }
+        _seen.store(false, std::memory_order::relaxed);
         return *this;
     }
 
-    uint64_t operator++() noexcept
+    counter& operator++() noexcept
     {
-        return _total_count.fetch_add(1, std::memory_order::relaxed) + 1;
+        current_shard().count.fetch_add(1, std::memory_order::relaxed);
+        return *this;
     }
 
-    uint64_t operator++(int) noexcept
+    counter& operator--() noexcept
     {
-        return _total_count.fetch_add(1, std::memory_order::relaxed);
+        current_shard().count.fetch_sub(1, std::memory_order::relaxed);
+        return *this;
     }
 
-    uint64_t operator--() noexcept
+    counter& operator+=(uint64_t rhs) noexcept
     {
-        return _total_count.fetch_sub(1, std::memory_order::relaxed) + 1;
+        current_shard().count.fetch_add(rhs, std::memory_order::relaxed);
+        return *this;
     }
 
-    uint64_t operator--(int) noexcept
+    /** Increment the counter and check if this was the first increment.
+     *
+     * Exactly one caller will see true, even when multiple threads
+     * increment at the same time.
+     */
+    [[nodiscard]] bool increment_is_first() noexcept
     {
-        return _total_count.fetch_sub(1, std::memory_order::relaxed);
+        ++*this;
+        return not _seen.load(std::memory_order::relaxed) and not _seen.exchange(true, std::memory_order::relaxed);
     }
 
     /** Add a duration.
      */
     void add_duration(uint64_t duration) noexcept
     {
-        _total_count.fetch_add(1, std::memory_order::relaxed);
-        fetch_max(_duration_max, duration, std::memory_order::relaxed);
-        fetch_min(_duration_min, duration, std::memory_order::relaxed);
+        auto& shard = current_shard();
+        shard.count.fetch_add(1, std::memory_order::relaxed);
+        shard.duration_sum.fetch_add(duration, std::memory_order::relaxed);
+        fetch_max(shard.duration_max, duration, std::memory_order::relaxed);
+        fetch_min(shard.duration_min, duration, std::memory_order::relaxed);
+        get_histogram(shard)[bucket_index(duration)].fetch_add(1, std::memory_order::relaxed);
+    }
+
+    /** Get the histogram bucket of a duration.
+     */
+    [[nodiscard]] constexpr static std::size_t bucket_index(uint64_t duration) noexcept
+    {
+        if (duration < 4) {
+            return narrow_cast<std::size_t>(duration);
+        }
+
+        auto const exponent = narrow_cast<std::size_t>(std::bit_width(duration)) - 1;
+        auto const mantissa = narrow_cast<std::size_t>((duration >> (exponent - 2)) & 3);
+        return (exponent - 1) * 4 + mantissa;
+    }
+
+    /** Get the lowest duration that falls in a histogram bucket.
+     */
+    [[nodiscard]] constexpr static uint64_t bucket_low(std::size_t index) noexcept
+    {
+        if (index < 4) {
+            return index;
+        }
 
-        // Combine duration with count in a single atomic.
-        hi_axiom(duration <= (std::numeric_limits<uint64_t>::max() >> 10));
-        duration <<= 16;
-        ++duration;
-        _duration_avg.fetch_add(duration, std::memory_order::relaxed);
+        auto const exponent = index / 4 + 1;
+        auto const mantissa = index % 4;
+        return uint64_t{4 + mantissa} << (exponent - 2);
+    }
+
+    /** Get the middle of a histogram bucket.
+     */
+    [[nodiscard]] constexpr static uint64_t bucket_mid(std::size_t index) noexcept
+    {
+        if (index < 4) {
+            return index;
+        }
+
+        auto const exponent = index / 4 + 1;
+        return bucket_low(index) + ((uint64_t{1} << (exponent - 2)) >> 1);
     }
 
 protected:
     using map_type = std::map<std::string, counter *>;
+    using histogram_type = std::array<std::atomic<uint64_t>, nr_buckets>;
+
+    struct alignas(destructive_interference_size) shard_type {
+        std::atomic<uint64_t> count = 0;
+        std::atomic<uint64_t> duration_sum = 0;
+        std::atomic<uint64_t> duration_max = 0;
+        std::atomic<uint64_t> duration_min = std::numeric_limits<uint64_t>::max();
+
+        /** The histogram of durations, nullptr until the first duration is added.
+         */
+        std::atomic<histogram_type *> histogram = nullptr;
+    };
 
     /** Mutex for managing _map.
      * We disable the dead_lock_detector, so that this mutex can be used before main().
@@ -169,17 +365,41 @@ protected:
     constinit static inline unfair_mutex_impl<false> _mutex;
     constinit static inline atomic_unique_ptr<map_type> _map;
 
-    std::atomic<uint64_t> _total_count = 0;
+    std::array<shard_type, nr_shards> _shards = {};
     std::atomic<uint64_t> _prev_count = 0;
-    std::atomic<uint64_t> _duration_max = 0;
-    std::atomic<uint64_t> _duration_min = std::numeric_limits<uint64_t>::max();
+    std::atomic<bool> _seen = false;
 
-    /** Average duration.
+    /** Get the shard for the current thread.
      *
-     * - [9:0] Count.
-     * - [63:10] Sum.
+     * Threads are assigned to shards round-robin on first use.
+     */
+    [[nodiscard]] shard_type& current_shard() noexcept
+    {
+        thread_local auto const index = [] {
+            constinit static std::atomic<std::size_t> next_index = 0;
+            return next_index.fetch_add(1, std::memory_order::relaxed) % nr_shards;
+        }();
+        return _shards[index];
+    }
+
+    /** Get the histogram of a shard, allocating it on first use.
      */
-    std::atomic<uint64_t> _duration_avg = 0;
+    [[nodiscard]] static histogram_type& get_histogram(shard_type& shard) noexcept
+    {
+        if (auto const r = shard.histogram.load(std::memory_order::acquire)) {
+            return *r;
+        }
+
+        // Another thread on the same shard may allocate at the same time, only one of them wins.
+        auto new_histogram = std::make_unique<histogram_type>();
+        auto expected = static_cast<histogram_type *>(nullptr);
+        if (shard.histogram.compare_exchange_strong(
+                expected, new_histogram.get(), std::memory_order::acq_rel, std::memory_order::acquire)) {
+            return *new_histogram.release();
+        } else {
+            return *expected;
+        }
+    }
 };
 
 template<fixed_string Tag>
@@ -204,6 +424,20 @@ inline detail::tagged_counter<Tag> global_counter;
     return detail::counter::get_if(name);
 }
 
+/** Take a snapshot of a named counter.
+ *
+ * @param name The name of the counter.
+ * @return The snapshot, or std::nullopt if the counter is not found.
+ */
+[[nodiscard]] inline std::optional<counter_snapshot> get_global_counter_snapshot(std::string const& name)
+{
+    if (auto const counter = get_global_counter_if(name)) {
+        return counter->snapshot();
+    } else {
+        return std::nullopt;
+    }
+}
+
 inline void log::log_thread_main(std::stop_token stop_token) noexcept
 {
     using namespace std::chrono_literals;
@@ -219,6 +453,7 @@ inline void log::log_thread_main(std::stop_token stop_token) noexcept
         auto const now = std::chrono::utc_clock::now();
         if (now >= counter_statistics_deadline) {
             counter_statistics_deadline = now + 1min;
+            global_counter<"log:blocked"> = log_global.nr_blocked();
             detail::counter::log();
         }
 
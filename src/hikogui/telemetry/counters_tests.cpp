@@ -4,6 +4,9 @@
 
 #include "counters.hpp"
 #include <hikotest/hikotest.hpp>
+#include <thread>
+#include <vector>
+#include <limits>
 
 TEST_SUITE(counters) {
 
@@ -35,4 +38,84 @@ TEST_CASE(search_and_read)
     REQUIRE(*hi::get_global_counter_if("bar_b") == 2);
 }
 
-};
\ No newline at end of file
+TEST_CASE(sharded_increment)
+{
+    hi::global_counter<"foo_c"> = 0;
+
+    auto threads = std::vector<std::thread>{};
+    for (auto i = 0; i != 16; ++i) {
+        threads.emplace_back([] {
+            for (auto j = 0; j != 1000; ++j) {
+                ++hi::global_counter<"foo_c">;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    REQUIRE(hi::global_counter<"foo_c"> == 16000);
+}
+
+TEST_CASE(increment_is_first)
+{
+    REQUIRE(hi::global_counter<"foo_d">.increment_is_first());
+    REQUIRE(not hi::global_counter<"foo_d">.increment_is_first());
+    REQUIRE(hi::global_counter<"foo_d"> == 2);
+
+    // After a reset the next increment is the first again.
+    hi::global_counter<"foo_d"> = 0;
+    REQUIRE(hi::global_counter<"foo_d">.increment_is_first());
+    REQUIRE(not hi::global_counter<"foo_d">.increment_is_first());
+}
+
+TEST_CASE(counter_size)
+{
+    // The histograms are allocated on the first duration, so a plain counter is small.
+    REQUIRE(sizeof(hi::detail::counter) <= 2048);
+
+    hi::global_counter<"foo_f"> = 0;
+    ++hi::global_counter<"foo_f">;
+    REQUIRE(hi::global_counter<"foo_f">.snapshot().duration_count == 0);
+
+    hi::global_counter<"foo_f">.add_duration(1000);
+    REQUIRE(hi::global_counter<"foo_f">.snapshot().duration_count == 1);
+    REQUIRE(hi::global_counter<"foo_f"> == 2);
+}
+
+TEST_CASE(histogram_bucket)
+{
+    using hi::detail::counter;
+
+    for (auto i = std::size_t{0}; i != counter::nr_buckets; ++i) {
+        REQUIRE(counter::bucket_index(counter::bucket_low(i)) == i);
+    }
+    REQUIRE(counter::bucket_index(std::numeric_limits<uint64_t>::max()) == counter::nr_buckets - 1);
+}
+
+TEST_CASE(histogram_percentiles)
+{
+    for (auto i = uint64_t{1}; i <= 1000; ++i) {
+        hi::global_counter<"foo_e">.add_duration(i * 1000);
+    }
+
+    auto const snapshot = hi::global_counter<"foo_e">.snapshot();
+    REQUIRE(snapshot.count == 1000);
+    REQUIRE(snapshot.duration_count == 1000);
+
+    // Durations are in clock ticks; compare in ticks through the same conversion.
+    auto const to_ns = [](uint64_t count) {
+        return hi::time_stamp_count::duration_from_count(count);
+    };
+    REQUIRE(snapshot.duration_min == to_ns(1000));
+    REQUIRE(snapshot.duration_max == to_ns(1000000));
+    REQUIRE(snapshot.duration_p50 >= to_ns(500000 * 7 / 8) and snapshot.duration_p50 <= to_ns(500000 * 9 / 8));
+    REQUIRE(snapshot.duration_p99 >= to_ns(990000 * 7 / 8) and snapshot.duration_p99 <= to_ns(1000000));
+
+    auto const reset = hi::global_counter<"foo_e">.snapshot(true);
+    REQUIRE(reset.duration_count == 1000);
+    REQUIRE(hi::global_counter<"foo_e">.snapshot().duration_count == 0);
+    REQUIRE(hi::global_counter<"foo_e"> == 1000);
+}
+
+};
@@ -62,6 +62,27 @@ public:
         return std::apply(format_locale_wrapper<Values const &...>, _values);
     }
 
+    /** Format now, appending to an output iterator.
+     * @param out The output iterator to write the formatted text to.
+     * @return The output iterator past the formatted text.
+     */
+    template<typename OutputIt>
+    OutputIt format_to(OutputIt out) const noexcept
+    {
+        return std::apply(
+            [&out](Values const&...args) {
+                return std::vformat_to(out, static_cast<std::string_view>(Fmt), std::make_format_args(args...));
+            },
+            _values);
+    }
+
+    /** The captured arguments.
+     */
+    [[nodiscard]] std::tuple<Values...> const& values() const noexcept
+    {
+        return _values;
+    }
+
 private:
     std::tuple<Values...> _values;
 
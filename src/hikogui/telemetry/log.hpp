@@ -6,6 +6,8 @@
 
 #include "delayed_format.hpp"
 #include "format_check.hpp"
+#include "log_file.hpp"
+#include "log_binary.hpp"
 #include "../container/container.hpp"
 #include "../time/time.hpp"
 #include "../utility/utility.hpp"
@@ -17,6 +19,8 @@
 #include <string>
 #include <string_view>
 #include <tuple>
+#include <utility>
+#include <iterator>
 #include <mutex>
 #include <atomic>
 #include <memory>
@@ -35,8 +39,22 @@ public:
     hi_force_inline log_message_base() noexcept = default;
     virtual ~log_message_base() = default;
 
-    [[nodiscard]] virtual std::string format() const noexcept = 0;
-    [[nodiscard]] virtual std::unique_ptr<log_message_base> make_unique_copy() const noexcept = 0;
+    /** Format the message and append it to a buffer.
+     *
+     * @param out The buffer to append the message and a line-feed to.
+     */
+    virtual void format_to(std::string& out) const noexcept = 0;
+
+    /** Encode the message as binary records and append it to a buffer.
+     *
+     * A definition record is appended first when this log statement
+     * has not been written to the current file generation.
+     *
+     * @param out The buffer to append the records to.
+     * @param generation The generation of the log file.
+     * @param next_id The next free definition id, incremented when a definition is appended.
+     */
+    virtual void encode_to(std::string& out, std::size_t generation, uint32_t& next_id) const noexcept = 0;
 };
 
 template<global_state_type Level, fixed_string SourcePath, int SourceLine, fixed_string Fmt, typename... Values>
@@ -57,6 +75,14 @@ public:
         "<unknown log level>";
     // clang-format on
 
+    /** The filename part of the source path, determined at compile time.
+     */
+    constexpr static std::string_view source_filename = [] {
+        auto const path = static_cast<std::string_view>(SourcePath);
+        auto const i = path.find_last_of("/\\");
+        return i == std::string_view::npos ? path : path.substr(i + 1);
+    }();
+
     log_message(log_message const&) noexcept = default;
     log_message& operator=(log_message const&) noexcept = default;
 
@@ -66,7 +92,7 @@ public:
     {
     }
 
-    std::string format() const noexcept override
+    void format_to(std::string& out) const noexcept override
     {
         auto const utc_time_point = time_stamp_utc::make(_time_stamp);
         auto const sys_time_point = std::chrono::clock_cast<std::chrono::system_clock>(utc_time_point);
@@ -76,30 +102,41 @@ public:
         auto const thread_id = _time_stamp.thread_id();
         auto const thread_name = get_thread_name(thread_id);
 
+        auto it = std::back_inserter(out);
+        it = std::format_to(it, "{} {}({}) {:5} ", local_time_point, thread_name, cpu_id, log_level_name);
+        it = _what.format_to(it);
         if constexpr (to_bool(Level & global_state_type::log_statistics)) {
-            return std::format("{} {}({}) {:5} {}", local_time_point, thread_name, cpu_id, log_level_name, _what());
+            *it = '\n';
         } else {
-            auto source_filename = std::filesystem::path{static_cast<std::string_view>(SourcePath)}.filename().generic_string();
-            return std::format(
-                "{} {}({}) {:5} {} ({}:{})",
-                local_time_point,
-                thread_name,
-                cpu_id,
-                log_level_name,
-                _what(),
-                source_filename,
-                SourceLine);
+            std::format_to(it, " ({}:{})\n", source_filename, SourceLine);
         }
     }
 
-    [[nodiscard]] std::unique_ptr<log_message_base> make_unique_copy() const noexcept override
+    void encode_to(std::string& out, std::size_t generation, uint32_t& next_id) const noexcept override
     {
-        return std::make_unique<log_message>(*this);
+        if (_binary_generation != generation) {
+            _binary_generation = generation;
+            _binary_id = next_id++;
+            log_binary_append_definition(
+                out, _binary_id, log_level_name, source_filename, SourceLine, static_cast<std::string_view>(Fmt));
+        }
+
+        auto const utc_time_point = time_stamp_utc::make(_time_stamp);
+        log_binary_append_message(out, _binary_id, utc_time_point, _time_stamp.thread_id(), _time_stamp.cpu_id(), _what.values());
     }
 
 private:
     time_stamp_count _time_stamp;
     delayed_format<Fmt, Values...> _what;
+
+    /** The file generation for which the definition was written.
+     * Only accessed by the thread holding the log's consumer-lock.
+     */
+    static inline std::size_t _binary_generation = 0;
+
+    /** The definition id in the current file generation.
+     */
+    static inline uint32_t _binary_id = 0;
 };
 
 } // namespace detail
@@ -143,26 +180,94 @@ public:
     /** Flush all messages from the log_queue directly from this thread.
      * Flushing includes writing the message to a log file or displaying
      * them on the console.
+     *
+     * Messages are formatted directly from the fifo into a reusable buffer,
+     * which is written in batches. Formatting is done while only holding
+     * the consumer-lock of the fifo; the file-lock is only held while writing.
      */
     hi_no_inline void flush() noexcept
     {
-        bool wrote_message;
-        do {
-            std::unique_ptr<detail::log_message_base> copy_of_message;
+        while (true) {
+            auto consumer_lock = std::unique_lock(_consumer_mutex);
 
+            auto binary = false;
+            auto generation = 0_uz;
             {
                 auto const lock = std::scoped_lock(_mutex);
-
-                wrote_message = _fifo.take_one([&copy_of_message](auto& message) {
-                    copy_of_message = message.make_unique_copy();
-                });
+                if (_file) {
+                    _file->rotate_if_needed();
+                    binary = _file->binary();
+                    generation = _file->generation();
+                }
             }
 
-            if (wrote_message) {
-                hi_assert_not_null(copy_of_message);
-                write(copy_of_message->format());
+            auto const format_message = [&](detail::log_message_base const& message) {
+                if (binary) {
+                    message.encode_to(_buffer, generation, _binary_next_id);
+                } else {
+                    message.format_to(_buffer);
+                }
+            };
+
+            while (_buffer.size() < batch_size and _fifo.take_n(format_message, 64) != 0) {}
+
+            if (_buffer.empty()) {
+                return;
             }
-        } while (wrote_message);
+
+            // Take the file-lock before releasing the consumer-lock, so that
+            // batches are written in the order they were taken from the fifo.
+            auto const lock = std::scoped_lock(_mutex);
+            std::swap(_buffer, _write_buffer);
+            consumer_lock.unlock();
+
+            write();
+        }
+    }
+
+    /** The number of times a thread was blocked because the log queue was full.
+     */
+    [[nodiscard]] std::size_t nr_blocked() const noexcept
+    {
+        return _fifo.nr_contended();
+    }
+
+    /** Open a log file.
+     *
+     * After opening, the logger thread appends messages to the file in
+     * batches, rotating the file based on size and age.
+     *
+     * The telemetry module is below the path module, so the caller needs
+     * to pass the directory, for example `log_dir()`.
+     *
+     * @param directory The directory to write the log files to.
+     * @param options The name, rotation and binary-mode options.
+     * @throw io_error When the log file could not be opened.
+     */
+    void open_file(std::filesystem::path directory, log_file_options options = {})
+    {
+        auto file = std::make_unique<log_file>(std::move(directory), std::move(options));
+
+        {
+            // The consumer-lock makes sure that messages are not formatted for the old file
+            // and written to the new file.
+            auto const consumer_lock = std::scoped_lock(_consumer_mutex);
+            auto const lock = std::scoped_lock(_mutex);
+            std::swap(_file, file);
+        }
+        // The old file is closed here, outside of the locks.
+    }
+
+    /** Close the log file.
+     */
+    void close_file() noexcept
+    {
+        auto file = std::unique_ptr<log_file>{};
+        {
+            auto const consumer_lock = std::scoped_lock(_consumer_mutex);
+            auto const lock = std::scoped_lock(_mutex);
+            std::swap(_file, file);
+        }
     }
 
     /** Start the logger system.
@@ -183,18 +288,60 @@ public:
     }
 
 private:
+    /** The size of the buffer after which it is written.
+     */
+    constexpr static std::size_t batch_size = 16384;
+
     /** The global log queue contains messages to be displayed by the logger thread.
      */
     wfree_fifo<detail::log_message_base, 64> _fifo;
+
+    /** The lock for the single consumer of the fifo.
+     * Protects `_buffer` and `_binary_next_id`.
+     */
+    mutable unfair_mutex _consumer_mutex;
+
+    /** The lock for writing.
+     * Protects `_file` and `_write_buffer`.
+     */
     mutable unfair_mutex _mutex;
 
-    /** Write to a log file and console.
-     * This will write to the console if one is open.
-     * It will also create a log file in the application-data directory.
+    /** Messages being formatted by the consumer.
+     * The buffer keeps its capacity between writes.
+     */
+    std::string _buffer;
+
+    /** Formatted messages being written.
+     * Swapped with `_buffer`, so that both keep their capacity.
+     */
+    std::string _write_buffer;
+
+    /** The log file opened with `open_file()`.
+     */
+    std::unique_ptr<log_file> _file;
+
+    /** The next definition id for binary log records.
      */
-    void write(std::string const& str) const noexcept
+    uint32_t _binary_next_id = 0;
+
+    /** Write `_write_buffer` to the log file and console.
+     *
+     * @pre `_mutex` must be held.
+     *
+     * Text is written to both the log file, if one is open, and the console.
+     * Binary records are only written to the log file.
+     */
+    void write() noexcept
     {
-        std::println(stderr, "{}", str);
+        if (_file) {
+            _file->write(_write_buffer);
+        }
+
+        if (not _file or not _file->binary()) {
+            // stderr is unbuffered, so this is a single write.
+            std::fwrite(_write_buffer.data(), 1, _write_buffer.size(), stderr);
+        }
+        _write_buffer.clear();
     }
 
     /** The global logger thread.
@@ -0,0 +1,359 @@
+// Copyright Take Vos 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+/** @file telemetry/log_binary.hpp Compact binary log records.
+ *
+ * A binary log file starts with `log_binary_magic`, followed by records.
+ * All integers are little-endian.
+ *
+ * A definition record is written once per log statement per file:
+ *  - `log_binary_record::definition` (u8)
+ *  - id (u32)
+ *  - level name, source filename (strings)
+ *  - source line (u32)
+ *  - format string (string)
+ *
+ * A message record is written for each logged message:
+ *  - `log_binary_record::message` (u8)
+ *  - id of the definition (u32)
+ *  - UTC time in nanoseconds since epoch (i64)
+ *  - thread id (u32), cpu id (i32)
+ *  - number of arguments (u8), followed by the arguments, each prefixed
+ *    by a `log_binary_argument` (u8).
+ *
+ * Strings are a length (u32) followed by UTF-8 bytes.
+ */
+
+#pragma once
+
+#include "../utility/utility.hpp"
+#include "../macros.hpp"
+#include <string>
+#include <string_view>
+#include <span>
+#include <map>
+#include <tuple>
+#include <vector>
+#include <variant>
+#include <format>
+#include <chrono>
+#include <bit>
+#include <iterator>
+#include <cstring>
+#include <cstddef>
+#include <cstdint>
+#include <concepts>
+#include <type_traits>
+#include <utility>
+
+hi_export_module(hikogui.telemetry : log_binary);
+
+hi_export namespace hi { inline namespace v1 {
+namespace detail {
+
+/** The magic at the start of a binary log file.
+ */
+constexpr auto log_binary_magic = std::string_view{"hilog\0\1\n", 8};
+
+enum class log_binary_record : uint8_t { definition = 1, message = 2 };
+
+enum class log_binary_argument : uint8_t {
+    boolean = 1,
+    signed_integer = 2,
+    unsigned_integer = 3,
+    floating_point = 4,
+    character = 5,
+    string = 6
+};
+
+template<std::integral T>
+void log_binary_append(std::string& out, T value) noexcept
+{
+    auto const offset = out.size();
+    out.resize(offset + sizeof(T));
+    store_le(value, static_cast<void *>(out.data() + offset));
+}
+
+inline void log_binary_append(std::string& out, std::string_view str) noexcept
+{
+    log_binary_append(out, narrow_cast<uint32_t>(str.size()));
+    out.append(str);
+}
+
+/** Append an argument of a log message.
+ *
+ * Arithmetic and string arguments are stored as-is. Other arguments are
+ * formatted with `std::format("{}")` and stored as a string, which means
+ * their format-spec is lost.
+ */
+template<typename T>
+void log_binary_append_argument(std::string& out, T const& arg) noexcept
+{
+    if constexpr (std::is_same_v<T, bool>) {
+        log_binary_append(out, std::to_underlying(log_binary_argument::boolean));
+        log_binary_append(out, uint8_t{arg});
+
+    } else if constexpr (std::is_same_v<T, char>) {
+        log_binary_append(out, std::to_underlying(log_binary_argument::character));
+        log_binary_append(out, static_cast<uint8_t>(arg));
+
+    } else if constexpr (std::signed_integral<T>) {
+        log_binary_append(out, std::to_underlying(log_binary_argument::signed_integer));
+        log_binary_append(out, static_cast<int64_t>(arg));
+
+    } else if constexpr (std::unsigned_integral<T>) {
+        log_binary_append(out, std::to_underlying(log_binary_argument::unsigned_integer));
+        log_binary_append(out, static_cast<uint64_t>(arg));
+
+    } else if constexpr (std::floating_point<T>) {
+        log_binary_append(out, std::to_underlying(log_binary_argument::floating_point));
+        log_binary_append(out, std::bit_cast<uint64_t>(static_cast<double>(arg)));
+
+    } else if constexpr (std::is_convertible_v<T const&, std::string_view>) {
+        log_binary_append(out, std::to_underlying(log_binary_argument::string));
+        log_binary_append(out, static_cast<std::string_view>(arg));
+
+    } else {
+        log_binary_append(out, std::to_underlying(log_binary_argument::string));
+        log_binary_append(out, std::string_view{std::format("{}", arg)});
+    }
+}
+
+inline void log_binary_append_definition(
+    std::string& out,
+    uint32_t id,
+    std::string_view level_name,
+    std::string_view source_filename,
+    int source_line,
+    std::string_view fmt) noexcept
+{
+    log_binary_append(out, std::to_underlying(log_binary_record::definition));
+    log_binary_append(out, id);
+    log_binary_append(out, level_name);
+    log_binary_append(out, source_filename);
+    log_binary_append(out, narrow_cast<uint32_t>(source_line));
+    log_binary_append(out, fmt);
+}
+
+template<typename... Values>
+void log_binary_append_message(
+    std::string& out,
+    uint32_t id,
+    std::chrono::utc_time<std::chrono::nanoseconds> time_point,
+    uint32_t thread_id,
+    ssize_t cpu_id,
+    std::tuple<Values...> const& values) noexcept
+{
+    static_assert(sizeof...(Values) <= 255);
+
+    log_binary_append(out, std::to_underlying(log_binary_record::message));
+    log_binary_append(out, id);
+    log_binary_append(out, static_cast<int64_t>(time_point.time_since_epoch().count()));
+    log_binary_append(out, thread_id);
+    log_binary_append(out, narrow_cast<int32_t>(cpu_id));
+    log_binary_append(out, narrow_cast<uint8_t>(sizeof...(Values)));
+    std::apply(
+        [&out](Values const&...args) {
+            (log_binary_append_argument(out, args), ...);
+        },
+        values);
+}
+
+using log_binary_value = std::variant<bool, char, int64_t, uint64_t, double, std::string>;
+
+/** Format with arguments only known at runtime.
+ *
+ * Supports automatic and manual argument indexing and format-specs, but not
+ * nested replacement fields in the format-spec.
+ */
+[[nodiscard]] inline std::string log_binary_format(std::string_view fmt, std::vector<log_binary_value> const& args)
+{
+    auto r = std::string{};
+    auto next_index = 0_uz;
+
+    for (auto i = 0_uz; i != fmt.size(); ++i) {
+        auto const c = fmt[i];
+        if (c == '}') {
+            hi_check(i + 1 != fmt.size() and fmt[i + 1] == '}', "Single '}}' in format string");
+            r += '}';
+            ++i;
+
+        } else if (c != '{') {
+            r += c;
+
+        } else if (i + 1 != fmt.size() and fmt[i + 1] == '{') {
+            r += '{';
+            ++i;
+
+        } else {
+            auto const last = fmt.find('}', i);
+            hi_check(last != std::string_view::npos, "Missing '}}' in format string");
+
+            auto const field = fmt.substr(i + 1, last - i - 1);
+            hi_check(field.find('{') == std::string_view::npos, "Nested replacement fields are not supported");
+
+            auto const colon = field.find(':');
+            auto const arg_id = field.substr(0, colon);
+            auto const spec = colon == std::string_view::npos ? std::string_view{} : field.substr(colon);
+
+            auto index = next_index++;
+            if (not arg_id.empty()) {
+                index = 0;
+                for (auto const digit : arg_id) {
+                    hi_check(digit >= '0' and digit <= '9', "Invalid argument id in format string");
+                    index = index * 10 + (digit - '0');
+                }
+            }
+            hi_check(index < args.size(), "Missing argument for format string");
+
+            auto const field_fmt = std::format("{{{}}}", spec);
+            std::visit(
+                [&](auto const& arg) {
+                    r += std::vformat(field_fmt, std::make_format_args(arg));
+                },
+                args[index]);
+
+            i = last;
+        }
+    }
+    return r;
+}
+
+class log_binary_reader {
+public:
+    log_binary_reader(std::span<std::byte const> bytes) noexcept : _bytes(bytes) {}
+
+    [[nodiscard]] bool empty() const noexcept
+    {
+        return _offset == _bytes.size();
+    }
+
+    template<std::integral T>
+    [[nodiscard]] T get()
+    {
+        hi_check(_offset + sizeof(T) <= _bytes.size(), "Binary log record is truncated");
+        auto const r = load_le<T>(_bytes.data() + _offset);
+        _offset += sizeof(T);
+        return r;
+    }
+
+    [[nodiscard]] std::string get_string()
+    {
+        auto const size = get<uint32_t>();
+        hi_check(_offset + size <= _bytes.size(), "Binary log record is truncated");
+        auto const first = reinterpret_cast<char const *>(_bytes.data() + _offset);
+        _offset += size;
+        return std::string{first, size};
+    }
+
+    [[nodiscard]] log_binary_value get_argument()
+    {
+        switch (static_cast<log_binary_argument>(get<uint8_t>())) {
+        case log_binary_argument::boolean:
+            return get<uint8_t>() != 0;
+        case log_binary_argument::character:
+            return static_cast<char>(get<uint8_t>());
+        case log_binary_argument::signed_integer:
+            return get<int64_t>();
+        case log_binary_argument::unsigned_integer:
+            return get<uint64_t>();
+        case log_binary_argument::floating_point:
+            return std::bit_cast<double>(get<uint64_t>());
+        case log_binary_argument::string:
+            return get_string();
+        default:
+            throw parse_error("Unknown argument type in binary log");
+        }
+    }
+
+private:
+    std::span<std::byte const> _bytes;
+    std::size_t _offset = 0;
+};
+
+} // namespace detail
+
+/** Decode a binary log file to text.
+ *
+ * Each message is decoded to a line similar to the text log. Thread names
+ * are not available, so the numeric thread id is used instead.
+ *
+ * @param bytes The contents of a binary log file.
+ * @return The log messages as text.
+ * @throw parse_error When the data is not a valid binary log.
+ */
+[[nodiscard]] inline std::string log_binary_decode(std::span<std::byte const> bytes)
+{
+    struct definition_type {
+        std::string level_name;
+        std::string source_filename;
+        uint32_t source_line;
+        std::string fmt;
+    };
+
+    auto const magic = detail::log_binary_magic;
+    hi_check(
+        bytes.size() >= magic.size() and std::memcmp(bytes.data(), magic.data(), magic.size()) == 0,
+        "Missing binary log magic");
+
+    auto reader = detail::log_binary_reader{bytes.subspan(magic.size())};
+    auto definitions = std::map<uint32_t, definition_type>{};
+    auto args = std::vector<detail::log_binary_value>{};
+    auto r = std::string{};
+
+    while (not reader.empty()) {
+        switch (static_cast<detail::log_binary_record>(reader.get<uint8_t>())) {
+        case detail::log_binary_record::definition:
+            {
+                auto const id = reader.get<uint32_t>();
+                auto& definition = definitions[id];
+                definition.level_name = reader.get_string();
+                definition.source_filename = reader.get_string();
+                definition.source_line = reader.get<uint32_t>();
+                definition.fmt = reader.get_string();
+            }
+            break;
+
+        case detail::log_binary_record::message:
+            {
+                auto const it = definitions.find(reader.get<uint32_t>());
+                hi_check(it != definitions.end(), "Binary log message without definition");
+                auto const& definition = it->second;
+
+                auto const time_point = std::chrono::utc_time<std::chrono::nanoseconds>{std::chrono::nanoseconds{reader.get<int64_t>()}};
+                auto const thread_id = reader.get<uint32_t>();
+                auto const cpu_id = reader.get<int32_t>();
+
+                args.clear();
+                auto const nr_args = reader.get<uint8_t>();
+                for (auto i = 0; i != nr_args; ++i) {
+                    args.push_back(reader.get_argument());
+                }
+
+                auto const what = detail::log_binary_format(definition.fmt, args);
+                if (definition.level_name == "stats") {
+                    std::format_to(std::back_inserter(r), "{} {}({}) {:5} {}\n", time_point, thread_id, cpu_id, definition.level_name, what);
+                } else {
+                    std::format_to(
+                        std::back_inserter(r),
+                        "{} {}({}) {:5} {} ({}:{})\n",
+                        time_point,
+                        thread_id,
+                        cpu_id,
+                        definition.level_name,
+                        what,
+                        definition.source_filename,
+                        definition.source_line);
+                }
+            }
+            break;
+
+        default:
+            throw parse_error("Unknown record type in binary log");
+        }
+    }
+    return r;
+}
+
+}} // namespace hi::v1
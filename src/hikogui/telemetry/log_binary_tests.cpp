@@ -0,0 +1,59 @@
+// Copyright Take Vos 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include "log_binary.hpp"
+#include <hikotest/hikotest.hpp>
+#include <string>
+#include <tuple>
+#include <span>
+#include <chrono>
+
+TEST_SUITE(log_binary) {
+
+[[nodiscard]] static std::string decode(std::string const& data)
+{
+    return hi::log_binary_decode(std::as_bytes(std::span{data}));
+}
+
+TEST_CASE(round_trip)
+{
+    auto data = std::string{hi::detail::log_binary_magic};
+    hi::detail::log_binary_append_definition(data, 0, "info", "foo.cpp", 42, "{} {:+} {:.2f} {} {}");
+    hi::detail::log_binary_append_message(
+        data,
+        0,
+        std::chrono::utc_time<std::chrono::nanoseconds>{},
+        5,
+        3,
+        std::tuple{std::string{"hello"}, 12, 1.5, true, 'x'});
+
+    auto const text = decode(data);
+    REQUIRE(text.ends_with(" 5(3) info  hello +12 1.50 true x (foo.cpp:42)\n"));
+}
+
+TEST_CASE(redefinition)
+{
+    auto data = std::string{hi::detail::log_binary_magic};
+    hi::detail::log_binary_append_definition(data, 0, "error", "a.cpp", 1, "a{1}{0}");
+    hi::detail::log_binary_append_message(data, 0, {}, 0, 0, std::tuple{1u, 2u});
+    hi::detail::log_binary_append_definition(data, 0, "stats", "b.cpp", 2, "b{{}}");
+    hi::detail::log_binary_append_message(data, 0, {}, 0, 0, std::tuple{});
+
+    auto const text = decode(data);
+    REQUIRE(text.find(" error a21 (a.cpp:1)\n") != std::string::npos);
+    REQUIRE(text.ends_with(" stats b{}\n"));
+}
+
+TEST_CASE(corrupt)
+{
+    REQUIRE_THROWS(decode("hilog"), hi::parse_error);
+
+    auto data = std::string{hi::detail::log_binary_magic};
+    hi::detail::log_binary_append_definition(data, 0, "info", "foo.cpp", 42, "{}");
+    hi::detail::log_binary_append_message(data, 0, {}, 0, 0, std::tuple{1});
+    data.pop_back();
+    REQUIRE_THROWS(decode(data), hi::parse_error);
+}
+
+};
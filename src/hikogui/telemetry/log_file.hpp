@@ -0,0 +1,199 @@
+// Copyright Take Vos 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include "log_binary.hpp"
+#include "../utility/utility.hpp"
+#include "../macros.hpp"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <chrono>
+#include <format>
+#include <system_error>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+hi_export_module(hikogui.telemetry : log_file);
+
+hi_export namespace hi { inline namespace v1 {
+namespace detail {
+
+/** The generation of the most recently opened log file.
+ *
+ * This is process-wide and only increases, so that a generation is never
+ * reused when a log file is closed and another one is opened.
+ */
+inline std::atomic<std::size_t> log_file_generation = 0;
+
+} // namespace detail
+
+struct log_file_options {
+    /** The name of the log file, without extension.
+     */
+    std::string name = "log";
+
+    /** Rotate the log file when it becomes larger than this size.
+     */
+    std::size_t max_size = 16 * 1024 * 1024;
+
+    /** Rotate the log file when it has been open longer than this.
+     */
+    std::chrono::seconds max_age = std::chrono::hours{24};
+
+    /** The number of rotated log files to keep.
+     */
+    std::size_t max_nr_backups = 4;
+
+    /** Write compact binary records instead of text.
+     *
+     * The binary log can be converted to text with `log_binary_decode()`.
+     */
+    bool binary = false;
+};
+
+/** A log file that rotates based on size and age.
+ *
+ * The current log file is `<name>.log`, or `<name>.hilog` in binary mode.
+ * When the log file is rotated it is renamed to `<name>.1.log`, and older
+ * backups are shifted up to `max_nr_backups`.
+ *
+ * This class uses the standard library directly since the file and path
+ * modules depend on telemetry.
+ */
+class log_file {
+public:
+    log_file(log_file const&) = delete;
+    log_file(log_file&&) = delete;
+    log_file& operator=(log_file const&) = delete;
+    log_file& operator=(log_file&&) = delete;
+
+    /** Open a log file.
+     *
+     * @param directory The directory where to put the log files.
+     * @param options The options for the log file.
+     * @throw io_error When the log file could not be opened.
+     */
+    log_file(std::filesystem::path directory, log_file_options options) :
+        _directory(std::move(directory)), _options(std::move(options))
+    {
+        auto ec = std::error_code{};
+        std::filesystem::create_directories(_directory, ec);
+        open();
+    }
+
+    /** Is this log file in binary mode.
+     */
+    [[nodiscard]] bool binary() const noexcept
+    {
+        return _options.binary;
+    }
+
+    /** The generation of the log file.
+     *
+     * Each opened file gets a new, process-wide unique, generation. Binary
+     * records use this to know when the definitions need to be written again.
+     */
+    [[nodiscard]] std::size_t generation() const noexcept
+    {
+        return _generation;
+    }
+
+    /** Write data to the log file.
+     *
+     * @param data The formatted text or binary records.
+     */
+    void write(std::string_view data) noexcept
+    {
+        if (not _stream.is_open()) {
+            return;
+        }
+
+        _stream.write(data.data(), narrow_cast<std::streamsize>(data.size()));
+        _stream.flush();
+        _size += data.size();
+    }
+
+    /** Rotate the log file when it is too large or too old.
+     *
+     * @return true if the log file was rotated.
+     */
+    bool rotate_if_needed() noexcept
+    {
+        if (_size < _options.max_size and std::chrono::steady_clock::now() - _open_time < _options.max_age) {
+            return false;
+        }
+
+        try {
+            _stream.close();
+            rotate();
+            open();
+            return true;
+        } catch (...) {
+            // The stream stays closed; messages are still written to the console.
+            return false;
+        }
+    }
+
+private:
+    std::filesystem::path _directory;
+    log_file_options _options;
+    std::ofstream _stream;
+    std::size_t _size = 0;
+    std::size_t _generation = 0;
+    std::chrono::steady_clock::time_point _open_time;
+
+    [[nodiscard]] std::string_view extension() const noexcept
+    {
+        return _options.binary ? ".hilog" : ".log";
+    }
+
+    [[nodiscard]] std::filesystem::path path(std::size_t index) const
+    {
+        if (index == 0) {
+            return _directory / std::format("{}{}", _options.name, extension());
+        } else {
+            return _directory / std::format("{}.{}{}", _options.name, index, extension());
+        }
+    }
+
+    void open()
+    {
+        auto const p = path(0);
+
+        _stream.open(p, std::ios::binary | std::ios::app);
+        if (not _stream.is_open()) {
+            throw io_error(std::format("Could not open log file {}", p.string()));
+        }
+
+        auto ec = std::error_code{};
+        auto const size = std::filesystem::file_size(p, ec);
+        _size = ec ? 0 : narrow_cast<std::size_t>(size);
+        _open_time = std::chrono::steady_clock::now();
+        _generation = ++detail::log_file_generation;
+
+        if (_options.binary and _size == 0) {
+            write(detail::log_binary_magic);
+        }
+    }
+
+    void rotate() const
+    {
+        auto ec = std::error_code{};
+        if (_options.max_nr_backups == 0) {
+            std::filesystem::remove(path(0), ec);
+            return;
+        }
+
+        std::filesystem::remove(path(_options.max_nr_backups), ec);
+        for (auto i = _options.max_nr_backups; i != 0; --i) {
+            std::filesystem::rename(path(i - 1), path(i), ec);
+        }
+    }
+};
+
+}} // namespace hi::v1
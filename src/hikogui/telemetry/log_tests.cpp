@@ -0,0 +1,48 @@
+// Copyright Take Vos 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include "log.hpp"
+#include <hikotest/hikotest.hpp>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <format>
+
+TEST_SUITE(log_suite) {
+
+static void log_value(hi::log& log, int value)
+{
+    log.add<hi::global_state_type::log_error, __FILE__, __LINE__, "reopen {}">(value);
+    log.flush();
+}
+
+[[nodiscard]] static std::string decode_file(std::filesystem::path const& path)
+{
+    auto stream = std::ifstream(path, std::ios::binary);
+    auto const data = std::string{std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{}};
+    return hi::log_binary_decode(std::as_bytes(std::span{data}));
+}
+
+TEST_CASE(binary_reopen_test)
+{
+    auto const directory = std::filesystem::temp_directory_path() / "hikogui_log_test";
+    std::filesystem::remove_all(directory);
+
+    auto log = hi::log{};
+    for (auto i = 0; i != 2; ++i) {
+        // Each new file needs the definition of the log statement again.
+        log.open_file(directory, {.name = "test", .binary = true});
+        log_value(log, i);
+        log.close_file();
+
+        auto const text = decode_file(directory / "test.hilog");
+        REQUIRE(text.find(std::format("reopen {}", i)) != std::string::npos);
+        std::filesystem::remove(directory / "test.hilog");
+    }
+
+    std::filesystem::remove_all(directory);
+}
+
+}; // TEST_SUITE(log_suite)
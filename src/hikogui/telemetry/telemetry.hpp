@@ -5,6 +5,8 @@
 #include "delayed_format.hpp" // export
 #include "format_check.hpp" // export
 #include "log.hpp" // export
+#include "log_binary.hpp" // export
+#include "log_file.hpp" // export
 #include "trace.hpp" // export
 
 hi_export_module(hikogui.telemetry);
@@ -6,15 +6,197 @@
 
 #include "../utility/utility.hpp"
 #include "../time/time.hpp"
+#include "../concurrency/concurrency.hpp"
 #include "counters.hpp"
 #include "../macros.hpp"
 #include <array>
 #include <tuple>
 #include <exception>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <format>
+#include <iterator>
+#include <algorithm>
+#include <cstdint>
 
 hi_export_module(hikogui.telemetry : trace);
 
 hi_export namespace hi::inline v1 {
+namespace detail {
+
+/** A completed trace span.
+ */
+struct trace_event {
+    std::string_view tag;
+    uint64_t begin;
+    uint64_t end;
+    uint32_t id;
+    uint32_t parent_id;
+};
+
+/** A ring buffer of trace events of a single thread.
+ *
+ * Only the owning thread writes events; when the ring is full the oldest
+ * events are overwritten. Each slot is guarded by a sequence number, like
+ * a seqlock, so that readers can drop events that were being overwritten
+ * while they were copied.
+ */
+class trace_ring {
+public:
+    constexpr static std::size_t capacity = 4096;
+
+    trace_ring(hi::thread_id id) noexcept : _thread_id(id) {}
+
+    [[nodiscard]] hi::thread_id thread_id() const noexcept
+    {
+        return _thread_id;
+    }
+
+    void push(trace_event const& event) noexcept
+    {
+        auto const head = _head.load(std::memory_order::relaxed);
+        auto& slot = _slots[head % capacity];
+
+        // An odd sequence number marks the slot as being written.
+        slot.sequence.store(head * 2 + 1, std::memory_order::relaxed);
+        std::atomic_thread_fence(std::memory_order::release);
+
+        slot.tag_data.store(event.tag.data(), std::memory_order::relaxed);
+        slot.tag_size.store(event.tag.size(), std::memory_order::relaxed);
+        slot.begin.store(event.begin, std::memory_order::relaxed);
+        slot.end.store(event.end, std::memory_order::relaxed);
+        slot.id.store(event.id, std::memory_order::relaxed);
+        slot.parent_id.store(event.parent_id, std::memory_order::relaxed);
+
+        slot.sequence.store(head * 2 + 2, std::memory_order::release);
+        _head.store(head + 1, std::memory_order::release);
+    }
+
+    /** Copy the events that are currently in the ring.
+     *
+     * @param[out] out The vector to append the events to, oldest first.
+     */
+    void read(std::vector<trace_event>& out) const noexcept
+    {
+        auto const head = _head.load(std::memory_order::acquire);
+
+        // The slot of the oldest event is the next slot the owning thread will write.
+        auto const first = head >= capacity ? head + 1 - capacity : 0;
+
+        for (auto i = first; i != head; ++i) {
+            auto const& slot = _slots[i % capacity];
+
+            auto const sequence = slot.sequence.load(std::memory_order::acquire);
+            if (sequence != i * 2 + 2) {
+                // The event is being written, or has already been overwritten.
+                continue;
+            }
+
+            auto const event = trace_event{
+                std::string_view{slot.tag_data.load(std::memory_order::relaxed), slot.tag_size.load(std::memory_order::relaxed)},
+                slot.begin.load(std::memory_order::relaxed),
+                slot.end.load(std::memory_order::relaxed),
+                slot.id.load(std::memory_order::relaxed),
+                slot.parent_id.load(std::memory_order::relaxed)};
+
+            std::atomic_thread_fence(std::memory_order::acquire);
+            if (slot.sequence.load(std::memory_order::relaxed) == sequence) {
+                out.push_back(event);
+            }
+        }
+    }
+
+    /** Allocate a span id, unique within this thread.
+     */
+    [[nodiscard]] uint32_t make_id() noexcept
+    {
+        return ++_next_id;
+    }
+
+private:
+    /** A trace_event stored as atomics, so that it can be read while being written.
+     */
+    struct slot_type {
+        /** The sequence number, `index * 2 + 2` when the event at index was written completely.
+         */
+        std::atomic<uint64_t> sequence = 0;
+        std::atomic<char const *> tag_data = nullptr;
+        std::atomic<std::size_t> tag_size = 0;
+        std::atomic<uint64_t> begin = 0;
+        std::atomic<uint64_t> end = 0;
+        std::atomic<uint32_t> id = 0;
+        std::atomic<uint32_t> parent_id = 0;
+    };
+
+    std::array<slot_type, capacity> _slots = {};
+    std::atomic<uint64_t> _head = 0;
+    uint32_t _next_id = 0;
+    hi::thread_id _thread_id;
+};
+
+inline unfair_mutex trace_rings_mutex;
+
+/** The rings of every running thread that has traced.
+ */
+inline std::vector<std::shared_ptr<trace_ring>> trace_rings;
+
+/** Registers the ring of the current thread, and releases it when the thread ends.
+ *
+ * A reader that is dumping the ring keeps it alive through its own shared_ptr.
+ */
+class trace_ring_owner {
+public:
+    trace_ring_owner() : _ring(std::make_shared<trace_ring>(current_thread_id()))
+    {
+        auto const lock = std::scoped_lock(trace_rings_mutex);
+        trace_rings.push_back(_ring);
+    }
+
+    ~trace_ring_owner()
+    {
+        auto const lock = std::scoped_lock(trace_rings_mutex);
+        std::erase(trace_rings, _ring);
+    }
+
+    trace_ring_owner(trace_ring_owner const&) = delete;
+    trace_ring_owner(trace_ring_owner&&) = delete;
+    trace_ring_owner& operator=(trace_ring_owner const&) = delete;
+    trace_ring_owner& operator=(trace_ring_owner&&) = delete;
+
+    [[nodiscard]] trace_ring& ring() const noexcept
+    {
+        return *_ring;
+    }
+
+private:
+    std::shared_ptr<trace_ring> _ring;
+};
+
+[[nodiscard]] inline trace_ring& current_trace_ring() noexcept
+{
+    thread_local auto owner = trace_ring_owner{};
+    return owner.ring();
+}
+
+inline void trace_json_escape(std::string& out, std::string_view str) noexcept
+{
+    for (auto const c : str) {
+        if (c == '"' or c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            std::format_to(std::back_inserter(out), "\\u{:04x}", static_cast<int>(c));
+        } else {
+            out += c;
+        }
+    }
+}
+
+} // namespace detail
 
 class trace_base {
 public:
@@ -23,7 +205,12 @@ public:
     trace_base &operator=(trace_base const &) = delete;
     trace_base &operator=(trace_base &&) = delete;
 
-    trace_base() noexcept : _time_stamp(time_stamp_count::inplace{}), _next(std::exchange(_top, this)) {}
+    trace_base() noexcept :
+        _time_stamp(time_stamp_count::inplace{}),
+        _next(std::exchange(_top, this)),
+        _id(detail::current_trace_ring().make_id())
+    {
+    }
 
     virtual ~trace_base()
     {
@@ -37,6 +224,21 @@ protected:
 
     time_stamp_count _time_stamp;
     trace_base *_next = nullptr;
+
+    /** The id of this span, unique within the thread.
+     */
+    uint32_t _id = 0;
+
+    /** Record this span in the ring buffer of the current thread.
+     *
+     * @param tag The name of the span.
+     * @param end The count at the end of the span.
+     */
+    void record(std::string_view tag, uint64_t end) const noexcept
+    {
+        auto const parent_id = _next ? _next->_id : 0;
+        detail::current_trace_ring().push({tag, _time_stamp.count(), end, _id, parent_id});
+    }
 };
 
 template<fixed_string Tag>
@@ -52,6 +254,7 @@ public:
 
         auto const current_time_stamp = time_stamp_count{time_stamp_count::inplace{}};
         global_counter<Tag>.add_duration(current_time_stamp.count() - _time_stamp.count());
+        record(static_cast<std::string_view>(Tag), current_time_stamp.count());
     }
 
     void log() const noexcept override
@@ -62,5 +265,59 @@ public:
     }
 };
 
+/** Dump the recorded trace spans of all threads as Chrome trace-event JSON.
+ *
+ * The result can be loaded in `chrome://tracing` or Perfetto. Each span is
+ * a complete ("X") event; the span id and the id of its parent span are
+ * added as arguments. Only the most recent spans of each running thread are kept.
+ *
+ * @return A JSON object with a "traceEvents" array.
+ */
+[[nodiscard]] inline std::string trace_dump_chrome_json() noexcept
+{
+    auto rings = [] {
+        auto const lock = std::scoped_lock(detail::trace_rings_mutex);
+        return detail::trace_rings;
+    }();
+
+    auto r = std::string{"{\"traceEvents\":["};
+    auto it = std::back_inserter(r);
+    auto events = std::vector<detail::trace_event>{};
+    auto first = true;
+
+    auto const to_us = [](uint64_t count) {
+        return static_cast<double>(time_stamp_count::duration_from_count(count).count()) / 1000.0;
+    };
+
+    for (auto const& ring : rings) {
+        auto const tid = ring->thread_id();
+
+        if (not first) {
+            r += ',';
+        }
+        first = false;
+        std::format_to(it, "\n{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":\"", tid);
+        detail::trace_json_escape(r, get_thread_name(tid));
+        r += "\"}}";
+
+        events.clear();
+        ring->read(events);
+        for (auto const& event : events) {
+            r += ",\n{\"name\":\"";
+            detail::trace_json_escape(r, event.tag);
+            std::format_to(
+                it,
+                "\",\"cat\":\"hi\",\"ph\":\"X\",\"ts\":{:.3f},\"dur\":{:.3f},\"pid\":1,\"tid\":{},\"args\":{{\"id\":{},\"parent\":{}}}}}",
+                to_us(event.begin),
+                to_us(event.end - event.begin),
+                tid,
+                event.id,
+                event.parent_id);
+        }
+    }
+
+    r += "\n]}\n";
+    return r;
+}
 
 } // namespace hi::inline v1
@@ -0,0 +1,104 @@
+// Copyright Take Vos 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include "trace.hpp"
+#include <hikotest/hikotest.hpp>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <tuple>
+
+TEST_SUITE(trace) {
+
+TEST_CASE(nested_spans)
+{
+    auto events = std::vector<hi::detail::trace_event>{};
+    auto const& ring = hi::detail::current_trace_ring();
+    ring.read(events);
+    auto const offset = events.size();
+
+    {
+        auto const outer = hi::trace<"trace_test:outer">{};
+        {
+            auto const inner = hi::trace<"trace_test:inner">{};
+        }
+    }
+
+    events.clear();
+    ring.read(events);
+    REQUIRE(events.size() == offset + 2);
+
+    auto const& inner = events[offset];
+    auto const& outer = events[offset + 1];
+    REQUIRE(inner.tag == "trace_test:inner");
+    REQUIRE(outer.tag == "trace_test:outer");
+    REQUIRE(inner.parent_id == outer.id);
+    REQUIRE(outer.begin <= inner.begin);
+    REQUIRE(inner.end <= outer.end);
+}
+
+TEST_CASE(chrome_json)
+{
+    {
+        auto const t = hi::trace<"trace_test:json">{};
+    }
+
+    auto const json = hi::trace_dump_chrome_json();
+    REQUIRE(json.starts_with("{\"traceEvents\":["));
+    REQUIRE(json.find("\"name\":\"trace_test:json\",\"cat\":\"hi\",\"ph\":\"X\"") != std::string::npos);
+    REQUIRE(json.find("\"ph\":\"M\"") != std::string::npos);
+}
+
+TEST_CASE(concurrent_read)
+{
+    auto ring_ptr = std::make_unique<hi::detail::trace_ring>(hi::thread_id{});
+    auto& ring = *ring_ptr;
+    auto stop = std::atomic<bool>{false};
+
+    // The writer laps the ring many times while it is being read.
+    auto writer = std::thread([&] {
+        for (uint64_t i = 1; not stop.load(std::memory_order::relaxed); ++i) {
+            ring.push({"concurrent", i, i, static_cast<uint32_t>(i), static_cast<uint32_t>(i)});
+        }
+    });
+
+    auto events = std::vector<hi::detail::trace_event>{};
+    for (auto i = 0; i != 1000; ++i) {
+        events.clear();
+        ring.read(events);
+        for (auto const& event : events) {
+            // A torn event would have fields from different pushes.
+            REQUIRE(event.tag == "concurrent");
+            REQUIRE(event.begin == event.end);
+            REQUIRE(event.id == static_cast<uint32_t>(event.begin));
+            REQUIRE(event.parent_id == event.id);
+        }
+    }
+
+    stop.store(true, std::memory_order::relaxed);
+    writer.join();
+}
+
+TEST_CASE(release_ring_of_exited_thread)
+{
+    // Make sure this thread's ring is registered.
+    std::ignore = hi::detail::current_trace_ring();
+
+    auto const nr_rings = [] {
+        auto const lock = std::scoped_lock(hi::detail::trace_rings_mutex);
+        return hi::detail::trace_rings.size();
+    };
+
+    auto const before = nr_rings();
+    auto thread = std::thread([] {
+        auto const t = hi::trace<"trace_test:thread">{};
+    });
+    thread.join();
+    REQUIRE(nr_rings() == before);
+}
+
+};
@@ -5,6 +5,7 @@
 #include "text_decoration.hpp" // export
 #include "text_selection.hpp" // export
 #include "text_shaper.hpp" // export
+#include "text_shaper_cache.hpp" // export
 #include "text_shaper_char.hpp" // export
 #include "text_shaper_line.hpp" // export
 #include "text_style_set.hpp" // export
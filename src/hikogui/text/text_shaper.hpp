@@ -17,6 +17,8 @@
 #include <vector>
 #include <tuple>
 #include <coroutine>
+#include <ranges>
+#include <concepts>
 
 hi_export_module(hikogui.text.text_shaper);
 
@@ -72,7 +74,8 @@ public:
      *  - middle, odd: y = 0 is the base-line of the middle line.
      *  - middle, even: y = 0 is half way between the base-lines of the middle two lines.
      *
-     * @param text The text as a vector of attributed graphemes.
+     * @param text The text as a random-access range of attributed graphemes, like
+     *             a `gstring` or a `rope<grapheme>`.
      *             Use U+2029 as paragraph separator, and if needed U+2028 as line separator.
      * @param style The initial text-style to use to display the text.
      * @param pixel_density The pixel density of the current display.
@@ -80,8 +83,10 @@ public:
      * @param text_direction The default text direction when it can not be deduced from the text.
      * @param script The script of the text.
      */
+    template<std::ranges::random_access_range Text>
+        requires std::same_as<std::ranges::range_value_t<Text>, grapheme>
     [[nodiscard]] text_shaper(
-        gstring const& text,
+        Text const& text,
         text_style_set const& style,
         unit::pixel_density pixel_density,
         hi::alignment alignment,
@@ -89,13 +94,14 @@ public:
         iso_15924 script = iso_15924{"Zyyy"}) noexcept :
         _bidi_context(left_to_right ? unicode_bidi_class::L : unicode_bidi_class::R),
         _pixel_density(pixel_density),
+        _style(style),
         _alignment(alignment),
         _script(script)
     {
         auto const font = style.front().font_chain()[0];
         _initial_line_metrics = style.front().size() * _pixel_density * font->metrics;
 
-        _text.reserve(text.size());
+        _text.reserve(std::ranges::size(text));
         for (auto const& c : text) {
             auto const clean_c = c == '\n' ? grapheme{unicode_PS} : c;
 
@@ -103,19 +109,13 @@ public:
             tmp.initialize_glyph(font);
         }
 
-        _text_direction = unicode_bidi_direction(
-            _text.begin(),
-            _text.end(),
-            [](text_shaper::char_const_reference it) {
-                return it.grapheme.starter();
-            },
-            _bidi_context);
+        resolve_text_direction();
 
         _line_break_opportunities = unicode_line_break(_text.begin(), _text.end(), [](auto const& c) -> decltype(auto) {
             return c.grapheme.starter();
         });
 
-        _line_break_widths.reserve(text.size());
+        _line_break_widths.reserve(_text.size());
         for (auto const& c : _text) {
             _line_break_widths.push_back(is_visible(c.general_category) ? c.width : -c.width);
         }
@@ -142,6 +142,142 @@ public:
     {
     }
 
+    /** Update the text, only reshaping the paragraphs that changed.
+     *
+     * Characters, their glyphs and break opportunities of paragraphs that
+     * are unchanged are reused. Only the paragraphs that overlap with the
+     * changed graphemes are reshaped and re-analyzed, which makes the cost
+     * of an edit proportional to the size of the edited paragraph.
+     *
+     * When the style or pixel density changed the text is fully reshaped.
+     *
+     * @note The text needs to be laid out again after the update.
+     * @param text The new text, a random-access range of graphemes.
+     * @param style The text-style to use to display the text.
+     * @param pixel_density The pixel density of the current display.
+     * @param alignment The alignment how to align the text.
+     * @param left_to_right The default text direction when it can not be deduced from the text.
+     * @param script The script of the text.
+     */
+    template<std::ranges::random_access_range Text>
+        requires std::same_as<std::ranges::range_value_t<Text>, grapheme>
+    void update(
+        Text const& text,
+        text_style_set const& style,
+        unit::pixel_density pixel_density,
+        hi::alignment alignment,
+        bool left_to_right,
+        iso_15924 script = iso_15924{"Zyyy"}) noexcept
+    {
+        if (_text.empty() or style != _style or pixel_density.ppi != _pixel_density.ppi or
+            pixel_density.type != _pixel_density.type) {
+            *this = text_shaper{text, style, pixel_density, alignment, left_to_right, script};
+            return;
+        }
+
+        _bidi_context = unicode_bidi_context{left_to_right ? unicode_bidi_class::L : unicode_bidi_class::R};
+        _alignment = alignment;
+        _script = script;
+        _lines.clear();
+
+        auto const clean = [](grapheme c) {
+            return c == '\n' ? grapheme{unicode_PS} : c;
+        };
+
+        auto const old_size = _text.size();
+        auto const new_size = narrow_cast<size_t>(std::ranges::size(text));
+
+        // Access the text through a single iterator, so that a rope only
+        // searches for a leaf when moving to another part of the text.
+        auto const text_it = std::ranges::begin(text);
+
+        // Find the graphemes that are unchanged at the start and end of the text.
+        auto prefix = 0_uz;
+        while (prefix != old_size and prefix != new_size and
+               _text[prefix].grapheme.intrinsic() == clean(text_it[prefix]).intrinsic()) {
+            ++prefix;
+        }
+
+        auto suffix = 0_uz;
+        while (suffix != old_size - prefix and suffix != new_size - prefix and
+               _text[old_size - suffix - 1].grapheme.intrinsic() == clean(text_it[new_size - suffix - 1]).intrinsic()) {
+            ++suffix;
+        }
+
+        if (prefix == old_size and prefix == new_size) {
+            resolve_text_direction();
+            return;
+        }
+
+        // Extend the changed range to whole paragraphs, in both the old and new text.
+        auto first = prefix;
+        while (first != 0 and _text[first - 1].general_category != unicode_general_category::Zp) {
+            --first;
+        }
+
+        while (suffix != 0) {
+            auto const old_last = old_size - suffix;
+            auto const new_last = new_size - suffix;
+            if ((old_last == 0 or _text[old_last - 1].general_category == unicode_general_category::Zp) and
+                (new_last == 0 or clean(text_it[new_last - 1]) == unicode_PS)) {
+                break;
+            }
+            --suffix;
+        }
+
+        auto const old_last = old_size - suffix;
+        auto const new_last = new_size - suffix;
+
+        // Reshape the changed paragraphs.
+        auto const font = style.front().font_chain()[0];
+        auto chars = char_vector{};
+        chars.reserve(new_last - first);
+        for (auto i = first; i != new_last; ++i) {
+            auto& tmp = chars.emplace_back(clean(text_it[i]), style, _pixel_density);
+            tmp.initialize_glyph(font);
+        }
+
+        // Reused characters may have a mirrored or morphed glyph from a previous layout.
+        for (auto i = 0_uz; i != first; ++i) {
+            _text[i].initialize_glyph(font);
+        }
+        for (auto i = old_last; i != old_size; ++i) {
+            _text[i].initialize_glyph(font);
+        }
+
+        splice(_text, first, old_last, std::make_move_iterator(chars.begin()), std::make_move_iterator(chars.end()));
+
+        auto const starter = [](auto const& c) -> decltype(auto) {
+            return c.grapheme.starter();
+        };
+
+        // Break opportunities of each paragraph only depend on the characters in that paragraph.
+        // The opportunity at the start of the paragraph is kept.
+        auto const text_first = _text.begin() + first;
+        auto const text_last = _text.begin() + new_last;
+        auto const splice_breaks = [&](unicode_break_vector& opportunities, unicode_break_vector const& part) {
+            hi_axiom(part.size() == new_last - first + 1);
+            splice(opportunities, first + 1, old_last + 1, part.begin() + 1, part.end());
+        };
+        splice_breaks(_line_break_opportunities, unicode_line_break(text_first, text_last, starter));
+        splice_breaks(_word_break_opportunities, unicode_word_break(text_first, text_last, starter));
+        splice_breaks(_sentence_break_opportunities, unicode_sentence_break(text_first, text_last, starter));
+
+        auto widths = std::vector<float>{};
+        widths.reserve(new_last - first);
+        for (auto it = text_first; it != text_last; ++it) {
+            widths.push_back(is_visible(it->general_category) ? it->width : -it->width);
+        }
+        splice(_line_break_widths, first, old_last, widths.begin(), widths.end());
+
+        hi_axiom(_text.size() == new_size);
+        hi_axiom(_line_break_opportunities.size() == new_size + 1);
+        hi_axiom(_line_break_widths.size() == new_size);
+
+        resolve_text_direction();
+        resolve_script();
+    }
+
     [[nodiscard]] bool empty() const noexcept
     {
         return _text.empty();
@@ -247,6 +383,13 @@ public:
         position_glyphs(rectangle, sub_pixel_size);
     }
 
+    /** Set the alignment used when laying out the text.
+     */
+    void set_alignment(hi::alignment alignment) noexcept
+    {
+        _alignment = alignment;
+    }
+
     /** The rectangle used when laying out the text.
      */
     [[nodiscard]] aarectangle rectangle() const noexcept
@@ -829,6 +972,10 @@ private:
      */
     unit::pixel_density _pixel_density;
 
+    /** The text-style used to shape the text.
+     */
+    text_style_set _style;
+
     /** A list of character in logical order.
      *
      * @note Graphemes are not allowed to be typographical-ligatures.
@@ -1181,6 +1328,37 @@ private:
         }
     }
 
+    /** Replace the elements [first, last) of a vector with the elements of [new_first, new_last).
+     */
+    template<typename T, typename It>
+    static void splice(std::vector<T>& v, std::size_t first, std::size_t last, It new_first, It new_last) noexcept
+    {
+        auto const old_size = last - first;
+        auto const new_size = narrow_cast<std::size_t>(std::distance(new_first, new_last));
+        auto const common_size = std::min(old_size, new_size);
+
+        // Overwrite in place, then only shift the tail of the vector once.
+        std::copy(new_first, new_first + common_size, v.begin() + first);
+        if (old_size > new_size) {
+            v.erase(v.begin() + first + common_size, v.begin() + last);
+        } else if (new_size > old_size) {
+            v.insert(v.begin() + last, new_first + common_size, new_last);
+        }
+    }
+
+    /** Determine the text-direction from the first paragraph.
+     */
+    void resolve_text_direction() noexcept
+    {
+        _text_direction = unicode_bidi_direction(
+            _text.begin(),
+            _text.end(),
+            [](text_shaper::char_const_reference it) {
+                return it.grapheme.starter();
+            },
+            _bidi_context);
+    }
+
     /** Resolve the script of each character in text.
      */
     void resolve_script() noexcept
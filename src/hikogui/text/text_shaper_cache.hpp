@@ -0,0 +1,225 @@
+// Copyright Take Vos 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#pragma once
+
+#include "text_shaper.hpp"
+#include "text_style_set.hpp"
+#include "../font/font.hpp"
+#include "../unicode/unicode.hpp"
+#include "../units/units.hpp"
+#include "../telemetry/telemetry.hpp"
+#include "../concurrency/concurrency.hpp"
+#include "../utility/utility.hpp"
+#include "../macros.hpp"
+#include <list>
+#include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <algorithm>
+
+hi_export_module(hikogui.text.text_shaper_cache);
+
+hi_export namespace hi::inline v1 {
+
+/** A process-wide least-recently-used cache of shaped text.
+ *
+ * Static text such as labels, menu items and tab titles is reshaped
+ * whenever a widget is rebuilt or the window is resized. This cache holds
+ * the shaped characters, their glyphs and break opportunities keyed by
+ * the text, style and pixel density, so that identical text is shaped
+ * only once.
+ *
+ * The cache is cleared when fonts are registered, see `font_book::generation()`.
+ * Text shaped for a previous theme has a different style and is evicted when
+ * the cache reaches its capacity.
+ *
+ * Hits, misses, bypasses and clears are counted in the global counters
+ * "text_shaper_cache:hit", "text_shaper_cache:miss",
+ * "text_shaper_cache:bypass" and "text_shaper_cache:clear".
+ */
+class text_shaper_cache {
+public:
+    /** The maximum number of shaped texts in the cache.
+     */
+    constexpr static std::size_t capacity = 1024;
+
+    /** Text longer than this is not cached.
+     *
+     * Long text is usually edited, in which case `text_shaper::update()` is
+     * more efficient.
+     */
+    constexpr static std::size_t max_text_size = 1024;
+
+    static text_shaper_cache& global() noexcept;
+
+    text_shaper_cache(text_shaper_cache const&) = delete;
+    text_shaper_cache(text_shaper_cache&&) = delete;
+    text_shaper_cache& operator=(text_shaper_cache const&) = delete;
+    text_shaper_cache& operator=(text_shaper_cache&&) = delete;
+    text_shaper_cache() = default;
+
+    /** Get shaped text.
+     *
+     * The arguments are the same as for the text_shaper constructor.
+     *
+     * @return A text_shaper which is ready to be laid out.
+     */
+    [[nodiscard]] text_shaper get(
+        gstring const& text,
+        text_style_set const& style,
+        unit::pixel_density pixel_density,
+        hi::alignment alignment,
+        bool left_to_right,
+        iso_15924 script = iso_15924{"Zyyy"}) noexcept
+    {
+        if (text.size() > max_text_size) {
+            ++global_counter<"text_shaper_cache:bypass">;
+            return text_shaper{text, style, pixel_density, alignment, left_to_right, script};
+        }
+
+        auto const hash = make_hash(text, pixel_density, left_to_right, script);
+        auto const font_book_generation = font_book::global().generation();
+
+        {
+            auto const lock = std::scoped_lock(_mutex);
+            clear_if_stale(font_book_generation);
+            if (auto const it = _map.find(hash); it != _map.end()) {
+                auto const entry_it = it->second;
+                if (entry_it->matches(text, style, pixel_density, left_to_right, script)) {
+                    ++global_counter<"text_shaper_cache:hit">;
+
+                    // Move the entry to the front of the list.
+                    _entries.splice(_entries.begin(), _entries, entry_it);
+
+                    auto r = entry_it->shaped_text;
+                    r.set_alignment(alignment);
+                    return r;
+                }
+            }
+        }
+
+        ++global_counter<"text_shaper_cache:miss">;
+        auto r = text_shaper{text, style, pixel_density, alignment, left_to_right, script};
+
+        auto const lock = std::scoped_lock(_mutex);
+        clear_if_stale(font_book_generation);
+        if (font_book_generation != _font_book_generation) {
+            // Fonts were registered while shaping, don't cache text shaped with the old fonts.
+            return r;
+        }
+
+        if (auto const it = _map.find(hash); it != _map.end()) {
+            // Replace an entry with the same hash, from a collision or another thread.
+            _entries.erase(it->second);
+            _map.erase(it);
+        }
+
+        _entries.emplace_front(hash, text, style, pixel_density, left_to_right, script, r);
+        _map[hash] = _entries.begin();
+
+        while (_entries.size() > capacity) {
+            _map.erase(_entries.back().hash);
+            _entries.pop_back();
+        }
+        return r;
+    }
+
+    /** Remove all shaped text from the cache.
+     */
+    void clear() noexcept
+    {
+        auto const lock = std::scoped_lock(_mutex);
+        _map.clear();
+        _entries.clear();
+    }
+
+    /** The number of shaped texts in the cache.
+     */
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        auto const lock = std::scoped_lock(_mutex);
+        return _entries.size();
+    }
+
+private:
+    struct entry_type {
+        std::size_t hash;
+        gstring text;
+        text_style_set style;
+        unit::pixel_density pixel_density;
+        bool left_to_right;
+        iso_15924 script;
+        text_shaper shaped_text;
+
+        [[nodiscard]] bool matches(
+            gstring const& other_text,
+            text_style_set const& other_style,
+            unit::pixel_density other_pixel_density,
+            bool other_left_to_right,
+            iso_15924 other_script) const noexcept
+        {
+            // Graphemes are compared including their attributes, which select the style.
+            return std::ranges::equal(
+                       text,
+                       other_text,
+                       [](grapheme const& lhs, grapheme const& rhs) {
+                           return lhs.intrinsic() == rhs.intrinsic();
+                       }) and
+                pixel_density.ppi == other_pixel_density.ppi and pixel_density.type == other_pixel_density.type and
+                left_to_right == other_left_to_right and script == other_script and style == other_style;
+        }
+    };
+
+    mutable unfair_mutex _mutex;
+
+    /** The entries, most recently used first.
+     */
+    std::list<entry_type> _entries;
+    std::unordered_map<std::size_t, std::list<entry_type>::iterator> _map;
+
+    /** The generation of the font book that the entries were shaped with.
+     */
+    std::size_t _font_book_generation = 0;
+
+    /** Clear the cache when fonts were registered since the entries were shaped.
+     */
+    void clear_if_stale(std::size_t font_book_generation) noexcept
+    {
+        hi_axiom(_mutex.is_locked());
+
+        if (font_book_generation > _font_book_generation) {
+            if (not _entries.empty()) {
+                ++global_counter<"text_shaper_cache:clear">;
+            }
+            _map.clear();
+            _entries.clear();
+            _font_book_generation = font_book_generation;
+        }
+    }
+
+    [[nodiscard]] static std::size_t
+    make_hash(gstring const& text, unit::pixel_density pixel_density, bool left_to_right, iso_15924 script) noexcept
+    {
+        // The style is not hashed; it is compared when an entry is found.
+        auto r = std::hash<gstring>{}(text);
+        r = hash_mix_two(r, std::hash<float>{}(pixel_density.ppi.in(unit::pixels_per_inch)));
+        r = hash_mix_two(r, std::hash<iso_15924>{}(script));
+        return hash_mix_two(r, std::hash<bool>{}(left_to_right));
+    }
+};
+
+namespace detail {
+inline std::unique_ptr<text_shaper_cache> text_shaper_cache_global;
+}
+
+inline text_shaper_cache& text_shaper_cache::global() noexcept
+{
+    if (not detail::text_shaper_cache_global) {
+        detail::text_shaper_cache_global = std::make_unique<text_shaper_cache>();
+    }
+    return *detail::text_shaper_cache_global;
+}
+
+} // namespace hi::inline v1
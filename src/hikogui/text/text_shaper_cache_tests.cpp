@@ -0,0 +1,70 @@
+// Copyright Take Vos 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include "text_shaper_cache.hpp"
+#include "../font/font.hpp"
+#include "../path/path.hpp"
+#include <hikotest/hikotest.hpp>
+#include <cstdint>
+
+TEST_SUITE(text_shaper_cache_suite) {
+
+static hi::text_style_set test_style()
+{
+    static auto const font = hi::register_font_file(hi::library_source_dir() / "resources" / "hikogui_icons.ttf");
+
+    auto style = hi::text_style{};
+    style.set_font_chain({font});
+    style.set_color(hi::color{1.0f, 1.0f, 1.0f});
+    style.set_size(hi::unit::points_per_em(short{12}));
+    style.set_line_spacing(1.0f);
+    style.set_paragraph_spacing(1.5f);
+
+    auto r = hi::text_style_set{};
+    r.push_back(hi::grapheme_attribute_mask{}, style);
+    return r;
+}
+
+static hi::text_shaper get(hi::text_shaper_cache& cache, std::string_view text)
+{
+    auto const pixel_density = hi::unit::pixel_density{hi::unit::pixels_per_inch(96.0f), hi::device_type::desktop};
+    return cache.get(hi::to_gstring(text), test_style(), pixel_density, hi::alignment{}, true);
+}
+
+TEST_CASE(hit_test)
+{
+    auto cache = hi::text_shaper_cache{};
+    std::ignore = get(cache, "hello");
+
+    auto const hits = static_cast<uint64_t>(hi::global_counter<"text_shaper_cache:hit">);
+    std::ignore = get(cache, "hello");
+    REQUIRE(hi::global_counter<"text_shaper_cache:hit"> == hits + 1);
+    REQUIRE(cache.size() == 1);
+
+    std::ignore = get(cache, "world");
+    REQUIRE(cache.size() == 2);
+
+    cache.clear();
+    REQUIRE(cache.size() == 0);
+}
+
+TEST_CASE(font_change_test)
+{
+    auto cache = hi::text_shaper_cache{};
+    std::ignore = get(cache, "hello");
+    std::ignore = get(cache, "world");
+    REQUIRE(cache.size() == 2);
+
+    // Recalculating the fallback chains may change the glyphs, so the cache is cleared on the next use.
+    hi::font_book::global().post_process();
+
+    auto const misses = static_cast<uint64_t>(hi::global_counter<"text_shaper_cache:miss">);
+    auto const clears = static_cast<uint64_t>(hi::global_counter<"text_shaper_cache:clear">);
+    std::ignore = get(cache, "hello");
+    REQUIRE(hi::global_counter<"text_shaper_cache:miss"> == misses + 1);
+    REQUIRE(hi::global_counter<"text_shaper_cache:clear"> == clears + 1);
+    REQUIRE(cache.size() == 1);
+}
+
+}; // TEST_SUITE(text_shaper_cache_suite)
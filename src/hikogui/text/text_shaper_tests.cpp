@@ -0,0 +1,115 @@
+// Copyright Take Vos 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include "text_shaper.hpp"
+#include "../font/font.hpp"
+#include "../path/path.hpp"
+#include <hikotest/hikotest.hpp>
+#include <string_view>
+
+TEST_SUITE(text_shaper_suite) {
+
+static hi::text_style_set test_style()
+{
+    static auto const font = hi::register_font_file(hi::library_source_dir() / "resources" / "hikogui_icons.ttf");
+
+    auto style = hi::text_style{};
+    style.set_font_chain({font});
+    style.set_color(hi::color{1.0f, 1.0f, 1.0f});
+    style.set_size(hi::unit::points_per_em(short{12}));
+    style.set_line_spacing(1.0f);
+    style.set_paragraph_spacing(1.5f);
+
+    auto r = hi::text_style_set{};
+    r.push_back(hi::grapheme_attribute_mask{}, style);
+    return r;
+}
+
+static hi::unit::pixel_density test_pixel_density()
+{
+    return hi::unit::pixel_density{hi::unit::pixels_per_inch(96.0f), hi::device_type::desktop};
+}
+
+static hi::text_shaper make_shaper(std::string_view text)
+{
+    return hi::text_shaper{text, test_style(), test_pixel_density(), hi::alignment{}, true};
+}
+
+/** Check that updating @a old_text to @a new_text gives the same result as shaping @a new_text.
+ */
+static void check_update(std::string_view old_text, std::string_view new_text)
+{
+    auto updated = make_shaper(old_text);
+    updated.update(hi::to_gstring(new_text), test_style(), test_pixel_density(), hi::alignment{}, true);
+    auto expected = make_shaper(new_text);
+
+    REQUIRE(updated.size() == expected.size());
+    REQUIRE(updated.text_direction() == expected.text_direction());
+    for (std::size_t i = 0; i != expected.size(); ++i) {
+        auto const& u = updated.begin()[i];
+        auto const& e = expected.begin()[i];
+        REQUIRE(u.grapheme == e.grapheme);
+        REQUIRE(u.glyphs == e.glyphs);
+        REQUIRE(u.width == e.width);
+        REQUIRE(u.general_category == e.general_category);
+        REQUIRE(u.script == e.script);
+
+        // Word and sentence break opportunities.
+        for (auto const after : {false, true}) {
+            auto const cursor = hi::text_cursor{i, after};
+            REQUIRE(updated.select_word(cursor) == expected.select_word(cursor));
+            REQUIRE(updated.select_sentence(cursor) == expected.select_sentence(cursor));
+        }
+    }
+
+    // Line break opportunities and widths, by folding the text into a narrow rectangle.
+    auto const rectangle = hi::aarectangle{hi::extent2{60.0f, 1000.0f}};
+    updated.layout(rectangle, 0.0f, hi::extent2{1.0f, 1.0f});
+    expected.layout(rectangle, 0.0f, hi::extent2{1.0f, 1.0f});
+    REQUIRE(updated.lines().size() == expected.lines().size());
+    for (std::size_t i = 0; i != expected.size(); ++i) {
+        auto const& u = updated.begin()[i];
+        auto const& e = expected.begin()[i];
+        REQUIRE(u.line_nr == e.line_nr);
+        REQUIRE(u.column_nr == e.column_nr);
+        REQUIRE(u.position == e.position);
+    }
+}
+
+constexpr auto text = std::string_view{"Hello world. This is a test.\nSecond paragraph, with words.\nThird one. Last."};
+
+TEST_CASE(unchanged_test)
+{
+    check_update(text, text);
+}
+
+TEST_CASE(edit_paragraph_test)
+{
+    // Insert, delete and replace inside the first, middle and last paragraph.
+    check_update(text, "Hello big world. This is a test.\nSecond paragraph, with words.\nThird one. Last.");
+    check_update(text, "Hello world. This is a test.\nSecond, with words.\nThird one. Last.");
+    check_update(text, "Hello world. This is a test.\nSecond paragraph, with words.\nThird one. First.");
+    check_update(text, "hello world. This is a test.\nSecond paragraph, with words.\nThird one. Last!");
+}
+
+TEST_CASE(edit_separator_test)
+{
+    // Split a paragraph.
+    check_update(text, "Hello world.\nThis is a test.\nSecond paragraph, with words.\nThird one. Last.");
+    // Merge two paragraphs.
+    check_update(text, "Hello world. This is a test. Second paragraph, with words.\nThird one. Last.");
+    // Add and remove a paragraph at the ends.
+    check_update(text, "\nHello world. This is a test.\nSecond paragraph, with words.\nThird one. Last.\n");
+    check_update(text, "Second paragraph, with words.\nThird one. Last.");
+    check_update(text, "Hello world. This is a test.\nSecond paragraph, with words.\n");
+}
+
+TEST_CASE(replace_all_test)
+{
+    check_update(text, "Something else entirely.");
+    check_update(text, "");
+    check_update("", text);
+}
+
+}; // TEST_SUITE(text_shaper_suite)
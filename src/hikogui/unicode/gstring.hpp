@@ -250,6 +250,178 @@ constexpr void fix_language(It first, ItEnd last, language_tag default_language_
     return str;
 }
 
+namespace detail {
+
+/** Build a grapheme-string from a stream of code-points.
+ *
+ * The code-points are normalized and segmented into graphemes in a single
+ * pass. Code-points are collected in a small segment until a code-point is
+ * found that can not interact with the code-points before it during
+ * normalization. Then only that segment is normalized and passed on to the
+ * grapheme-break algorithm.
+ *
+ * A segment of a single code-point that is already in NFC, such as ASCII
+ * and Latin text, is copied without being normalized.
+ *
+ * The internal buffers are reused between segments, so that building a
+ * grapheme-string only allocates for the result.
+ */
+class gstring_builder {
+public:
+    constexpr gstring_builder(unicode_normalize_config const& config) noexcept :
+        _config(config),
+        _is_special(config),
+        _has_quick_check(config.decomposition_mask == unicode_NFD_mask or config.decomposition_mask == unicode_NFKD_mask)
+    {
+    }
+
+    constexpr void reserve(std::size_t size) noexcept
+    {
+        _r.reserve(size);
+    }
+
+    /** Add a code-point to the end of the text.
+     */
+    constexpr void push_back(char32_t code_point) noexcept
+    {
+        if (is_boundary(code_point)) {
+            flush_segment();
+        }
+        _segment += code_point;
+    }
+
+    /** Finish the text.
+     *
+     * @return The grapheme-string.
+     */
+    [[nodiscard]] constexpr gstring finish() noexcept
+    {
+        flush_segment();
+        flush_cluster();
+        return std::move(_r);
+    }
+
+private:
+    unicode_normalize_config const& _config;
+
+    /** Check if a code-point is replaced or dropped due to the configuration.
+     */
+    unicode_normalize_filter _is_special;
+
+    /** The configuration is NFC or NFKC, for which the quick-check properties
+     * are available.
+     */
+    bool _has_quick_check;
+
+    gstring _r = {};
+
+    /** The code-points that are not yet normalized.
+     */
+    std::u32string _segment = {};
+
+    /** A buffer for normalizing the segment.
+     */
+    std::u32string _normalized = {};
+
+    /** The normalized code-points of the current grapheme.
+     */
+    std::u32string _cluster = {};
+
+    grapheme_break_state _break_state = {};
+
+    /** Check if a code-point is a starter that is normalized on its own.
+     */
+    [[nodiscard]] constexpr bool is_stable(char32_t code_point) const noexcept
+    {
+        if (code_point < 0x300 and _config.decomposition_mask == unicode_NFD_mask) {
+            // Code-points below U+0300 are in NFC.
+            return true;
+        }
+
+        return ucd_get_canonical_combining_class(code_point) == 0 and
+            unicode_quick_check_code_point(code_point, _config.decomposition_mask, true) == unicode_quick_check::yes;
+    }
+
+    /** Check if normalization of the text before @a code_point is independent
+     * of @a code_point and the text after it.
+     */
+    [[nodiscard]] constexpr bool is_boundary(char32_t code_point) const noexcept
+    {
+        if (_segment.empty()) {
+            return true;
+        }
+
+        if (_is_special(code_point)) {
+            return false;
+        }
+
+        // Code-points below U+0300 are starters which are never the second
+        // code-point of a composition, and when decomposed start with such a starter.
+        if (code_point < 0x300) {
+            return true;
+        }
+
+        // A starter which does not compose with a previous code-point, see
+        // "UAX #15: Unicode Normalization Forms" NFC_Boundary_Before.
+        if (_has_quick_check) {
+            return is_stable(code_point);
+        }
+
+        if (ucd_get_canonical_combining_class(code_point) != 0 or
+            ucd_get_decomposition(code_point).should_decompose(_config.decomposition_mask)) {
+            return false;
+        }
+
+        // Other starters may compose with a directly preceding starter. Latin
+        // code-points never compose with a following starter, and a mark
+        // in-between blocks the composition.
+        auto const previous = _segment.back();
+        return not _is_special(previous) and (previous < 0x300 or ucd_get_canonical_combining_class(previous) != 0);
+    }
+
+    constexpr void flush_segment() noexcept
+    {
+        if (_segment.empty()) {
+            return;
+        }
+
+        auto const code_point = _segment.front();
+        if (_segment.size() == 1 and not _is_special(code_point) and
+            (code_point < 0xa0 or (_has_quick_check and is_stable(code_point)))) {
+            add_code_point(code_point);
+
+        } else {
+            _normalized.clear();
+            unicode_decompose(_segment, _config, _is_special, _normalized);
+            unicode_reorder(_normalized);
+            unicode_compose(_normalized);
+            unicode_clean(_normalized);
+            for (auto const c : _normalized) {
+                add_code_point(c);
+            }
+        }
+        _segment.clear();
+    }
+
+    constexpr void add_code_point(char32_t code_point) noexcept
+    {
+        if (breaks_grapheme(code_point, _break_state)) {
+            flush_cluster();
+        }
+        _cluster += code_point;
+    }
+
+    constexpr void flush_cluster() noexcept
+    {
+        if (not _cluster.empty()) {
+            _r += grapheme(composed_t{}, _cluster);
+            _cluster.clear();
+        }
+    }
+};
+
+} // namespace detail
+
 /** Convert a UTF-32 string-view to a grapheme-string.
  *
  * Before conversion to `gstring` a string is first normalized using the Unicode
@@ -260,28 +432,14 @@ constexpr void fix_language(It first, ItEnd last, language_tag default_language_
  * @return A grapheme-string.
  */
 [[nodiscard]] constexpr gstring
-to_gstring(std::u32string_view rhs, unicode_normalize_config config = unicode_normalize_config::NFC()) noexcept
+to_gstring(std::u32string_view rhs, unicode_normalize_config const& config = unicode_normalize_config::NFC()) noexcept
 {
-    auto const normalized_string = unicode_normalize(rhs, config);
-
-    auto r = gstring{};
-    auto break_state = detail::grapheme_break_state{};
-    auto cluster = std::u32string{};
-
-    for (auto const code_point : normalized_string) {
-        if (detail::breaks_grapheme(code_point, break_state)) {
-            if (cluster.size() > 0) {
-                r += grapheme(composed_t{}, cluster);
-            }
-            cluster.clear();
-        }
-
-        cluster += code_point;
+    auto builder = detail::gstring_builder{config};
+    builder.reserve(rhs.size());
+    for (auto const code_point : rhs) {
+        builder.push_back(code_point);
     }
-    if (ssize(cluster) != 0) {
-        r += grapheme(composed_t{}, cluster);
-    }
-    return r;
+    return builder.finish();
 }
 
 /** Convert a UTF-8 string to a grapheme-string.
@@ -289,14 +447,26 @@ to_gstring(std::u32string_view rhs, unicode_normalize_config config = unicode_no
  * Before conversion to `gstring` a string is first normalized using the Unicode
  * normalization algorithm. By default it is normalized using NFC.
  *
+ * The UTF-8 string is decoded, normalized and segmented in a single pass,
+ * without first converting the whole string to UTF-32.
+ *
  * @param rhs The UTF-8 string to convert.
  * @param config The attributes used for normalizing the input string.
  * @return A grapheme-string.
  */
 [[nodiscard]] constexpr gstring
-to_gstring(std::string_view rhs, unicode_normalize_config config = unicode_normalize_config::NFC()) noexcept
+to_gstring(std::string_view rhs, unicode_normalize_config const& config = unicode_normalize_config::NFC()) noexcept
 {
-    return to_gstring(to_u32string(rhs), config);
+    auto builder = detail::gstring_builder{config};
+    builder.reserve(rhs.size());
+
+    auto it = rhs.begin();
+    auto const last = rhs.end();
+    while (it != last) {
+        auto const [code_point, valid] = char_map<"utf-8">{}.read(it, last);
+        builder.push_back(code_point);
+    }
+    return builder.finish();
 }
 
 /** Convert a grapheme string to UTF-8.
@@ -4,6 +4,9 @@
 
 #include "gstring.hpp"
 #include <hikotest/hikotest.hpp>
+#include <string>
+#include <string_view>
+#include <cstddef>
 
 TEST_SUITE(gstring) {
 
@@ -14,4 +17,52 @@ TEST_CASE(from_utf8)
     REQUIRE(static_cast<int>(test[10].starter()) != 0);
 }
 
+TEST_CASE(from_utf8_ascii)
+{
+    auto const test = hi::to_gstring("Hello\r\nWorld");
+    REQUIRE(test.size() == std::size_t{11});
+    REQUIRE(test[5] == hi::grapheme(hi::composed_t{}, std::u32string{U"\r\n"}));
+    REQUIRE(hi::gstring_view{test}.substr(6) == std::string_view{"World"});
+}
+
+TEST_CASE(from_utf32_compose)
+{
+    // e + combining acute.
+    auto const test1 = hi::to_gstring(std::u32string_view{U"e\u0301x"});
+    REQUIRE(test1.size() == std::size_t{2});
+    REQUIRE(test1[0] == U'\u00e9');
+
+    // The combining marks are reordered before composing.
+    auto const test2 = hi::to_gstring(std::u32string_view{U"a\u0302\u0323"});
+    auto const test3 = hi::to_gstring(std::u32string_view{U"a\u0323\u0302"});
+    REQUIRE(test2.size() == std::size_t{1});
+    REQUIRE(test2[0] == U'\u1ead');
+    REQUIRE(test2 == test3);
+
+    // Hangul L + V + T.
+    auto const test4 = hi::to_gstring(std::u32string_view{U"\u1100\u1161\u11a8"});
+    REQUIRE(test4.size() == std::size_t{1});
+    REQUIRE(test4[0] == U'\uac01');
+
+    // Hangul LV + T.
+    auto const test5 = hi::to_gstring(std::u32string_view{U"\uac00\u11a8"});
+    REQUIRE(test5 == test4);
+}
+
+TEST_CASE(from_utf32_config)
+{
+    // Dropped code-points do not block composition.
+    auto const test1 = hi::to_gstring(std::u32string_view{U"e\r\u0301"}, hi::unicode_normalize_config::NFC_PS_noctr());
+    REQUIRE(test1.size() == std::size_t{1});
+    REQUIRE(test1[0] == U'\u00e9');
+
+    auto const test2 = hi::to_gstring(std::u32string_view{U"a\r\nb"}, hi::unicode_normalize_config::NFC_PS_noctr());
+    REQUIRE(test2.size() == std::size_t{3});
+    REQUIRE(test2[1] == U'\u2029');
+
+    // Compatibility decomposition of code-points below U+0300.
+    auto const test3 = hi::to_gstring(std::u32string_view{U"x\u00b2"}, hi::unicode_normalize_config::NFKC());
+    REQUIRE(test3 == std::string_view{"x2"});
+}
+
 };
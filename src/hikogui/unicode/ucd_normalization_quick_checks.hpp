@@ -0,0 +1,409 @@
+// This file was generated by generate_unicode_data.py
+
+#pragma once
+
+#include "../utility/utility.hpp"
+#include <cstdint>
+#include <optional>
+#include <bit>
+#include <string_view>
+#include <string>
+
+// Windows.h defines small as a macro.
+#ifdef small
+#undef small
+#endif
+
+hi_export_module(hikogui.unicode.ucd_normalization_quick_checks);
+
+hi_export namespace hi {
+inline namespace v1 {
+namespace detail {
+
+constexpr auto ucd_normalization_quick_checks_chunk_size = 64_uz;
+constexpr auto ucd_normalization_quick_checks_index_width = 8_uz;
+constexpr auto ucd_normalization_quick_checks_indices_size = 3050_uz;
+constexpr auto ucd_normalization_quick_check_width = 6_uz;
+
+static_assert(std::has_single_bit(ucd_normalization_quick_checks_chunk_size));
+
+constexpr uint8_t ucd_normalization_quick_checks_indices_bytes[3066] = {
+     0,  0,  1,  2,  3,  4,  5,  6,  7,  0,  8,  9, 10, 11, 12, 13, 14, 15,  0, 16,  0,  0, 17,  0, 18, 19,  0, 20,  0,  0,  0,  0,
+     0,  0,  0,  0, 21, 22, 23, 24, 25, 26,  0,  0, 23, 27, 28, 29,  0, 30,  0, 31, 23, 29,  0, 32, 33,  0, 33, 34, 35, 36, 37,  0,
+    38,  0,  0, 39,  0, 40, 41, 42,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 43, 44,  0,  0,  0,  0,  0,  0, 45, 46, 47,  0, 48, 48, 49, 50, 51, 52, 53, 54,
+    55, 56, 57,  0, 58, 59, 60, 61, 62, 63, 64, 65, 66,  0,  0,  0,  0, 67, 68, 69,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0, 35, 70,  0, 71,  0,  0,  0,  0,  0, 72,  0,  0,  0, 73,  0,  0,  0,  0, 74, 33, 68, 68, 68, 75,
+    76, 77, 78, 79, 80, 68, 81,  0, 82, 83, 68, 68, 68, 68, 68, 68,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 34,  0,  0, 84,  0, 85,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 86,  0,  0, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48,
+    48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48,
+    48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48,
+    48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48,
+    48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48,
+    48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 48, 87,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0, 88, 88, 88, 88, 89, 90, 88, 91, 92, 93, 94, 95, 68, 68, 68, 68, 96, 97, 98, 99,100,101, 68,102,103, 68,104,105,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,106,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,107,  0,108,  0,  0,  0,  0,  0,  0,  0, 23,109,  0,  0,  0,  0,110,  0,  0,  0,111,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,112,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,113,114,115,  0,  0,  0,  0,  0,  0,  0,  0, 68,116,117,118,119,120, 68, 68, 68, 68,121, 68, 68, 68, 68,122,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   123,124,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,125,126,127,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,128,129,130,  0,131,132,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,133,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    88, 88, 88, 88, 88, 88, 88, 88,134,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+};
+
+constexpr uint8_t ucd_normalization_quick_checks_bytes[6496] = {
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,160,  0,  0,  0,  0,  0,160, 10,  0,  0,  0, 40,  0, 10, 40,162,128,  0,162,138,  0,162,138,  0,
+   146, 73, 36,146, 64, 36,146, 73, 36,146, 73, 36,  2, 73, 36,146, 73,  0,  2, 73, 36,146, 64,  0,146, 73, 36,146, 64, 36,146, 73,
+    36,146, 73, 36,  2, 73, 36,146, 73,  0,  2, 73, 36,146, 64, 36,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,  0,  9, 36,146,
+    73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146, 64,  0,146, 73, 36,146, 73, 36,144, 10, 40,146, 73, 36,  2, 73, 36,146, 73, 40,
+   160,  0, 36,146, 73, 36,146,128,  0,146, 73, 36,146, 64,  0,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146, 64,  0,146, 73,
+    36,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 40,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,146, 64,  0,  0,  0,  0,  0,  0,  0,  0,  0, 36,144,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,162,138, 40,162,138, 40,162, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,144,  9, 36,146, 73, 36,  0,  9, 36,146, 73,
+    36,146, 73, 36,146,138, 40,146, 64,  0,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146,
+    73, 36,146, 73, 36,  0,  9, 36,  0,  0,  0,  0,  9, 36,146, 73, 36,146, 73, 36,146, 73, 36,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,162,138, 40,162,138, 40,160,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,162,138, 40,162,128,  0,162,138, 40,160,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+    73, 36,146, 72,  4,146, 73, 36,146, 72,  0, 18,  1, 32, 18, 72,  0,  0,  0,  0, 18,  0,  0,  0,  0,  0, 18, 73, 36,146, 72,  0,
+     0,  1, 36,128, 73, 32,  0,  0,  0,  0, 72,  0,  0,  0,  0,  0,182,212,173,181, 32,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,180,  0,  0,  0, 10,  0,  0, 11, 64,
+     0,  0,  0,162,201, 45,146, 73,  0,144,  9, 36,144,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  9,
+    36,146, 73, 36,144,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  9, 36,146, 73,  0,162,138, 44,178,
+   138,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,162,138,  0,162,128,  0,  2,128,  0,  0,  0,  0,
+   146, 64, 36,  0,  0, 36,  0,  0,  0,146, 73,  0,  0,  0,  0,  0,  0,  0,  2, 64,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  2, 64,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,146, 64, 36,  0,
+     0, 36,  0,  0,  0,146, 73,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  9, 36,  0,  0,  0,  0,  0,  0,
+     2, 73,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,146, 73, 36,  0,  9, 36,  0,  9, 36,146, 73, 36,  0,  9, 36,146, 73, 36,  0,  9,
+    36,146, 73, 36,146, 73, 36,146, 64,  0,146, 64,  0,  0,  0,  0,  0,  0,  0,  0,  0, 40,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  9, 36,146, 73,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 18, 73,
+    32,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  2,138, 40,160,  0,  0,  0,  0,  0,
+   144,  9,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 36,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  2, 64,  0,  0,  0,  0,  2, 64,  0,144,  0,  0,  0,  0,  0, 72,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,182,219,109,182,219,109,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  4,128,
+     0,  0,  0,  0,  0,  0,  0,  0, 36,144,  0,  0,  0,  0,  0,  0,  0, 18,  0,  0,  0,182,208, 45,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 45,  0, 11, 64,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  2,219,109,  0, 11, 64,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,144,  0, 36,144,  0,  0,  0,  0,  0,  0,
+     4,146,  0,  0,  0,182,208,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,144,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  4,128,  0,  0,  0,  0,  0,  0,  0,  9, 36,144,  0,  0,  0,  0,  0,  0,
+     0, 18,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,144,  0,  0,  0,  0,  0,  0,  0,  0,  0,  4,128,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,144,  4,128,  0,  0, 36,144,  9, 36,  0,  0,  0,  0,  0,  0,  1,
+    36,128,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  4,128,  0,  0, 18,  0,  0,  0,  0,  0,  0,  0,  9,  0,146, 73, 18,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 40,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,162,128,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,160,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0, 45,  0,  0,  0,  0,  0,  0,  2,208,  0,  0, 11, 64,  0,  0, 45,  0,  0,  0,180,  0,  0,  0,  0,  0,  0,  0,  0,  2,208,
+     0,  0,  0,  0,  0,  0, 45,  2,219,104,182,128,  0,  0,  0,  0,  2,208,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 45,  0,
+     0,  0,  0,  0,  0,  2,208,  0,  0, 11, 64,  0,  0, 45,  0,  0,  0,180,  0,  0,  0,  0,  0,  0,  0,  0,  2,208,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  9,  0,  0,  0,
+     0,  0,  4,128,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,160,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  1, 36,146, 73, 36,146, 73, 36,
+   146, 73, 36,146, 73, 36,146, 73, 32,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146,
+    73, 36,128,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  9,  0,144,  9,  0,144,  9,  0,  0,  9,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  1, 32,  0,  0,  0, 36,  2, 64,  0,
+   146, 64, 36,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,162,138,  0,162,138, 40,162,138, 40,162,138,  0,162,138, 40,
+   162,138, 40,162,138, 40,162,138, 40,162,128, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,160,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,
+   146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146, 73,
+    36,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146,
+    73, 36,146, 74, 44,  0,  0,  0,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,
+   146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146, 73,
+    36,146, 73, 36,146, 73, 36,146, 73, 36,146, 64,  0,  0,  0,  0,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146,
+    64,  0,146, 73, 36,146, 64,  0,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,
+   146, 73, 36,146, 64,  0,146, 73, 36,146, 64,  0,146, 73, 36,146, 73, 36,  2, 64, 36,  2, 64, 36,146, 73, 36,146, 73, 36,146, 73,
+    36,146, 73, 36,146,217, 45,146,217, 45,146,217, 45,146,208,  0,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146,
+    73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,144,  9, 36,146, 73, 45,146,139,104,
+   162,201, 36,144,  9, 36,146,217, 45,146,203, 44,146, 73, 45,  0,  9, 36,146, 73, 45,  2,203, 44,146, 73, 45,146, 73, 36,146, 73,
+    45,146,203,109,  0,  9, 36,144,  9, 36,146,217, 45,146,218,  0,182,218, 40,162,138, 40,162,138,  0,  0,  0,  0,  2,128,  0,  0,
+     0, 40,  0,  0,  0,  0,  0,  0,  0,  0,  0,162,138,  0,  0,  0,  0,  0,  0, 40,  0,  0, 40,160, 10, 40,  0,  0,  0,160, 10,  0,
+     0,  0,  0,  0,  0, 40,162,128,  0,  0,  0,  0,  0,  0,  0,  0,  0, 40,  0,  0,  0,  0,  0, 40,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,162,128,  0,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138,  0,162,138, 40,162,
+   138, 40,162,138, 40,160,  0,  0,  0,  0,  0,  0,  0,  0,160,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   162,138, 40,  2,138, 40,  2,138, 40,162,138, 40,162,138, 40,  2,138,  0,  2,138, 40,162,128,  0,162,138,  0,160, 11, 64,160, 11,
+   109,162,128, 40,162,128, 40,162,138, 40,162,128, 40,162,138, 40,160,  0,  0,  2,138, 40,162,128,  0,  0,  0,  0,162,138, 40,162,
+   138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,
+     0,  0,  0,  0,  0,  0,  2,128,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  9, 36,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  9,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  2, 73, 36,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,144,  0,  0,  2, 64,  0,144,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,144,  9,  0,  0,  0,
+     0,162,128, 40,160,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  2, 64,  0,144,  0, 36,  2, 64,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,144,  9,  0,  0,  0,  0,  0,  0,  0,  2, 73, 36,146, 64,  0,146, 64,  0,146, 64,  0,  0,  0,  0,
+   146, 64,  0,146, 64,  0,146, 64,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,146, 73, 36,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,146, 73, 36,  0,  0,  0,  0,  9, 36,146, 64,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  2,219,
+    64,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,
+   162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138,
+    40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,
+   138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,162,138,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,180,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,162,128,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 40,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 40,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,
+   128,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   160,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0, 10,  0,162,138,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,144,  9,  0,144,  9,  0,144,
+     9,  0,144,  9,  0,144,  9,  0,144,  9,  0,  2, 64, 36,  2, 64,  0,  0,  0,  0,146, 64, 36,144,  9, 36,  2, 73,  0,146, 64,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,144,  0,  0,  1, 36,168,160,  9, 40,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,144,  9,  0,144,  9,  0,144,  9,  0,144,  9,  0,144,  9,  0,144,  9,  0,  2, 64, 36,  2, 64,  0,  0,  0,  0,146, 64, 36,144,
+     9, 36,  2, 73,  0,146, 64,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,144,  0, 36,146, 73,  0,  0,  9, 40,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  2,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138,  0,  0, 10, 40,162,
+   138, 40,162,138, 40,162,138, 40,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138,  0,162,138, 40,162,138, 40,162,138,
+    40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,  0,  0,  0,  0,  0,  0,162,138, 40,162,
+   138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,160,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 10, 40,160,  0,  0,162,128,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,162,138, 40,  0,  0,  0,  0,  0,  0,  2,128,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146, 73, 36,146,
+    73, 36,146, 73, 36,146, 73, 36,146, 73, 36,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   182,219,109,182,219,109,182,219,109,182,219,109,182,219,109,182,219,109,182,219,109,182,219,109,182,219,109,182,219,109,182,219,
+   109,182,219,109,182,219,109,182,219,109,182,219,109,182,219,109,182,219,109,182,219,109,182,219,109,182,208,  0,180, 11, 64,  2,
+   219,109,182,219,109,182,219, 64,180, 11, 64,  2,219, 64,  0, 11,109,182,219,109,182,219,109,182,219,109,182,219,109,182,219,109,
+   182,219,109,182,219,109,182,219,109,182,219,109,182,219,109,182,219,109,182,219,109,182,219,109,182,219,109,182,219,109,182,219,
+   109,182,208,  0,182,219,109,182,219,109,182,219,109,182,219,109,182,219,109,182,219,109,182,219,109,182,219,109,182,219,109,182,
+   219,109,182,208,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   162,138, 40,162,138,  0,  0,  0,  0,  0,  0,  0,  0,  0, 40,162,138, 40,  0,  0,  0,  2,208, 45,162,138, 40,162,138, 40,162,139,
+   109,182,219,109,182,219,109,182,219, 64,182,219,109,180, 11, 64,182,208, 45,180, 11,109,182,219,109,182,219,104,162,138, 40,162,
+   138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,
+   162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138,
+    40,162,138, 40,162,128,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 40,162,
+   138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,
+   162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138,
+    40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,128,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,162,138, 40,162,
+   138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,
+   162,138, 40,162,138, 40,162,138, 40,162,138, 40,  0, 10, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138,
+    40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,162,138, 40,162,138, 40,162,138, 40,160,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,162,138, 40,162,138, 40,162,128,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,160,  0, 40,162,138, 40,162,138, 40,162,138,  0,162,
+   138, 40,162,138, 40,162,138, 40,162,138, 40,162,138,  0,162,138, 40,  0,  0,  0,162,138,  0,160, 10, 40,162,138, 40,162,138, 40,
+   162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138,
+    40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,160,  0,  0,  2,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,
+   138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,
+   162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138,
+    40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138,  0,  0, 10, 40,162,138, 40,  0, 10, 40,162,138, 40,  0, 10, 40,162,
+   138, 40,  0, 10, 40,160,  0,  0,162,138, 40,162,138,  0,162,138, 40,162,138,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     2,138, 40,162,128, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138,
+    40,162,138, 40,160, 10, 40,162,138, 40,162,138,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  9,  0,144,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 36,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  4,128,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 18,  0,  0,
+     0,  0,  9, 36,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 36,144,  0,  0,  0,  0,  0,  0,
+     0, 18,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0, 72,  0,  0,  0,  0,  0,  0,  4,164,145, 41,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 18,  0,  0,  0,  0,  0,  0,  0,  9, 36,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0, 72,  0,  0,  0,  0,  0,144,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0, 11,109,182,219,109,180,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 45,182,219,109,180,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+   162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,160, 10, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138,
+    40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,
+   138, 40,162,138, 40,160, 10, 40,  0, 10,  0,  2,138,  0,  2,138, 40,160, 10, 40,162,138, 40,162,138, 40,162,128, 40,  2,138, 40,
+   162,138, 40,  2,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138,
+    40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,128, 40,162,138,  0,  2,138, 40,162,138, 40,160,
+    10, 40,162,138, 40,160, 10, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,128, 40,162,138,  0,
+   162,138, 40,160, 10,  0,  0, 10, 40,162,138, 40,160, 10, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138,
+    40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,
+   138, 40,162,138, 40,162,138, 40,162,138, 40,162,128,  0,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,
+   162,138, 40,162,138, 40,162,138, 40,  0, 10, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138,
+    40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,162,138, 40,162,138, 40,162,138, 40,162,138, 40,
+   162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138,
+    40,162,128,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,162,138, 40,  2,138, 40,162,138, 40,162,138, 40,162,138, 40,162,
+   138, 40,162,138, 40,162,138, 40,  2,138,  0,160,  0, 40,  2,138, 40,162,138, 40,162,138,  0,162,138, 40,  2,128, 40,  0,  0,  0,
+     0, 10,  0,  0,  0, 40,  2,128, 40,  2,138, 40,  2,138,  0,160,  0, 40,  2,128, 40,  2,128, 40,  2,138,  0,160,  0, 40,162,138,
+     0,162,138, 40,162,138,  0,162,138, 40,  2,138, 40,160, 10,  0,162,138, 40,162,138, 40,162,128, 40,162,138, 40,162,138, 40,162,
+   138, 40,162,138, 40,  0,  0,  0,  2,138, 40,  2,138, 40,162,128, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,  0,  0,  0,
+   162,138, 40,162,138, 40,162,138,  0,  0,  0,  0,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138,
+    40,162,138,  0,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, 10, 40,160,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,160,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,162,138,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,162,138, 40,162,
+   138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,162,138, 40,  0,  0,  0,
+   162,138, 40,162,138, 40,160,  0,  0,  0,  0,  0,162,128,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,162,138, 40,162,138, 40,162,128,  0,  0,  0,  0,
+   182,219,109,182,219,109,182,219,109,182,219,109,182,219,109,182,219,109,182,219,109,182,208,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+     0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,
+};
+
+} // namespace detail
+
+/** The value of a normalization quick-check property.
+ */
+enum class unicode_quick_check : uint8_t {
+    /** The code-point may occur in the normalization form.
+     */
+    yes = 0,
+
+    /** The code-point can not occur in the normalization form.
+     */
+    no = 1,
+
+    /** The code-point may occur in the normalization form, depending on
+     * the code-points before it.
+     */
+    maybe = 2
+};
+
+/** The normalization quick-check properties of a code-point.
+ */
+struct ucd_normalization_quick_check_info {
+    using value_type = uint8_t;
+
+    value_type value;
+
+    [[nodiscard]] constexpr unicode_quick_check NFC() const noexcept
+    {
+        return static_cast<unicode_quick_check>(value & 3);
+    }
+
+    [[nodiscard]] constexpr unicode_quick_check NFD() const noexcept
+    {
+        return static_cast<unicode_quick_check>((value >> 2) & 1);
+    }
+
+    [[nodiscard]] constexpr unicode_quick_check NFKC() const noexcept
+    {
+        return static_cast<unicode_quick_check>((value >> 3) & 3);
+    }
+
+    [[nodiscard]] constexpr unicode_quick_check NFKD() const noexcept
+    {
+        return static_cast<unicode_quick_check>((value >> 5) & 1);
+    }
+};
+
+/** Get the normalization quick-check properties of a code-point.
+ */
+[[nodiscard]] constexpr ucd_normalization_quick_check_info ucd_get_normalization_quick_check(char32_t code_point) noexcept
+{
+    constexpr auto max_code_point_hi = detail::ucd_normalization_quick_checks_indices_size - 1;
+
+    auto code_point_hi = code_point / detail::ucd_normalization_quick_checks_chunk_size;
+    auto const code_point_lo = code_point % detail::ucd_normalization_quick_checks_chunk_size;
+
+    if (code_point_hi > max_code_point_hi) {
+        code_point_hi = max_code_point_hi;
+    }
+
+    auto const chunk_index = load_bits_be<detail::ucd_normalization_quick_checks_index_width>(
+        detail::ucd_normalization_quick_checks_indices_bytes,
+        code_point_hi * detail::ucd_normalization_quick_checks_index_width);
+
+    // Add back in the lower-bits of the code-point.
+    auto const index = (chunk_index * detail::ucd_normalization_quick_checks_chunk_size) + code_point_lo;
+
+    // Get the quick-check properties from the table.
+    auto const value = load_bits_be<detail::ucd_normalization_quick_check_width>(
+        detail::ucd_normalization_quick_checks_bytes, index * detail::ucd_normalization_quick_check_width);
+
+    return ucd_normalization_quick_check_info{narrow_cast<ucd_normalization_quick_check_info::value_type>(value)};
+}
+
+}} // namespace hi::v1
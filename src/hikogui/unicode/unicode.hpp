@@ -20,6 +20,7 @@
 #include "ucd_grapheme_cluster_breaks.hpp" // export
 #include "ucd_lexical_classes.hpp" // export
 #include "ucd_line_break_classes.hpp" // export
+#include "ucd_normalization_quick_checks.hpp" // export
 #include "ucd_scripts.hpp" // export
 #include "ucd_sentence_break_properties.hpp" // export
 #include "ucd_word_break_properties.hpp" // export
@@ -7,6 +7,7 @@
 #include "ucd_decompositions.hpp"
 #include "ucd_compositions.hpp"
 #include "ucd_canonical_combining_classes.hpp"
+#include "ucd_normalization_quick_checks.hpp"
 #include "unicode_description.hpp"
 #include "../algorithm/algorithm.hpp"
 #include "../utility/utility.hpp"
@@ -133,7 +134,129 @@ struct unicode_normalize_config {
 
 namespace detail {
 
-constexpr void unicode_decompose(char32_t code_point, unicode_normalize_config config, std::u32string& r) noexcept
+constexpr uint64_t unicode_NFD_mask = unicode_normalize_config::NFD().decomposition_mask;
+constexpr uint64_t unicode_NFKD_mask = unicode_normalize_config::NFKD().decomposition_mask;
+
+/** A quick filter for code-points that are replaced or dropped by a configuration.
+ *
+ * The filter is created once for a text, so that the lists of code-points in
+ * the configuration are not scanned for every code-point.
+ */
+class unicode_normalize_filter {
+public:
+    constexpr unicode_normalize_filter(unicode_normalize_config const& config) noexcept : _config(config)
+    {
+        for (auto const c : config.line_separators) {
+            _bloom |= uint64_t{1} << (c % 64);
+        }
+        for (auto const c : config.paragraph_separators) {
+            _bloom |= uint64_t{1} << (c % 64);
+        }
+        for (auto const c : config.drop) {
+            _bloom |= uint64_t{1} << (c % 64);
+        }
+    }
+
+    /** Check if a code-point is replaced or dropped due to the configuration.
+     */
+    [[nodiscard]] constexpr bool operator()(char32_t code_point) const noexcept
+    {
+        if (_config.drop_C0 and (code_point <= U'\u001f' or code_point == U'\u007f')) {
+            return true;
+        }
+        if (_config.drop_C1 and code_point >= U'\u0080' and code_point <= U'\u009f') {
+            return true;
+        }
+        if (not to_bool((_bloom >> (code_point % 64)) & 1)) {
+            return false;
+        }
+        return _config.line_separators.find(code_point) != std::u32string::npos or
+            _config.paragraph_separators.find(code_point) != std::u32string::npos or
+            _config.drop.find(code_point) != std::u32string::npos;
+    }
+
+private:
+    unicode_normalize_config const& _config;
+    uint64_t _bloom = 0;
+};
+
+/** Get the quick-check property of a code-point for the normalization form of a configuration.
+ *
+ * Only NFD and NFKD decompositions have quick-check properties, for other
+ * decompositions a code-point which may decompose returns `maybe`.
+ *
+ * @param code_point The code-point to check.
+ * @param decomposition_mask The types of decompositions that are used.
+ * @param compose True for a composed normalization form.
+ */
+[[nodiscard]] constexpr unicode_quick_check
+unicode_quick_check_code_point(char32_t code_point, uint64_t decomposition_mask, bool compose) noexcept
+{
+    auto const info = ucd_get_normalization_quick_check(code_point);
+    if (decomposition_mask == unicode_NFD_mask) {
+        return compose ? info.NFC() : info.NFD();
+    } else if (decomposition_mask == unicode_NFKD_mask) {
+        return compose ? info.NFKC() : info.NFKD();
+    } else if (info.NFKD() != unicode_quick_check::yes) {
+        return unicode_quick_check::maybe;
+    } else {
+        // Without a decomposition, a code-point may only compose with a previous code-point.
+        return compose ? info.NFC() : unicode_quick_check::yes;
+    }
+}
+
+/** Check if a text is in the normalization form of a configuration.
+ *
+ * This is the quick-check algorithm from "UAX #15: Unicode Normalization
+ * Forms", extended so that code-points replaced or dropped by the
+ * configuration return `maybe`.
+ *
+ * @param text The text to check.
+ * @param config The configuration used for normalization.
+ * @param filter The filter for code-points replaced or dropped by @a config.
+ * @param compose True for a composed normalization form.
+ * @retval yes The text is normalized.
+ * @retval no The text is not normalized.
+ * @retval maybe The text needs to be normalized to find out.
+ */
+[[nodiscard]] constexpr unicode_quick_check unicode_is_normalized(
+    std::u32string_view text,
+    unicode_normalize_config const& config,
+    unicode_normalize_filter const& filter,
+    bool compose) noexcept
+{
+    auto r = unicode_quick_check::yes;
+    auto previous_ccc = uint8_t{0};
+    for (auto const code_point : text) {
+        if (filter(code_point)) {
+            // The replacement may be the same code-point.
+            r = unicode_quick_check::maybe;
+        }
+
+        if (code_point < 0xa0) {
+            // Code-points below U+00A0 are starters without a decomposition,
+            // which are never the second code-point of a composition.
+            previous_ccc = 0;
+            continue;
+        }
+
+        auto const ccc = ucd_get_canonical_combining_class(code_point);
+        if (ccc != 0 and previous_ccc > ccc) {
+            return unicode_quick_check::no;
+        }
+        previous_ccc = ccc;
+
+        auto const quick_check = unicode_quick_check_code_point(code_point, config.decomposition_mask, compose);
+        if (quick_check == unicode_quick_check::no) {
+            return unicode_quick_check::no;
+        } else if (quick_check == unicode_quick_check::maybe) {
+            r = unicode_quick_check::maybe;
+        }
+    }
+    return r;
+}
+
+constexpr void unicode_decompose(char32_t code_point, unicode_normalize_config const& config, std::u32string& r) noexcept
 {
     for (auto const c : config.line_separators) {
         if (code_point == c) {
@@ -181,13 +304,36 @@ constexpr void unicode_decompose(char32_t code_point, unicode_normalize_config c
     }
 }
 
-constexpr void unicode_decompose(std::u32string_view text, unicode_normalize_config config, std::u32string& r) noexcept
+constexpr void unicode_decompose(
+    std::u32string_view text,
+    unicode_normalize_config const& config,
+    unicode_normalize_filter const& filter,
+    std::u32string& r) noexcept
 {
-    for (auto const c : text) {
-        unicode_decompose(c, config, r);
+    for (auto const code_point : text) {
+        if (filter(code_point)) {
+            unicode_decompose(code_point, config, r);
+            continue;
+        }
+
+        auto const decomposition_info = ucd_get_decomposition(code_point);
+        if (decomposition_info.should_decompose(config.decomposition_mask)) {
+            for (auto const c : decomposition_info.decompose()) {
+                unicode_decompose(c, config, r);
+            }
+
+        } else {
+            auto const ccc = ucd_get_canonical_combining_class(code_point);
+            r += code_point | (wide_cast<char32_t>(ccc) << 24);
+        }
     }
 }
 
+constexpr void unicode_decompose(std::u32string_view text, unicode_normalize_config const& config, std::u32string& r) noexcept
+{
+    unicode_decompose(text, config, unicode_normalize_filter{config}, r);
+}
+
 constexpr void unicode_compose(std::u32string& text) noexcept
 {
     if (text.size() <= 1) {
@@ -284,31 +430,73 @@ constexpr void unicode_clean(std::u32string& text) noexcept
 
 } // namespace detail
 
+/** Check if text is in a Unicode decomposed normal form.
+ *
+ * @param text The text to check.
+ * @param config The configuration used for normalization.
+ * @retval yes The text is normalized.
+ * @retval no The text is not normalized.
+ * @retval maybe The text needs to be normalized to find out.
+ */
+[[nodiscard]] constexpr unicode_quick_check
+unicode_is_decomposed(std::u32string_view text, unicode_normalize_config const& config = unicode_normalize_config::NFD()) noexcept
+{
+    return detail::unicode_is_normalized(text, config, detail::unicode_normalize_filter{config}, false);
+}
+
+/** Check if text is in a Unicode composed normal form.
+ *
+ * @param text The text to check.
+ * @param config The configuration used for normalization.
+ * @retval yes The text is normalized.
+ * @retval no The text is not normalized.
+ * @retval maybe The text needs to be normalized to find out.
+ */
+[[nodiscard]] constexpr unicode_quick_check
+unicode_is_normalized(std::u32string_view text, unicode_normalize_config const& config = unicode_normalize_config::NFC()) noexcept
+{
+    return detail::unicode_is_normalized(text, config, detail::unicode_normalize_filter{config}, true);
+}
+
 /** Convert text to a Unicode decomposed normal form.
+ *
+ * Text which is already normalized is copied unchanged.
  *
  * @param text to normalize, in-place.
  * @param normalization_mask Extra features for normalization.
  */
 [[nodiscard]] constexpr std::u32string
-unicode_decompose(std::u32string_view text, unicode_normalize_config config = unicode_normalize_config::NFD()) noexcept
+unicode_decompose(std::u32string_view text, unicode_normalize_config const& config = unicode_normalize_config::NFD()) noexcept
 {
+    auto const filter = detail::unicode_normalize_filter{config};
+    if (detail::unicode_is_normalized(text, config, filter, false) == unicode_quick_check::yes) {
+        return std::u32string{text};
+    }
+
     auto r = std::u32string{};
-    detail::unicode_decompose(text, config, r);
+    detail::unicode_decompose(text, config, filter, r);
     detail::unicode_reorder(r);
     detail::unicode_clean(r);
     return r;
 }
 
 /** Convert text to a Unicode composed normal form.
+ *
+ * Text which is already normalized is copied unchanged.
  *
  * @param text to normalize, in-place.
  * @param normalization_mask Extra features for normalization.
  */
 [[nodiscard]] constexpr std::u32string
-unicode_normalize(std::u32string_view text, unicode_normalize_config config = unicode_normalize_config::NFC()) noexcept
+unicode_normalize(std::u32string_view text, unicode_normalize_config const& config = unicode_normalize_config::NFC()) noexcept
 {
+    auto const filter = detail::unicode_normalize_filter{config};
+    if (detail::unicode_is_normalized(text, config, filter, true) == unicode_quick_check::yes) {
+        return std::u32string{text};
+    }
+
     auto r = std::u32string{};
-    detail::unicode_decompose(text, config, r);
+    detail::unicode_decompose(text, config, filter, r);
     detail::unicode_reorder(r);
     detail::unicode_compose(r);
     detail::unicode_clean(r);
@@ -333,11 +521,15 @@ template<std::input_iterator It, std::sentinel_for<It> ItEnd>
         return false;
     }
 
-    if (ucd_get_canonical_combining_class(*it++) != 0) {
+    if (ucd_get_canonical_combining_class(*it) != 0) {
         // The first code-point must be a starter (CCC == 0).
         return false;
     }
 
+    if (ucd_get_normalization_quick_check(*it++).NFC() == unicode_quick_check::no) {
+        return false;
+    }
+
     // Check if each consequtive code-point is a mark (CCC != 0).
     // And that the CCC is ordered by numeric value.
     auto max_ccc = uint8_t{1};
@@ -348,8 +540,9 @@ template<std::input_iterator It, std::sentinel_for<It> ItEnd>
         }
         max_ccc = ccc;
 
-        // XXX Needs check if code-point is allowed in NFC.
-
+        if (ucd_get_normalization_quick_check(*it).NFC() == unicode_quick_check::no) {
+            return false;
+        }
     }
 
     // All tests pass.
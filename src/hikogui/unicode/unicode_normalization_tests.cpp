@@ -173,6 +173,68 @@ TEST_CASE(NFKD)
     }
 }
 
+TEST_CASE(quick_check)
+{
+    // LATIN SMALL LETTER A
+    REQUIRE(hi::ucd_get_normalization_quick_check(U'a').NFC() == hi::unicode_quick_check::yes);
+    REQUIRE(hi::ucd_get_normalization_quick_check(U'a').NFKD() == hi::unicode_quick_check::yes);
+    // LATIN SMALL LETTER E WITH ACUTE
+    REQUIRE(hi::ucd_get_normalization_quick_check(U'\u00e9').NFC() == hi::unicode_quick_check::yes);
+    REQUIRE(hi::ucd_get_normalization_quick_check(U'\u00e9').NFD() == hi::unicode_quick_check::no);
+    // COMBINING ACUTE ACCENT
+    REQUIRE(hi::ucd_get_normalization_quick_check(U'\u0301').NFC() == hi::unicode_quick_check::maybe);
+    REQUIRE(hi::ucd_get_normalization_quick_check(U'\u0301').NFD() == hi::unicode_quick_check::yes);
+    // OHM SIGN, a singleton decomposition.
+    REQUIRE(hi::ucd_get_normalization_quick_check(U'\u2126').NFC() == hi::unicode_quick_check::no);
+    // FEMININE ORDINAL INDICATOR
+    REQUIRE(hi::ucd_get_normalization_quick_check(U'\u00aa').NFC() == hi::unicode_quick_check::yes);
+    REQUIRE(hi::ucd_get_normalization_quick_check(U'\u00aa').NFKC() == hi::unicode_quick_check::no);
+    // HANGUL JUNGSEONG A
+    REQUIRE(hi::ucd_get_normalization_quick_check(U'\u1161').NFKC() == hi::unicode_quick_check::maybe);
+}
+
+TEST_CASE(is_normalized)
+{
+    REQUIRE(hi::unicode_is_normalized(U"Audio device:") == hi::unicode_quick_check::yes);
+    REQUIRE(hi::unicode_is_decomposed(U"Audio device:") == hi::unicode_quick_check::yes);
+    REQUIRE(hi::unicode_is_normalized(U"caf\u00e9") == hi::unicode_quick_check::yes);
+    REQUIRE(hi::unicode_is_decomposed(U"caf\u00e9") == hi::unicode_quick_check::no);
+    REQUIRE(hi::unicode_is_normalized(U"cafe\u0301") == hi::unicode_quick_check::maybe);
+    REQUIRE(hi::unicode_is_decomposed(U"cafe\u0301") == hi::unicode_quick_check::yes);
+    REQUIRE(hi::unicode_is_normalized(U"\u2126") == hi::unicode_quick_check::no);
+
+    // Combining marks out of canonical order.
+    REQUIRE(hi::unicode_is_decomposed(U"a\u0301\u0316") == hi::unicode_quick_check::no);
+    REQUIRE(hi::unicode_is_decomposed(U"a\u0316\u0301") == hi::unicode_quick_check::yes);
+
+    REQUIRE(hi::unicode_is_normalized(U"x\u00b2") == hi::unicode_quick_check::yes);
+    REQUIRE(hi::unicode_is_normalized(U"x\u00b2", hi::unicode_normalize_config::NFKC()) == hi::unicode_quick_check::no);
+
+    // Code-points replaced by the configuration.
+    REQUIRE(hi::unicode_is_normalized(U"a\nb", hi::unicode_normalize_config::NFC_PS_noctr()) == hi::unicode_quick_check::maybe);
+}
+
+TEST_CASE(is_normalized_conformance)
+{
+    for (auto const& test : parseNormalizationTests()) {
+        REQUIRE(hi::unicode_is_normalized(test.c2) != hi::unicode_quick_check::no, test.comment);
+        REQUIRE(hi::unicode_is_decomposed(test.c3) != hi::unicode_quick_check::no, test.comment);
+        REQUIRE(
+            hi::unicode_is_normalized(test.c4, hi::unicode_normalize_config::NFKC()) != hi::unicode_quick_check::no,
+            test.comment);
+        REQUIRE(
+            hi::unicode_is_decomposed(test.c5, hi::unicode_normalize_config::NFKD()) != hi::unicode_quick_check::no,
+            test.comment);
+
+        if (test.c1 != test.c2) {
+            REQUIRE(hi::unicode_is_normalized(test.c1) != hi::unicode_quick_check::yes, test.comment);
+        }
+        if (test.c1 != test.c3) {
+            REQUIRE(hi::unicode_is_decomposed(test.c1) != hi::unicode_quick_check::yes, test.comment);
+        }
+    }
+}
+
 #ifdef NDEBUG
 
 TEST_CASE(invariant)
@@ -14,6 +14,7 @@
 #include <exception>
 #include <cstddef>
 #include <type_traits>
+#include <new>
 #include <stdint.h>
 #if defined(__APPLE__)
 #include <TargetConditionals.h>
@@ -66,6 +67,16 @@ constexpr std::size_t maximum_num_cpus = CPU_SETSIZE;
 #error "Not implemented."
 #endif
 
+/** The minimum distance between two objects to avoid false sharing.
+ *
+ * libc++ does not define std::hardware_destructive_interference_size, and gcc
+ * warns when it is used in a header, since its value depends on the -mtune flag.
+ */
+#if defined(__cpp_lib_hardware_interference_size) and HI_COMPILER != HI_CC_GCC
+constexpr std::size_t destructive_interference_size = std::hardware_destructive_interference_size;
+#else
+constexpr std::size_t destructive_interference_size = 128;
+#endif
 
 } // namespace hi::inline v1
 
@@ -84,7 +84,7 @@ public:
     }
 
     /// @privatesection
-    [[nodiscard]] box_constraints update_constraints() noexcept override
+    [[nodiscard]] box_constraints do_update_constraints() noexcept override
     {
         _layout = {};
         _on_label_constraints = _on_label_widget->update_constraints();
@@ -93,7 +93,7 @@ public:
         return max(_on_label_constraints, _off_label_constraints, _other_label_constraints);
     }
 
-    void set_layout(widget_layout const& context) noexcept override
+    void do_set_layout(widget_layout const& context) noexcept override
     {
         _on_label_widget->set_mode(value() == widget_value::on ? widget_mode::display : widget_mode::invisible);
         _off_label_widget->set_mode(value() == widget_value::off ? widget_mode::display : widget_mode::invisible);
@@ -143,13 +143,13 @@ public:
     }
 
     /// @privatesection
-    [[nodiscard]] box_constraints update_constraints() noexcept override
+    [[nodiscard]] box_constraints do_update_constraints() noexcept override
     {
         _button_size = {theme().size(), theme().size()};
         return box_constraints{_button_size, _button_size, _button_size, *attributes.alignment, theme().margin()};
     }
 
-    void set_layout(widget_layout const& context) noexcept override
+    void do_set_layout(widget_layout const& context) noexcept override
     {
         if (compare_store(_layout, context)) {
             _button_rectangle = align(context.rectangle(), _button_size, os_settings::alignment(*attributes.alignment));
@@ -162,7 +162,7 @@ public:
             auto const minus_glyph_bb = _minus_glyph.front_glyph_metrics().bounding_rectangle * theme().icon_size();
             _minus_glyph_rectangle = align(_button_rectangle, minus_glyph_bb, alignment::middle_center());
         }
-        super::set_layout(context);
+        super::do_set_layout(context);
     }
 
     void draw(draw_context const& context) noexcept override
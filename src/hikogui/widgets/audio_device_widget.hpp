@@ -57,14 +57,14 @@ public:
         co_yield *_grid_widget;
     }
 
-    [[nodiscard]] box_constraints update_constraints() noexcept override
+    [[nodiscard]] box_constraints do_update_constraints() noexcept override
     {
         _layout = {};
         _grid_constraints = _grid_widget->update_constraints();
         return _grid_constraints;
     }
 
-    void set_layout(widget_layout const& context) noexcept override
+    void do_set_layout(widget_layout const& context) noexcept override
     {
         if (compare_store(_layout, context)) {
             auto const grid_rectangle = context.rectangle();
@@ -76,7 +76,7 @@ public:
         hi_log_info("grid_widget::insert({}, {}, {}, {})", first_column, first_row, last_column, last_row);
 
         ++global_counter<"grid_widget:insert:constrain">;
-        process_event({gui_event_type::window_reconstrain});
+        request_reconstrain();
     }
 
     /** Insert a widget to the front of the grid.
@@ -288,7 +288,7 @@ public:
         }
     }
 
-    [[nodiscard]] box_constraints update_constraints() noexcept override
+    [[nodiscard]] box_constraints do_update_constraints() noexcept override
     {
         _layout = {};
 
@@ -299,7 +299,7 @@ public:
         return _grid.constraints(os_settings::left_to_right());
     }
 
-    void set_layout(widget_layout const& context) noexcept override
+    void do_set_layout(widget_layout const& context) noexcept override
     {
         if (compare_store(_layout, context)) {
             _grid.set_layout(context.shape, theme().baseline_adjustment());
@@ -73,7 +73,7 @@ public:
     }
 
     /// @privatesection
-    [[nodiscard]] box_constraints update_constraints() noexcept override
+    [[nodiscard]] box_constraints do_update_constraints() noexcept override
     {
         _layout = {};
 
@@ -91,7 +91,7 @@ public:
                     // Could not get an image, retry.
                     _icon_has_modified = true;
                     ++global_counter<"icon_widget:no-backing-image:constrain">;
-                    process_event({gui_event_type::window_reconstrain});
+                    request_reconstrain();
                 }
 
             } else if (auto const g1 = std::get_if<font_glyph_ids>(&icon)) {
@@ -126,7 +126,7 @@ public:
             theme().margin<float>()};
         return icon_constraints.constrain(*minimum, *maximum);
     }
-    void set_layout(widget_layout const& context) noexcept override
+    void do_set_layout(widget_layout const& context) noexcept override
     {
         if (compare_store(_layout, context)) {
             if (_icon_type == icon_type::no or not _icon_size) {
@@ -193,7 +193,7 @@ private:
         _icon_cbt = icon.subscribe([this](auto...) {
             _icon_has_modified = true;
             ++global_counter<"icon_widget:icon:constrain">;
-            process_event({gui_event_type::window_reconstrain});
+            request_reconstrain();
         });
     }
 };
@@ -94,7 +94,7 @@ public:
         co_yield *_text_widget;
     }
 
-    [[nodiscard]] box_constraints update_constraints() noexcept override
+    [[nodiscard]] box_constraints do_update_constraints() noexcept override
     {
         _layout = {};
 
@@ -148,7 +148,7 @@ public:
 
         return _grid.constraints(os_settings::left_to_right());
     }
-    void set_layout(widget_layout const& context) noexcept override
+    void do_set_layout(widget_layout const& context) noexcept override
     {
         if (compare_store(_layout, context)) {
             _grid.set_layout(context.shape, theme().baseline_adjustment());
@@ -63,7 +63,7 @@ public:
         }
 
         ++global_counter<"overlay_widget:set_widget:constrain">;
-        process_event({gui_event_type::window_reconstrain});
+        request_reconstrain();
     }
 
     /** Add a content widget directly to this overlay widget.
@@ -95,14 +95,14 @@ public:
         }
     }
 
-    [[nodiscard]] box_constraints update_constraints() noexcept override
+    [[nodiscard]] box_constraints do_update_constraints() noexcept override
     {
         _layout = {};
         _content_constraints = _content->update_constraints();
         return _content_constraints;
     }
 
-    void set_layout(widget_layout const& context) noexcept override
+    void do_set_layout(widget_layout const& context) noexcept override
     {
         _layout = context;
 
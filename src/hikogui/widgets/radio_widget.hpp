@@ -131,13 +131,13 @@ public:
     }
 
     /// @privatesection
-    [[nodiscard]] box_constraints update_constraints() noexcept override
+    [[nodiscard]] box_constraints do_update_constraints() noexcept override
     {
         _button_size = {theme().size(), theme().size()};
         return box_constraints{_button_size, _button_size, _button_size, *attributes.alignment, theme().margin()};
     }
 
-    void set_layout(widget_layout const& context) noexcept override
+    void do_set_layout(widget_layout const& context) noexcept override
     {
         if (compare_store(_layout, context)) {
             _button_rectangle = align(context.rectangle(), _button_size, os_settings::alignment(*attributes.alignment));
@@ -146,7 +146,7 @@ public:
 
             _pip_circle = align(_button_rectangle, circle{theme().size() * 0.5f - 3.0f}, alignment::middle_center());
         }
-        super::set_layout(context);
+        super::do_set_layout(context);
     }
 
     void draw(draw_context const& context) noexcept override
@@ -40,31 +40,31 @@ public:
 
         _content_width_cbt = content_width.subscribe([&](auto...) {
             ++global_counter<"scroll_aperture_widget:content_width:relayout">;
-            process_event({gui_event_type::window_relayout});
+            request_relayout();
         });
         _content_height_cbt = content_height.subscribe([&](auto...) {
             ++global_counter<"scroll_aperture_widget:content_height:relayout">;
-            process_event({gui_event_type::window_relayout});
+            request_relayout();
         });
         _aperture_width_cbt = aperture_width.subscribe([&](auto...) {
             ++global_counter<"scroll_aperture_widget:aperture_width:relayout">;
-            process_event({gui_event_type::window_relayout});
+            request_relayout();
         });
         _aperture_height_cbt = aperture_height.subscribe([&](auto...) {
             ++global_counter<"scroll_aperture_widget:aperture_height:relayout">;
-            process_event({gui_event_type::window_relayout});
+            request_relayout();
         });
         _offset_x_cbt = offset_x.subscribe([&](auto...) {
             ++global_counter<"scroll_aperture_widget:offset_x:relayout">;
-            process_event({gui_event_type::window_relayout});
+            request_relayout();
         });
         _offset_y_cbt = offset_y.subscribe([&](auto...) {
             ++global_counter<"scroll_aperture_widget:offset_y:relayout">;
-            process_event({gui_event_type::window_relayout});
+            request_relayout();
         });
         _minimum_cbt = minimum.subscribe([&](auto...) {
             ++global_counter<"scroll_aperture_widget:minimum:reconstrain">;
-            process_event({gui_event_type::window_reconstrain});
+            request_reconstrain();
         });
     }
 
@@ -109,7 +109,7 @@ public:
         }
     }
 
-    [[nodiscard]] box_constraints update_constraints() noexcept override
+    [[nodiscard]] box_constraints do_update_constraints() noexcept override
     {
         _layout = {};
         _content_constraints = _content->update_constraints();
@@ -126,7 +126,7 @@ public:
         return aperture_constraints;
     }
 
-    void set_layout(widget_layout const& context) noexcept override
+    void do_set_layout(widget_layout const& context) noexcept override
     {
         if (compare_store(_layout, context)) {
             aperture_width = context.width() - _content_constraints.margins.left() - _content_constraints.margins.right();
@@ -200,7 +200,7 @@ public:
             offset_x = std::clamp(new_offset_x, 0.0f, max_offset_x);
             offset_y = std::clamp(new_offset_y, 0.0f, max_offset_y);
             ++global_counter<"scroll_aperture_widget:mouse_wheel:relayout">;
-            process_event({gui_event_type::window_relayout});
+            request_relayout();
             return true;
         } else {
             return super::handle_event(event);
@@ -57,21 +57,21 @@ public:
     {
         _content_cbt = this->content.subscribe([&](auto...) {
             ++global_counter<"scroll_bar_widget:content:relayout">;
-            process_event({gui_event_type::window_relayout});
+            request_relayout();
         });
         _aperture_cbt = this->aperture.subscribe([&](auto...) {
             ++global_counter<"scroll_bar_widget:aperture:relayout">;
-            process_event({gui_event_type::window_relayout});
+            request_relayout();
         });
         _offset_cbt = this->offset.subscribe([&](auto...) {
             ++global_counter<"scroll_bar_widget:offset:relayout">;
-            process_event({gui_event_type::window_relayout});
+            request_relayout();
         });
     }
 
     ~scroll_bar_widget() {}
 
-    [[nodiscard]] box_constraints update_constraints() noexcept override
+    [[nodiscard]] box_constraints do_update_constraints() noexcept override
     {
         _layout = {};
 
@@ -93,7 +93,7 @@ public:
         }
     }
 
-    void set_layout(widget_layout const& context) noexcept override
+    void do_set_layout(widget_layout const& context) noexcept override
     {
         _layout = context;
 
@@ -121,7 +121,7 @@ public:
         co_yield *_horizontal_scroll_bar;
     }
 
-    [[nodiscard]] box_constraints update_constraints() noexcept override
+    [[nodiscard]] box_constraints do_update_constraints() noexcept override
     {
         _layout = {};
 
@@ -132,7 +132,7 @@ public:
         return grid_constraints.constrain(*minimum, *maximum);
     }
 
-    void set_layout(widget_layout const& context) noexcept override
+    void do_set_layout(widget_layout const& context) noexcept override
     {
         if (compare_store(_layout, context)) {
             _grid.set_layout(context.shape, theme().baseline_adjustment());
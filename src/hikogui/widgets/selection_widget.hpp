@@ -125,7 +125,7 @@ public:
 
         _off_label_cbt = this->attributes.off_label.subscribe([&](auto...) {
             ++global_counter<"selection_widget:off_label:constrain">;
-            process_event({gui_event_type::window_reconstrain});
+            request_reconstrain();
         });
 
         _delegate_options_cbt = this->delegate->subscribe_on_options([&] {
@@ -180,7 +180,7 @@ public:
         co_yield *_off_label_widget;
     }
 
-    [[nodiscard]] box_constraints update_constraints() noexcept override
+    [[nodiscard]] box_constraints do_update_constraints() noexcept override
     {
         hi_assert_not_null(_off_label_widget);
         hi_assert_not_null(_current_label_widget);
@@ -207,7 +207,7 @@ public:
         return r;
     }
 
-    void set_layout(widget_layout const& context) noexcept override
+    void do_set_layout(widget_layout const& context) noexcept override
     {
         if (compare_store(_layout, context)) {
             if (os_settings::left_to_right()) {
@@ -296,7 +296,7 @@ public:
                 close_overlay();
             }
             ++global_counter<"selection_widget:gui_activate:relayout">;
-            process_event({gui_event_type::window_relayout});
+            request_relayout();
             return true;
 
         case gui_event_type::gui_cancel:
@@ -448,7 +448,7 @@ private:
         }
 
         ++global_counter<"selection_widget:update_options:constrain">;
-        process_event({gui_event_type::window_reconstrain});
+        request_reconstrain();
     }
 
     void update_value() noexcept
@@ -54,7 +54,7 @@ public:
         co_yield *_icon_widget;
     }
 
-    [[nodiscard]] box_constraints update_constraints() noexcept override
+    [[nodiscard]] box_constraints do_update_constraints() noexcept override
     {
         hi_assert_not_null(_icon_widget);
 
@@ -65,7 +65,7 @@ public:
         return {size, size, size};
     }
 
-    void set_layout(widget_layout const& context) noexcept override
+    void do_set_layout(widget_layout const& context) noexcept override
     {
         if (compare_store(_layout, context)) {
             auto const icon_height =
@@ -62,7 +62,7 @@ public:
         hi_assert_not_null(this->delegate);
         _delegate_cbt = this->delegate->subscribe([&] {
             ++global_counter<"tab_widget:delegate:constrain">;
-            process_event({gui_event_type::window_reconstrain});
+            request_reconstrain();
         });
 
         this->delegate->init(*this);
@@ -90,7 +90,7 @@ public:
         _children.push_back(std::move(child));
 
         ++global_counter<"tab_widget:emplace:constrain">;
-        process_event({gui_event_type::window_reconstrain});
+        request_reconstrain();
     }
 
     /** Make and add a child widget.
@@ -120,7 +120,7 @@ public:
         }
     }
 
-    [[nodiscard]] box_constraints update_constraints() noexcept override
+    [[nodiscard]] box_constraints do_update_constraints() noexcept override
     {
         _layout = {};
 
@@ -128,7 +128,7 @@ public:
 
         if (_previous_selected_child != &selected_child_) {
             _previous_selected_child = &selected_child_;
-            hi_log_info("tab_widget::update_constraints() selected tab changed");
+            hi_log_info("tab_widget::do_update_constraints() selected tab changed");
             process_event({gui_event_type::window_resize});
         }
 
@@ -139,7 +139,7 @@ public:
         return selected_child_.update_constraints();
     }
 
-    void set_layout(widget_layout const& context) noexcept override
+    void do_set_layout(widget_layout const& context) noexcept override
     {
         _layout = context;
 
@@ -91,7 +91,7 @@ public:
         hi_assert_not_null(this->delegate);
         _delegate_cbt = this->delegate->subscribe([&] {
             ++global_counter<"text_field_widget:delegate:layout">;
-            process_event({gui_event_type::window_relayout});
+            request_relayout();
         });
         this->delegate->init(*this);
 
@@ -106,15 +106,15 @@ public:
 
         _continues_cbt = continues.subscribe([&](auto...) {
             ++global_counter<"text_field_widget:continues:constrain">;
-            process_event({gui_event_type::window_reconstrain});
+            request_reconstrain();
         });
         _text_cbt = _text.subscribe([&](auto...) {
             ++global_counter<"text_field_widget:text:constrain">;
-            process_event({gui_event_type::window_reconstrain});
+            request_reconstrain();
         });
         _error_label_cbt = _error_label.subscribe([&](auto const& new_value) {
             ++global_counter<"text_field_widget:error_label:constrain">;
-            process_event({gui_event_type::window_reconstrain});
+            request_reconstrain();
         });
     }
 
@@ -152,7 +152,7 @@ public:
         }
     }
 
-    [[nodiscard]] box_constraints update_constraints() noexcept override
+    [[nodiscard]] box_constraints do_update_constraints() noexcept override
     {
         hi_assert_not_null(delegate);
         hi_assert_not_null(_error_label_widget);
@@ -196,7 +196,7 @@ public:
 
         return {size, size, size, resolved_alignment, margins};
     }
-    void set_layout(widget_layout const& context) noexcept override
+    void do_set_layout(widget_layout const& context) noexcept override
     {
         if (compare_store(_layout, context)) {
             auto const scroll_size = extent2{
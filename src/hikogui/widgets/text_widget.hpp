@@ -95,25 +95,26 @@ public:
                 auto const old_constraints = _constraints_cache;
 
                 // Constrain and layout according to the old layout.
-                auto const new_constraints = update_constraints();
+                // The cached constraints in widget_intf are updated on the next frame if they have changed.
+                auto const new_constraints = do_update_constraints();
                 new_layout.shape.rectangle = aarectangle{
                     new_layout.shape.x(),
                     new_layout.shape.y(),
                     std::max(new_layout.shape.width(), new_constraints.minimum.width()),
                     std::max(new_layout.shape.height(), new_constraints.minimum.height())};
-                set_layout(new_layout);
+                do_set_layout(new_layout);
 
                 if (new_constraints != old_constraints) {
                     // The constraints have changed, properly constrain and layout on the next frame.
                     ++global_counter<"text_widget:delegate:constrain">;
                     request_scroll();
-                    process_event({gui_event_type::window_reconstrain});
+                    request_reconstrain();
                 }
             } else {
                 // The layout is incomplete, properly constrain and layout on the next frame.
                 ++global_counter<"text_widget:delegate:constrain">;
                 request_scroll();
-                process_event({gui_event_type::window_reconstrain});
+                request_reconstrain();
             }
         });
 
@@ -153,7 +154,7 @@ public:
     }
 
     /// @privatesection
-    [[nodiscard]] box_constraints update_constraints() noexcept override
+    [[nodiscard]] box_constraints do_update_constraints() noexcept override
     {
         _layout = {};
 
@@ -164,10 +165,17 @@ public:
         // Make sure that the current selection fits the new text.
         _selection.resize(_text_cache.size());
 
-        // Create a new text_shaper with the new text.
         auto alignment_ = os_settings::left_to_right() ? *alignment : mirror(*alignment);
 
-        _shaped_text = text_shaper{_text_cache, theme().text_style_set(), style.pixel_density(), alignment_, os_settings::left_to_right()};
+        if (mode() >= widget_mode::partial) {
+            // Update the text_shaper with the new text, only the edited paragraphs are reshaped.
+            _shaped_text.update(
+                _text_cache, theme().text_style_set(), style.pixel_density(), alignment_, os_settings::left_to_right());
+        } else {
+            // Static text is often identical between widgets and rebuilds.
+            _shaped_text = text_shaper_cache::global().get(
+                _text_cache, theme().text_style_set(), style.pixel_density(), alignment_, os_settings::left_to_right());
+        }
 
         auto const shaped_text_rectangle = ceil(_shaped_text.bounding_rectangle(std::numeric_limits<float>::infinity()));
         auto const shaped_text_size = shaped_text_rectangle.size();
@@ -192,7 +200,7 @@ public:
         }
     }
 
-    void set_layout(widget_layout const& context) noexcept override
+    void do_set_layout(widget_layout const& context) noexcept override
     {
         if (compare_store(_layout, context)) {
             hi_assert(context.shape.baseline);
@@ -674,7 +682,7 @@ public:
                 }
 
                 ++global_counter<"text_widget:mouse_down:relayout">;
-                process_event({gui_event_type::window_relayout});
+                request_relayout();
                 request_scroll();
                 return true;
             }
@@ -753,11 +761,6 @@ public:
 private:
     enum class add_type { append, insert, dead };
 
-    struct undo_type {
-        gstring text;
-        text_selection selection;
-    };
-
     enum class cursor_state_type { off, on, busy, none };
 
     gstring _text_cache;
@@ -804,7 +807,12 @@ private:
      */
     std::optional<grapheme> _has_dead_character = std::nullopt;
 
-    undo_stack<undo_type> _undo_stack = {1000};
+    /** The edit history.
+     *
+     * Only the edits are stored, so that the history of a large text does not
+     * hold a thousand copies of that text.
+     */
+    delta_undo_stack<gstring, text_selection> _undo_stack = {1000};
 
     callback<void()> _delegate_cbt;
     callback<void(cursor_state_type)> _cursor_state_cbt;
@@ -885,28 +893,27 @@ private:
         return gstring_view{_text_cache}.substr(first, last - first);
     }
 
-    void undo_push() noexcept
-    {
-        _undo_stack.emplace(_text_cache, _selection);
-    }
-
     void undo() noexcept
     {
         if (_undo_stack.can_undo()) {
-            auto const & [ text, selection ] = _undo_stack.undo(_text_cache, _selection);
-
-            delegate->write(*this, text);
-            _selection = selection;
+            auto text = _text_cache;
+            auto selection = _selection;
+            if (_undo_stack.undo(text, selection)) {
+                delegate->write(*this, text);
+                _selection = selection;
+            }
         }
     }
 
     void redo() noexcept
     {
         if (_undo_stack.can_redo()) {
-            auto const & [ text, selection ] = _undo_stack.redo();
-
-            delegate->write(*this, text);
-            _selection = selection;
+            auto text = _text_cache;
+            auto selection = _selection;
+            if (_undo_stack.redo(text, selection)) {
+                delegate->write(*this, text);
+                _selection = selection;
+            }
         }
     }
 
@@ -953,12 +960,15 @@ private:
     }
 
     /** This function replaces the current selection with replacement text.
+     *
+     * @param replacement The text to replace the selection with.
+     * @param coalesce Merge with the previous edit in the undo history when
+     *                 this directly follows it, used for typing.
      */
-    void replace_selection(gstring const& replacement) noexcept
+    void replace_selection(gstring const& replacement, bool coalesce = false) noexcept
     {
-        undo_push();
-
         auto const[first, last] = _selection.selection_indices();
+        _undo_stack.push(_text_cache, first, last - first, replacement, _selection, coalesce);
 
         auto text = _text_cache;
         text.replace(first, last - first, replacement);
@@ -984,7 +994,8 @@ private:
             auto const[first, last] = _shaped_text.select_char(start_selection);
             _selection.drag_selection(last);
         }
-        replace_selection(gstring{c});
+        // The dead character is coalesced, so that it can be replaced by the composed character.
+        replace_selection(gstring{c}, keyboard_mode == add_type::append or keyboard_mode == add_type::dead);
 
         if (keyboard_mode == add_type::insert) {
             // The character was inserted, put the cursor back where it was.
@@ -1002,15 +1013,17 @@ private:
             hi_assert(_selection.cursor().before());
             hi_assert_bounds(_selection.cursor().index(), _text_cache);
 
-            if (_has_dead_character != U'\uffff') {
-                auto text = _text_cache;
-                text[_selection.cursor().index()] = *_has_dead_character;
-                delegate->write(*this, text);
-            } else {
-                auto text = _text_cache;
-                text.erase(_selection.cursor().index(), 1);
-                delegate->write(*this, text);
-            }
+            auto const index = _selection.cursor().index();
+            auto const original = _has_dead_character != U'\uffff' ? gstring{*_has_dead_character} : gstring{};
+
+            // Coalesced with the dead character, which leaves the history as
+            // if the dead character was never typed; the composed character
+            // that follows is coalesced with the typing before it.
+            _undo_stack.push(_text_cache, index, 1, original, _selection, true);
+
+            auto text = _text_cache;
+            text.replace(index, 1, original);
+            delegate->write(*this, text);
         }
         _has_dead_character = std::nullopt;
     }
@@ -148,13 +148,13 @@ public:
     }
 
     /// @privatesection
-    [[nodiscard]] box_constraints update_constraints() noexcept override
+    [[nodiscard]] box_constraints do_update_constraints() noexcept override
     {
         _button_size = {theme().size() * 2.0f, theme().size()};
         return box_constraints{_button_size, _button_size, _button_size, *attributes.alignment, theme().margin()};
     }
 
-    void set_layout(widget_layout const& context) noexcept override
+    void do_set_layout(widget_layout const& context) noexcept override
     {
         if (compare_store(_layout, context)) {
             _button_rectangle = align(context.rectangle(), _button_size, os_settings::alignment(*attributes.alignment));
@@ -167,7 +167,7 @@ public:
             auto const pip_to_button_margin_x2 = _button_rectangle.height() - _pip_circle.diameter();
             _pip_move_range = _button_rectangle.width() - _pip_circle.diameter() - pip_to_button_margin_x2;
         }
-        super::set_layout(context);
+        super::do_set_layout(context);
     }
 
     void draw(draw_context const& context) noexcept override
@@ -238,7 +238,7 @@ public:
             if (mode() >= widget_mode::partial) {
                 delegate->activate(*this);
                 ++global_counter<"toggle_widget:handle_event:relayout">;
-                process_event({gui_event_type::window_relayout});
+                request_relayout();
                 return true;
             }
             break;
@@ -54,9 +54,9 @@ public:
     }
 
     /// @privatesection
-    [[nodiscard]] box_constraints update_constraints() noexcept override
+    [[nodiscard]] box_constraints do_update_constraints() noexcept override
     {
-        _label_constraints = super::update_constraints();
+        _label_constraints = super::do_update_constraints();
 
         // On left side a check mark, on right side short-cut. Around the label extra margin.
         auto const extra_size = extent2{theme().margin<float>() * 2.0f, theme().margin<float>() * 2.0f};
@@ -65,7 +65,7 @@ public:
         constraints.margins = 0;
         return constraints;
     }
-    void set_layout(widget_layout const& context) noexcept override
+    void do_set_layout(widget_layout const& context) noexcept override
     {
         if (compare_store(_layout, context)) {
             auto const label_rectangle =
@@ -73,7 +73,7 @@ public:
             _on_label_shape = _off_label_shape = _other_label_shape =
                 box_shape{_label_constraints, label_rectangle, theme().baseline_adjustment()};
         }
-        super::set_layout(context);
+        super::do_set_layout(context);
     }
     void draw(draw_context const& context) noexcept override
     {
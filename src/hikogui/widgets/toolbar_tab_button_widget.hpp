@@ -182,7 +182,7 @@ public:
     }
 
     /// @privatesection
-    [[nodiscard]] box_constraints update_constraints() noexcept override
+    [[nodiscard]] box_constraints do_update_constraints() noexcept override
     {
         _layout = {};
         _on_label_constraints = _on_label_widget->update_constraints();
@@ -195,7 +195,7 @@ public:
         return _label_constraints + extra_size;
     }
 
-    void set_layout(widget_layout const& context) noexcept override
+    void do_set_layout(widget_layout const& context) noexcept override
     {
         if (compare_store(_layout, context)) {
             auto const label_rectangle = aarectangle{
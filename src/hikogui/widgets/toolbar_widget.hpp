@@ -85,7 +85,7 @@ public:
         }
     }
 
-    [[nodiscard]] box_constraints update_constraints() noexcept override
+    [[nodiscard]] box_constraints do_update_constraints() noexcept override
     {
         _layout = {};
 
@@ -103,7 +103,7 @@ public:
 
         return r;
     }
-    void set_layout(widget_layout const& context) noexcept override
+    void do_set_layout(widget_layout const& context) noexcept override
     {
         // Clip directly around the toolbar, so that tab buttons looks proper.
         if (compare_store(_layout, context)) {
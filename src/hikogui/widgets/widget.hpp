@@ -29,8 +29,8 @@ hi_export namespace hi { inline namespace v1 {
 /** An interactive graphical object as part of the user-interface.
  *
  * Rendering is done in three distinct phases:
- *  1. Updating Constraints: `widget::update_constraints()`
- *  2. Updating Layout: `widget::set_layout()`
+ *  1. Updating Constraints: `widget::do_update_constraints()`
+ *  2. Updating Layout: `widget::do_set_layout()`
  *  3. Drawing: `widget::draw()`
  *
  * @ingroup widgets
@@ -107,13 +107,13 @@ public:
         return false;
     }
 
-    [[nodiscard]] box_constraints update_constraints() noexcept override
+    [[nodiscard]] box_constraints do_update_constraints() noexcept override
     {
         _layout = {};
         return {*minimum, *minimum, *maximum};
     }
 
-    void set_layout(widget_layout const& context) noexcept override
+    void do_set_layout(widget_layout const& context) noexcept override
     {
         _layout = context;
     }
@@ -33,7 +33,7 @@ public:
     window_controls_macos_widget() noexcept : super() {}
 
     /// @privatesection
-    [[nodiscard]] box_constraints update_constraints() noexcept override
+    [[nodiscard]] box_constraints do_update_constraints() noexcept override
     {
         _layout = {};
 
@@ -41,7 +41,7 @@ public:
         return {size, size, size};
     }
 
-    void set_layout(widget_layout const& context) noexcept override
+    void do_set_layout(widget_layout const& context) noexcept override
     {
         if (compare_store(_layout, context)) {
             auto extent = context.size();
@@ -100,7 +100,7 @@ public:
             co_yield *_content;
         }
     }
-    [[nodiscard]] box_constraints update_constraints() noexcept override
+    [[nodiscard]] box_constraints do_update_constraints() noexcept override
     {
         hi_assert_not_null(_content);
         hi_assert_not_null(_toolbar);
@@ -158,7 +158,7 @@ public:
         return r;
     }
 
-    void set_layout(widget_layout const& context) noexcept override
+    void do_set_layout(widget_layout const& context) noexcept override
     {
         if (compare_store(_layout, context)) {
             auto const toolbar_height = _toolbar_constraints.preferred.height();
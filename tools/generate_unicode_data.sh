@@ -24,6 +24,8 @@ $PYTHON3 tools/generate_unicode_data.py \
     --general-categories-output=src/hikogui/unicode/ucd_general_categories.hpp \
     --lexical-classes-template=tools/ucd/ucd_lexical_classes.hpp.psp \
     --lexical-classes-output=src/hikogui/unicode/ucd_lexical_classes.hpp \
+    --normalization-quick-checks-template=tools/ucd/ucd_normalization_quick_checks.hpp.psp \
+    --normalization-quick-checks-output=src/hikogui/unicode/ucd_normalization_quick_checks.hpp \
     --scripts-template=tools/ucd/ucd_scripts.hpp.psp \
     --scripts-output=src/hikogui/unicode/ucd_scripts.hpp \
     --east-asian-widths-template=tools/ucd/ucd_east_asian_widths.hpp.psp \
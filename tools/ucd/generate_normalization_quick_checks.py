@@ -0,0 +1,96 @@
+from .psp import psp_execute
+from .deduplicate import deduplicate
+from .bits_as_bytes import bits_as_bytes
+import sys
+
+# The values of the quick-check properties.
+QC_YES = 0
+QC_NO = 1
+QC_MAYBE = 2
+
+def generate_normalization_quick_checks(template_path, output_path, descriptions):
+    """
+    The NFC_QC, NFD_QC, NFKC_QC and NFKD_QC properties are derived from the
+    decompositions and composition exclusions, as described in
+    "UAX #15: Unicode Normalization Forms" and DerivedNormalizationProps.txt.
+    """
+    print("Processing normalization quick checks:", file=sys.stderr, flush=True)
+
+    def has_canonical_decomposition(d):
+        return d.decomposition_type is None and len(d.decomposition_mapping) != 0
+
+    def is_full_composition_exclusion(d):
+        if not has_canonical_decomposition(d):
+            return False
+        if d.composition_exclusion:
+            return True
+        # Singletons.
+        if len(d.decomposition_mapping) == 1:
+            return True
+        # Non-starter decompositions.
+        if d.canonical_combining_class != 0:
+            return True
+        return descriptions[d.decomposition_mapping[0]].canonical_combining_class != 0
+
+    # Code-points that may compose with a previous code-point.
+    composition_seconds = set()
+    for d in descriptions:
+        if has_canonical_decomposition(d) and len(d.decomposition_mapping) == 2 and not is_full_composition_exclusion(d):
+            composition_seconds.add(d.decomposition_mapping[1])
+
+    compatibility_cache = {}
+    def has_compatibility_decomposition(code_point):
+        """Check if the full decomposition of a code-point includes a compatibility decomposition."""
+        r = compatibility_cache.get(code_point)
+        if r is None:
+            d = descriptions[code_point]
+            if len(d.decomposition_mapping) == 0:
+                r = False
+            elif d.decomposition_type is not None:
+                r = True
+            else:
+                r = any(has_compatibility_decomposition(x) for x in d.decomposition_mapping)
+            compatibility_cache[code_point] = r
+        return r
+
+    quick_checks = []
+    for code_point, d in enumerate(descriptions):
+        if is_full_composition_exclusion(d):
+            NFC_QC = QC_NO
+        elif code_point in composition_seconds:
+            NFC_QC = QC_MAYBE
+        else:
+            NFC_QC = QC_YES
+
+        NFD_QC = QC_NO if has_canonical_decomposition(d) else QC_YES
+
+        if NFC_QC == QC_NO or has_compatibility_decomposition(code_point):
+            NFKC_QC = QC_NO
+        else:
+            NFKC_QC = NFC_QC
+
+        NFKD_QC = QC_NO if len(d.decomposition_mapping) != 0 else QC_YES
+
+        quick_checks.append((NFKD_QC << 5) | (NFKC_QC << 3) | (NFD_QC << 2) | NFC_QC)
+
+    quick_checks, indices, chunk_size = deduplicate(quick_checks)
+    quick_checks_bytes, quick_check_width = bits_as_bytes(quick_checks)
+    indices_bytes, index_width = bits_as_bytes(indices)
+
+    print("    chunk-size={} #indices={}:{} #quick_checks={}:{} total={} bytes".format(
+        chunk_size,
+        len(indices), index_width,
+        len(quick_checks), quick_check_width,
+        len(indices_bytes) + len(quick_checks_bytes)),
+        file=sys.stderr)
+
+    psp_execute(
+        template_path,
+        output_path,
+        chunk_size=chunk_size,
+        indices_size=len(indices),
+        index_width=index_width,
+        indices_bytes=indices_bytes,
+        quick_check_width=quick_check_width,
+        quick_checks_bytes=quick_checks_bytes
+    )